@@ -25,6 +25,7 @@
 #include "ags/shared/ac/sprite_cache.h"
 #include "ags/shared/gfx/allegro_bitmap.h"
 #include "ags/shared/script/cc_common.h"
+#include "ags/engine/script/script.h"
 #include "image/png.h"
 
 namespace AGS {
@@ -33,6 +34,7 @@ AGSConsole::AGSConsole(AGSEngine *vm) : GUI::Debugger(), _vm(vm), _logOutputTarg
 	registerCmd("ags_debug_groups_list",   WRAP_METHOD(AGSConsole, Cmd_listDebugGroups));
 	registerCmd("ags_debug_groups_set",  WRAP_METHOD(AGSConsole, Cmd_setDebugGroupLevel));
 	registerCmd("ags_set_script_dump", WRAP_METHOD(AGSConsole, Cmd_SetScriptDump));
+	registerCmd("ags_script_profile", WRAP_METHOD(AGSConsole, Cmd_ScriptProfile));
 	registerCmd("ags_sprite_info",   WRAP_METHOD(AGSConsole, Cmd_getSpriteInfo));
 	registerCmd("ags_sprite_dump",  WRAP_METHOD(AGSConsole, Cmd_dumpSprite));
 
@@ -184,6 +186,27 @@ bool AGSConsole::Cmd_SetScriptDump(int argc, const char **argv) {
 	return true;
 }
 
+bool AGSConsole::Cmd_ScriptProfile(int argc, const char **argv) {
+	if (argc > 3 || (argc >= 2 && strcmp(argv[1], "on") != 0 && strcmp(argv[1], "off") != 0 &&
+		strcmp(argv[1], "reset") != 0 && strcmp(argv[1], "show") != 0)) {
+		debugPrintf("Usage: %s [on|off|reset|show [count]]\n", argv[0]);
+		return true;
+	}
+
+	if (argc >= 2 && strcmp(argv[1], "on") == 0) {
+		AGS3::ccSetOption(SCOPT_PROFILERUN, 1);
+	} else if (argc >= 2 && strcmp(argv[1], "off") == 0) {
+		AGS3::ccSetOption(SCOPT_PROFILERUN, 0);
+	} else if (argc >= 2 && strcmp(argv[1], "reset") == 0) {
+		AGS3::cc_reset_script_profile();
+	} else {
+		int count = (argc == 3) ? atoi(argv[2]) : 20;
+		debugPrintf("Script profiling is %s\n", AGS3::ccGetOption(SCOPT_PROFILERUN) ? "on" : "off");
+		debugPrintf("%s", AGS3::cc_get_script_profile(count).GetCStr());
+	}
+	return true;
+}
+
 bool AGSConsole::Cmd_getSpriteInfo(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Usage: %s SpriteNumber\n", argv[0]);
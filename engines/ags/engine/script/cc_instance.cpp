@@ -20,6 +20,7 @@
  */
 
 #include "common/debug-channels.h"
+#include "ags/lib/std/algorithm.h"
 #include "ags/shared/ac/common.h"
 #include "ags/engine/ac/dynobj/cc_dynamic_array.h"
 #include "ags/engine/ac/dynobj/managed_object_pool.h"
@@ -161,6 +162,18 @@ struct ScriptCommands {
 };
 static ScriptCommands *g_commands;
 
+// Internal operation codes, produced by the byte-code decoder
+enum ScriptDecodedOpCode {
+	// Fused operations, each one replaces a frequent pair of instructions
+	kScOpLitToRegAddReg = CC_NUM_SCCMDS, // movl reg, lit; add reg2, reg
+	kScOpGlobalRead,                     // movl mar, global; memread4 reg
+	kScOpGlobalWrite,                    // movl mar, global; memwrite4 reg
+	kScOpStackRead,                      // load.sp.offs offs; memread4 reg
+	// Invalid code, the error is reported if it is ever executed
+	kScOpBadCode,
+	kScOpBadLength
+};
+
 void script_commands_init() {
 	g_commands = new ScriptCommands();
 }
@@ -185,6 +198,64 @@ String cc_get_callstack(int max_lines) {
 	return callstack;
 }
 
+struct ScriptProfileEntry {
+	String Name;
+	ScriptFunctionProfile Profile;
+};
+
+static bool CompareProfileEntries(const ScriptProfileEntry &e1, const ScriptProfileEntry &e2) {
+	return e1.Profile.Instructions > e2.Profile.Instructions;
+}
+
+String cc_get_script_profile(int max_lines) {
+	std::vector<ScriptProfileEntry> entries;
+	std::vector<const ScriptDecodedCode *> visited;
+	for (int i = 0; i < MAX_LOADED_INSTANCES; ++i) {
+		const ccInstance *inst = _G(loadedInstances)[i];
+		if (!inst || !inst->GetDecodedCode() || !inst->instanceof)
+			continue;
+		// forks share their code and statistics with the parent instance
+		const ScriptDecodedCode *decoded = inst->GetDecodedCode();
+		if (std::find(visited.begin(), visited.end(), decoded) != visited.end())
+			continue;
+		visited.push_back(decoded);
+
+		const ccScript *scri = inst->instanceof.get();
+		for (const auto &func : decoded->Profile) {
+			if (func._value.Calls == 0)
+				continue;
+			ScriptProfileEntry entry;
+			for (int k = 0; k < scri->numexports; ++k) {
+				if (((scri->export_addr[k] >> 24L) & 0x000ff) == EXPORT_FUNCTION &&
+					(scri->export_addr[k] & 0x00ffffff) == func._key) {
+					entry.Name = scri->exports[k];
+					break;
+				}
+			}
+			if (entry.Name.IsEmpty())
+				entry.Name = String::FromFormat("%s @%d", scri->GetSectionName(func._key), func._key);
+			entry.Profile = func._value;
+			entries.push_back(entry);
+		}
+	}
+
+	std::sort(entries.begin(), entries.end(), CompareProfileEntries);
+	String report;
+	for (size_t i = 0; i < entries.size() && (int)i < max_lines; ++i) {
+		const ScriptFunctionProfile &prof = entries[i].Profile;
+		report.AppendFmt("%8u calls %12llu ops %8u ms  %s\n", prof.Calls,
+			(unsigned long long)prof.Instructions, prof.TimeMs, entries[i].Name.GetCStr());
+	}
+	return report;
+}
+
+void cc_reset_script_profile() {
+	for (int i = 0; i < MAX_LOADED_INSTANCES; ++i) {
+		if (_G(loadedInstances)[i])
+			_G(loadedInstances)[i]->ResetProfile();
+	}
+}
+
 // Function call stack is used to temporarily store
 // values before passing them to script function
 #define MAX_FUNC_PARAMS 20
@@ -450,6 +521,20 @@ int ccInstance::Run(int32_t curpc) {
 	bool write_debug_dump = ccGetOption(SCOPT_DEBUGRUN) ||
 		(gDebugLevel > 0 && DebugMan.isDebugChannelEnabled(::AGS::kDebugScript));
 	ScriptOperation codeOp;
+	if (!codeInst->decoded_code)
+		codeInst->DecodeCode();
+	// hold a reference to the decoded code for the duration of the run
+	std::shared_ptr<ScriptDecodedCode> decoded = codeInst->decoded_code;
+	ScriptDecodedOp undecodedOp;
+	// execution statistics, gathered per function nesting level
+	const bool profile_run = ccGetOption(SCOPT_PROFILERUN) != 0;
+	ScriptFunctionProfile *func_profile[MAXNEST];
+	AGS_Clock::time_point func_start_ts[MAXNEST];
+	if (profile_run) {
+		func_profile[0] = &decoded->Profile[curpc];
+		func_profile[0]->Calls++;
+		func_start_ts[0] = AGS_Clock::now();
+	}
 	FunctionCallStack func_callstack;
 	int loopIterationCheckDisabled = 0;
 	unsigned loopIterations = 0u;      // any loop iterations (needed for timeout test)
@@ -464,92 +549,58 @@ int ccInstance::Run(int32_t curpc) {
 		if (_G(abort_engine))
 			return -1;
 
-		/*
-		if (!codeInst->ReadOperation(codeOp, pc))
-		{
-		    return -1;
-		}
-		*/
-		/* ReadOperation */
-		//=====================================================================
-		codeOp.Instruction.Code         = codeInst->code[pc];
-		codeOp.Instruction.InstanceId   = (codeOp.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
-		codeOp.Instruction.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
-
-		if (codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS) {
-			cc_error("invalid instruction %d found in code stream", codeOp.Instruction.Code);
+		if (pc < 0 || pc >= codeInst->codesize) {
+			cc_error("unexpected end of code data (%d; %d)", pc, codeInst->codesize);
 			return -1;
 		}
 
-		codeOp.ArgCount = (*g_commands)[codeOp.Instruction.Code].ArgCount;
-		if (pc + codeOp.ArgCount >= codeInst->codesize) {
-			cc_error("unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
+		// Operations are normally taken from the predecoded stream; a position
+		// not reached by the decoder (which should not happen in valid code)
+		// is decoded on the spot.
+		const ScriptDecodedOp *op;
+		const int32_t op_index = decoded->OpIndex[pc];
+		if (op_index >= 0) {
+			op = &decoded->Ops[op_index];
+			// Fused operations are not used when dumping instructions, to keep the log intact
+			if (op->Fused >= 0 && !write_debug_dump)
+				op = &decoded->Ops[op->Fused];
+		} else {
+			codeInst->DecodeOperation(pc, undecodedOp);
+			op = &undecodedOp;
+		}
+
+		if (op->Code == kScOpBadCode) {
+			cc_error("invalid instruction %d found in code stream", (int32_t)op->Args[0]);
+			return -1;
+		} else if (op->Code == kScOpBadLength) {
+			cc_error("unexpected end of code data (%d; %d)", (int32_t)op->Args[0], codeInst->codesize);
 			return -1;
 		}
 
-		int pc_at = pc + 1;
-		for (int i = 0; i < codeOp.ArgCount; ++i, ++pc_at) {
-			char fixup = codeInst->code_fixups[pc_at];
-			if (fixup > 0) {
-				// could be relative pointer or import address
-				/*
-				if (!FixupArgument(code[pc], fixup, codeOp.Args[i]))
-				{
-				    return -1;
-				}
-				*/
-				/* FixupArgument */
-				//=====================================================================
-				switch (fixup) {
-				case FIXUP_GLOBALDATA: {
-					ScriptVariable *gl_var = (ScriptVariable *)codeInst->code[pc_at];
-					codeOp.Args[i].SetGlobalVar(&gl_var->RValue);
-				}
-				break;
-				case FIXUP_FUNCTION:
-					// originally commented -- CHECKME: could this be used in very old versions of AGS?
-					//      code[fixup] += (long)&code[0];
-					// This is a program counter value, presumably will be used as SCMD_CALL argument
-					codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
-					break;
-				case FIXUP_STRING:
-					codeOp.Args[i].SetStringLiteral(&codeInst->strings[0] + codeInst->code[pc_at]);
-					break;
-				case FIXUP_IMPORT: {
-					const ScriptImport *import = _GP(simp).getByIndex(static_cast<uint32_t>(codeInst->code[pc_at]));
-					if (import) {
-						codeOp.Args[i] = import->Value;
-					} else {
-						cc_error("cannot resolve import, key = %ld", codeInst->code[pc_at]);
-						return -1;
-					}
-				}
-				break;
-				case FIXUP_STACK:
-					codeOp.Args[i] = GetStackPtrOffsetFw((int32_t)codeInst->code[pc_at]);
-					break;
-				default:
-					cc_error("internal fixup type error: %d", fixup);
+		if (profile_run)
+			func_profile[curnest]->Instructions += (op->Code >= CC_NUM_SCCMDS) ? 2 : 1;
+
+		// save the arguments for quick access
+		int32_t arg1 = (int32_t)op->Args[0];
+		int32_t arg2 = (int32_t)op->Args[1];
+		int32_t arg3 = (int32_t)op->Args[2];
+		if (op->NeedsValues || write_debug_dump) {
+			// some of the arguments are not plain numeric values
+			codeOp.Instruction.Code = op->Code;
+			codeOp.Instruction.InstanceId = op->InstanceId;
+			codeOp.ArgCount = op->ArgCount;
+			for (int i = 0; i < op->ArgCount; ++i) {
+				if (!ResolveArgument(*op, i, codeOp.Args[i]))
 					return -1;
-				}
-				/* End FixupArgument */
-				//=====================================================================
-			} else {
-				// should be a numeric literal (int32 or float)
-				codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
 			}
+			arg1 = codeOp.Args[0].IValue;
+			arg2 = codeOp.Args[1].IValue;
+			arg3 = codeOp.Args[2].IValue;
 		}
-		/* End ReadOperation */
-		//=====================================================================
-
-		// save the arguments for quick access
-		RuntimeScriptValue &arg1 = codeOp.Args[0];
-		RuntimeScriptValue &arg2 = codeOp.Args[1];
-		RuntimeScriptValue &arg3 = codeOp.Args[2];
 		RuntimeScriptValue &reg1 =
-		    registers[arg1.IValue >= 0 && arg1.IValue < CC_NUM_REGISTERS ? arg1.IValue : 0];
+		    registers[arg1 >= 0 && arg1 < CC_NUM_REGISTERS ? arg1 : 0];
 		RuntimeScriptValue &reg2 =
-		    registers[arg2.IValue >= 0 && arg2.IValue < CC_NUM_REGISTERS ? arg2.IValue : 0];
+		    registers[arg2 >= 0 && arg2 < CC_NUM_REGISTERS ? arg2 : 0];
 
 		const char *direct_ptr1;
 		const char *direct_ptr2;
@@ -558,16 +609,16 @@ int ccInstance::Run(int32_t curpc) {
 			DumpInstruction(codeOp);
 		}
 
-		switch (codeOp.Instruction.Code) {
+		switch (op->Code) {
 		case SCMD_LINENUM:
-			line_number = arg1.IValue;
-			_G(currentline) = arg1.IValue;
+			line_number = arg1;
+			_G(currentline) = arg1;
 			if (_G(new_line_hook))
 				_G(new_line_hook)(this, _G(currentline));
 			break;
 		case SCMD_ADD:
 			// If the register is SREG_SP, we are allocating new variable on the stack
-			if (arg1.IValue == SREG_SP) {
+			if (arg1 == SREG_SP) {
 				// Only allocate new data if current stack entry is invalid;
 				// in some cases this may be advancing over value that was written by MEMWRITE*
 				ASSERT_STACK_SPACE_AVAILABLE(1);
@@ -575,13 +626,13 @@ int ccInstance::Run(int32_t curpc) {
 					// TODO: perhaps should add a flag here to ensure this happens only after MEMWRITE-ing to stack
 					registers[SREG_SP].RValue++;
 				} else {
-					PushDataToStack(arg2.IValue);
+					PushDataToStack(arg2);
 					if (cc_has_error()) {
 						return -1;
 					}
 				}
 			} else {
-				reg1.IValue += arg2.IValue;
+				reg1.IValue += arg2;
 			}
 			break;
 		case SCMD_SUB:
@@ -591,17 +642,17 @@ int ccInstance::Run(int32_t curpc) {
 				// quote JJS:
 				// // AGS 2.x games also perform relative stack access by copying SREG_SP to SREG_MAR
 				// // and then subtracting from that.
-				if (arg1.IValue == SREG_SP) {
-					PopDataFromStack(arg2.IValue);
+				if (arg1 == SREG_SP) {
+					PopDataFromStack(arg2);
 				} else {
 					// This is practically LOADSPOFFS
-					reg1 = GetStackPtrOffsetRw(arg2.IValue);
+					reg1 = GetStackPtrOffsetRw(arg2);
 				}
 				if (cc_has_error()) {
 					return -1;
 				}
 			} else {
-				reg1.IValue -= arg2.IValue;
+				reg1.IValue -= arg2;
 			}
 			break;
 		case SCMD_REGTOREG:
@@ -614,19 +665,19 @@ int ccInstance::Run(int32_t curpc) {
 			// long, or rather int32 due x32 build), written value may normally
 			// be only up to 4 bytes large;
 			// I guess that's an obsolete way to do WRITE, WRITEW and WRITEB
-			switch (arg1.IValue) {
+			switch (arg1) {
 			case sizeof(char):
-				registers[SREG_MAR].WriteByte(arg2.IValue);
+				registers[SREG_MAR].WriteByte(arg2);
 				break;
 			case sizeof(int16_t):
-				registers[SREG_MAR].WriteInt16(arg2.IValue);
+				registers[SREG_MAR].WriteInt16(arg2);
 				break;
 			case sizeof(int32_t):
 				// We do not know if this is math integer or some pointer, etc
-				registers[SREG_MAR].WriteValue(arg2);
+				registers[SREG_MAR].WriteValue(op->NeedsValues ? codeOp.Args[1] : RuntimeScriptValue().SetInt32(arg2));
 				break;
 			default:
-				warning("unexpected data size for WRITELIT op: %d", arg1.IValue);
+				warning("unexpected data size for WRITELIT op: %d", arg1);
 				break;
 			}
 			break;
@@ -636,6 +687,8 @@ int ccInstance::Run(int32_t curpc) {
 
 			ASSERT_STACK_SIZE(1);
 			RuntimeScriptValue rval = PopValueFromStack();
+			if (profile_run)
+				func_profile[curnest]->TimeMs += AGS_Clock::now() - func_start_ts[curnest];
 			curnest--;
 			pc = rval.IValue;
 			if (pc == 0) {
@@ -646,7 +699,10 @@ int ccInstance::Run(int32_t curpc) {
 			continue; // continue so that the PC doesn't get overwritten
 		}
 		case SCMD_LITTOREG:
-			reg1 = arg2;
+			if (op->NeedsValues)
+				reg1 = codeOp.Args[1];
+			else
+				reg1.SetInt32(arg2);
 			break;
 		case SCMD_MEMREAD:
 			// Take the data address from reg[MAR] and copy int32_t to reg[arg1]
@@ -657,7 +713,7 @@ int ccInstance::Run(int32_t curpc) {
 			registers[SREG_MAR].WriteValue(reg1);
 			break;
 		case SCMD_LOADSPOFFS:
-			registers[SREG_MAR] = GetStackPtrOffsetRw(arg1.IValue);
+			registers[SREG_MAR] = GetStackPtrOffsetRw(arg1);
 			if (cc_has_error()) {
 				return -1;
 			}
@@ -736,7 +792,7 @@ int ccInstance::Run(int32_t curpc) {
 			PUSH_CALL_STACK;
 
 			ASSERT_STACK_SPACE_AVAILABLE(1);
-			PushValueToStack(RuntimeScriptValue().SetInt32(pc + codeOp.ArgCount + 1));
+			PushValueToStack(RuntimeScriptValue().SetInt32(pc + op->Length));
 
 			if (thisbase[curnest] == 0)
 				pc = reg1.IValue;
@@ -753,6 +809,11 @@ int ccInstance::Run(int32_t curpc) {
 			curnest++;
 			thisbase[curnest] = 0;
 			funcstart[curnest] = pc;
+			if (profile_run) {
+				func_profile[curnest] = &decoded->Profile[pc];
+				func_profile[curnest]->Calls++;
+				func_start_ts[curnest] = AGS_Clock::now();
+			}
 			continue; // continue so that the PC doesn't get overwritten
 		case SCMD_MEMREADB:
 			// Take the data address from reg[MAR] and copy byte to reg[arg1]
@@ -772,11 +833,11 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		case SCMD_JZ:
 			if (registers[SREG_AX].IsNull())
-				pc += arg1.IValue;
+				pc += arg1;
 			break;
 		case SCMD_JNZ:
 			if (!registers[SREG_AX].IsNull())
-				pc += arg1.IValue;
+				pc += arg1;
 			break;
 		case SCMD_PUSHREG:
 			// Push reg[arg1] value to the stack
@@ -788,10 +849,10 @@ int ccInstance::Run(int32_t curpc) {
 			reg1 = PopValueFromStack();
 			break;
 		case SCMD_JMP:
-			pc += arg1.IValue;
+			pc += arg1;
 
 			// Make sure it's not stuck in a While loop
-			if (arg1.IValue < 0) {
+			if (arg1 < 0) {
 				++loopIterations;
 				if (flags & INSTF_RUNNING) {
 					// was notified still running, don't do anything
@@ -811,12 +872,12 @@ int ccInstance::Run(int32_t curpc) {
 			}
 			break;
 		case SCMD_MUL:
-			reg1.IValue *= arg2.IValue;
+			reg1.IValue *= arg2;
 			break;
 		case SCMD_CHECKBOUNDS:
 			if ((reg1.IValue < 0) ||
-			        (reg1.IValue >= arg2.IValue)) {
-				cc_error("!Array index out of bounds (index: %d, bounds: 0..%d)", reg1.IValue, arg2.IValue - 1);
+			        (reg1.IValue >= arg2)) {
+				cc_error("!Array index out of bounds (index: %d, bounds: 0..%d)", reg1.IValue, arg2 - 1);
 				return -1;
 			}
 			break;
@@ -949,7 +1010,7 @@ int ccInstance::Run(int32_t curpc) {
 			}
 			break;
 		case SCMD_NUMFUNCARGS:
-			num_args_to_func = arg1.IValue;
+			num_args_to_func = arg1;
 			break;
 		case SCMD_CALLAS: {
 			PUSH_CALL_STACK;
@@ -979,7 +1040,7 @@ int ccInstance::Run(int32_t curpc) {
 			ccInstance *wasRunning = runningInst;
 
 			// extract the instance ID
-			int32_t instId = codeOp.Instruction.InstanceId;
+			int32_t instId = op->InstanceId;
 			// determine the offset into the code of the instance we want
 			runningInst = _G(loadedInstances)[instId];
 			intptr_t callAddr = reg1.Ptr - (char *)&runningInst->code[0];
@@ -1079,10 +1140,10 @@ int ccInstance::Run(int32_t curpc) {
 			PushToFuncCallStack(func_callstack, reg1);
 			break;
 		case SCMD_SUBREALSTACK:
-			PopFromFuncCallStack(func_callstack, arg1.IValue);
+			PopFromFuncCallStack(func_callstack, arg1);
 			if (was_just_callas >= 0) {
-				ASSERT_STACK_SIZE(arg1.IValue);
-				PopValuesFromStack(arg1.IValue);
+				ASSERT_STACK_SIZE(arg1);
+				PopValuesFromStack(arg1);
 				was_just_callas = -1;
 			}
 			break;
@@ -1126,7 +1187,7 @@ int ccInstance::Run(int32_t curpc) {
 			reg1.SetInt32(reg1.IValue >> reg2.IValue);
 			break;
 		case SCMD_THISBASE:
-			thisbase[curnest] = arg1.IValue;
+			thisbase[curnest] = arg1;
 			break;
 		case SCMD_NEWARRAY: {
 			int numElements = reg1.IValue;
@@ -1134,12 +1195,13 @@ int ccInstance::Run(int32_t curpc) {
 				cc_error("invalid size for dynamic array; requested: %d, range: 1..%d", numElements, INT32_MAX);
 				return -1;
 			}
-			DynObjectRef ref = _GP(globalDynamicArray).Create(numElements, arg2.IValue, arg3.GetAsBool());
+			DynObjectRef ref = _GP(globalDynamicArray).Create(numElements, arg2,
+				op->NeedsValues ? codeOp.Args[2].GetAsBool() : arg3 != 0);
 			reg1.SetDynamicObject(ref.second, &_GP(globalDynamicArray));
 			break;
 		}
 		case SCMD_NEWUSEROBJECT: {
-			const int32_t size = arg2.IValue;
+			const int32_t size = arg2;
 			if (size < 0) {
 				cc_error("Invalid size for user object; requested: %d (or %d), range: 0..%d", (uint32_t)size, size, INT_MAX);
 				return -1;
@@ -1149,10 +1211,10 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_FADD:
-			reg1.SetFloat(reg1.FValue + arg2.IValue); // arg2 was used as int here originally
+			reg1.SetFloat(reg1.FValue + arg2); // arg2 was used as int here originally
 			break;
 		case SCMD_FSUB:
-			reg1.SetFloat(reg1.FValue - arg2.IValue); // arg2 was used as int here originally
+			reg1.SetFloat(reg1.FValue - arg2); // arg2 was used as int here originally
 			break;
 		case SCMD_FMULREG:
 			reg1.SetFloat(reg1.FValue * reg2.FValue);
@@ -1189,15 +1251,15 @@ int ccInstance::Run(int32_t curpc) {
 				int currentStackSize = registers[SREG_SP].RValue - &stack[0];
 				int currentDataSize = stackdata_ptr - stackdata;
 				if (currentStackSize + 1 >= CC_STACK_SIZE ||
-				        currentDataSize + arg1.IValue >= (int32_t)CC_STACK_DATA_SIZE) {
-					cc_error("stack overflow, attempted grow to %d bytes", currentDataSize + arg1.IValue);
+				        currentDataSize + arg1 >= (int32_t)CC_STACK_DATA_SIZE) {
+					cc_error("stack overflow, attempted grow to %d bytes", currentDataSize + arg1);
 					return -1;
 				}
 				// NOTE: according to compiler's logic, this is always followed
 				// by SCMD_ADD, and that is where the data is "allocated", here we
 				// just clean the place.
 				// CHECKME -- since we zero memory in PushDataToStack anyway, this is not needed at all?
-				memset(stackdata_ptr, 0, arg1.IValue);
+				memset(stackdata_ptr, 0, arg1);
 			} else {
 				cc_error("internal error: stack tail address expected on SCMD_ZEROMEMORY instruction, reg[MAR] type is %d",
 				         registers[SREG_MAR].Type);
@@ -1237,12 +1299,31 @@ int ccInstance::Run(int32_t curpc) {
 			if (loopIterationCheckDisabled == 0)
 				loopIterationCheckDisabled++;
 			break;
+		case kScOpLitToRegAddReg:
+			reg1.SetInt32(arg2);
+			registers[arg3].IValue += reg1.IValue;
+			break;
+		case kScOpGlobalRead:
+			reg1.SetGlobalVar(&((ScriptVariable *)op->Args[1])->RValue);
+			registers[arg3] = reg1.ReadValue();
+			break;
+		case kScOpGlobalWrite:
+			reg1.SetGlobalVar(&((ScriptVariable *)op->Args[1])->RValue);
+			reg1.WriteValue(registers[arg3]);
+			break;
+		case kScOpStackRead:
+			registers[SREG_MAR] = GetStackPtrOffsetRw(arg1);
+			if (cc_has_error()) {
+				return -1;
+			}
+			registers[arg3] = registers[SREG_MAR].ReadValue();
+			break;
 		default:
-			cc_error("instruction %d is not implemented", codeOp.Instruction.Code);
+			cc_error("instruction %d is not implemented", op->Code);
 			return -1;
 		}
 
-		pc += codeOp.ArgCount + 1;
+		pc += op->Length;
 	}
 	return 0;
 }
@@ -1431,6 +1512,7 @@ bool ccInstance::_Create(PScript scri, ccInstance *joined) {
 	if (joined) {
 		resolved_imports = joined->resolved_imports;
 		code_fixups = joined->code_fixups;
+		decoded_code = joined->decoded_code;
 	} else {
 		if (!CreateGlobalVars(scri.get())) {
 			return false;
@@ -1516,6 +1598,7 @@ void ccInstance::Free() {
 	}
 	resolved_imports = nullptr;
 	code_fixups = nullptr;
+	decoded_code.reset();
 }
 
 bool ccInstance::ResolveScriptImports(const ccScript *scri) {
@@ -1726,9 +1809,168 @@ bool ccInstance::ResolveImportFixups(const ccScript *scri) {
 		if (import->InstancePtr != nullptr && (code[fixup + 1] & INSTANCE_ID_REMOVEMASK) == SCMD_CALLEXT)
 			code[fixup + 1] = SCMD_CALLAS | (import->InstancePtr->loadedInstanceId << INSTANCE_ID_SHIFT);
 	}
+	// All the code changes are done now
+	DecodeCode();
+	return true;
+}
+
+void ccInstance::DecodeCode() {
+	decoded_code.reset(new ScriptDecodedCode());
+	ScriptDecodedCode &decoded = *decoded_code;
+	decoded.OpIndex.resize(codesize, -1);
+	decoded.Ops.reserve(codesize / 2);
+	for (int32_t at_pc = 0; at_pc < codesize;) {
+		ScriptDecodedOp op;
+		DecodeOperation(at_pc, op);
+		decoded.OpIndex[at_pc] = decoded.Ops.size();
+		decoded.Ops.push_back(op);
+		at_pc += op.Length;
+	}
+	FuseOperations();
+}
+
+void ccInstance::DecodeOperation(int32_t at_pc, ScriptDecodedOp &op) const {
+	op = ScriptDecodedOp();
+	op.Code         = code[at_pc];
+	op.InstanceId   = (op.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
+	op.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
+
+	if (op.Code < 0 || op.Code >= CC_NUM_SCCMDS) {
+		op.Args[0] = op.Code;
+		op.Code = kScOpBadCode;
+		return;
+	}
+
+	const int arg_count = (*g_commands)[op.Code].ArgCount;
+	if (at_pc + arg_count >= codesize) {
+		op.Args[0] = at_pc + arg_count;
+		op.Code = kScOpBadLength;
+		return;
+	}
+
+	op.ArgCount = arg_count;
+	op.Length = arg_count + 1;
+	for (int i = 0; i < arg_count; ++i) {
+		const int32_t pc_at = at_pc + 1 + i;
+		op.Fixups[i] = code_fixups[pc_at];
+		op.Args[i] = code[pc_at];
+		switch (op.Fixups[i]) {
+		case 0:
+		case FIXUP_FUNCTION:
+			// numeric literal or a program counter value
+			break;
+		case FIXUP_STRING:
+			op.Args[i] = (intptr_t)(&strings[0] + code[pc_at]);
+			op.NeedsValues = true;
+			break;
+		default:
+			// global data is already resolved in the code, imports and
+			// stack pointers depend on the execution state
+			op.NeedsValues = true;
+			break;
+		}
+	}
+}
+
+static inline bool IsValidRegister(intptr_t reg) {
+	return reg >= 0 && reg < CC_NUM_REGISTERS;
+}
+
+static inline bool HasNoFixups(const ScriptDecodedOp &op) {
+	for (int i = 0; i < op.ArgCount; ++i) {
+		if (op.Fixups[i] != 0)
+			return false;
+	}
 	return true;
 }
 
+void ccInstance::FuseOperations() {
+	ScriptDecodedCode &decoded = *decoded_code;
+	const size_t num_ops = decoded.Ops.size();
+	for (size_t i = 0; i + 1 < num_ops; ++i) {
+		const ScriptDecodedOp &first = decoded.Ops[i];
+		const ScriptDecodedOp &second = decoded.Ops[i + 1];
+		// the second operation has to be a plain one, with a register argument
+		if (second.Code >= CC_NUM_SCCMDS || !HasNoFixups(second) || !IsValidRegister(second.Args[0]))
+			continue;
+
+		int32_t fused_code = -1;
+		if (first.Code == SCMD_LITTOREG && IsValidRegister(first.Args[0]) && first.Fixups[0] == 0) {
+			if (first.Fixups[1] == 0 && second.Code == SCMD_ADDREG && second.Args[1] == first.Args[0])
+				fused_code = kScOpLitToRegAddReg;
+			else if (first.Fixups[1] == FIXUP_GLOBALDATA && first.Args[0] == SREG_MAR && second.Code == SCMD_MEMREAD)
+				fused_code = kScOpGlobalRead;
+			else if (first.Fixups[1] == FIXUP_GLOBALDATA && first.Args[0] == SREG_MAR && second.Code == SCMD_MEMWRITE)
+				fused_code = kScOpGlobalWrite;
+		} else if (first.Code == SCMD_LOADSPOFFS && HasNoFixups(first) && second.Code == SCMD_MEMREAD) {
+			fused_code = kScOpStackRead;
+		}
+		if (fused_code < 0)
+			continue;
+
+		// The original operations are kept: the second one may still be
+		// a jump target, and the first one is used for dumping instructions
+		ScriptDecodedOp fused = first;
+		fused.Code = fused_code;
+		fused.Length = first.Length + second.Length;
+		fused.NeedsValues = false;
+		fused.Args[2] = second.Args[0];
+		decoded.Ops[i].Fused = decoded.Ops.size();
+		decoded.Ops.push_back(fused);
+	}
+}
+
+bool ccInstance::ResolveArgument(const ScriptDecodedOp &op, int arg_idx, RuntimeScriptValue &argument) {
+	const intptr_t code_value = op.Args[arg_idx];
+	const char fixup = op.Fixups[arg_idx];
+	if (fixup <= 0) {
+		// should be a numeric literal (int32 or float)
+		argument.SetInt32((int32_t)code_value);
+		return true;
+	}
+
+	switch (fixup) {
+	case FIXUP_GLOBALDATA: {
+		ScriptVariable *gl_var = (ScriptVariable *)code_value;
+		argument.SetGlobalVar(&gl_var->RValue);
+	}
+	break;
+	case FIXUP_FUNCTION:
+		// This is a program counter value, presumably will be used as SCMD_CALL argument
+		argument.SetInt32((int32_t)code_value);
+		break;
+	case FIXUP_STRING:
+		// the string address was resolved by the decoder
+		argument.SetStringLiteral((const char *)code_value);
+		break;
+	case FIXUP_IMPORT: {
+		const ScriptImport *import = _GP(simp).getByIndex(static_cast<uint32_t>(code_value));
+		if (import) {
+			argument = import->Value;
+		} else {
+			cc_error("cannot resolve import, key = %ld", code_value);
+			return false;
+		}
+	}
+	break;
+	case FIXUP_STACK:
+		argument = GetStackPtrOffsetFw((int32_t)code_value);
+		break;
+	default:
+		cc_error("internal fixup type error: %d", fixup);
+		return false;
+	}
+	return true;
+}
+
+void ccInstance::ResetProfile() {
+	if (!decoded_code)
+		return;
+	// The entries may be referenced by a running script, so only clear them
+	for (auto &entry : decoded_code->Profile)
+		entry._value = ScriptFunctionProfile();
+}
+
 /*
 bool ccInstance::ReadOperation(ScriptOperation &op, int32_t at_pc)
 {
@@ -24,6 +24,7 @@
 
 #include "ags/lib/std/memory.h"
 #include "ags/lib/std/map.h"
+#include "ags/lib/std/vector.h"
 #include "ags/engine/ac/timer.h"
 #include "ags/shared/script/cc_internal.h"
 #include "ags/shared/script/cc_script.h"  // ccScript
@@ -69,6 +70,54 @@ struct ScriptOperation {
 	int                 ArgCount;
 };
 
+// Operation predecoded from the byte-code; the arguments are kept in their
+// raw form, and only those with fixups that depend on the run-time state
+// (imports and stack offsets) have to be resolved again on each execution.
+struct ScriptDecodedOp {
+	ScriptDecodedOp() {
+		Code = 0;
+		InstanceId = 0;
+		ArgCount = 0;
+		Length = 1;
+		Fused = -1;
+		NeedsValues = false;
+		for (int i = 0; i < MAX_SCMD_ARGS; ++i) {
+			Fixups[i] = 0;
+			Args[i] = 0;
+		}
+	}
+
+	int32_t             Code;       // instruction code, or one of the fused codes
+	int32_t             InstanceId;
+	int32_t             ArgCount;   // number of arguments of the original instruction
+	int32_t             Length;     // number of code words to skip after execution
+	int32_t             Fused;      // index of the fused operation starting here, or -1
+	bool                NeedsValues;// arguments have to be converted to RuntimeScriptValue
+	char                Fixups[MAX_SCMD_ARGS];
+	intptr_t            Args[MAX_SCMD_ARGS];
+};
+
+// Execution statistics of a single script function
+struct ScriptFunctionProfile {
+	ScriptFunctionProfile() {
+		Calls = 0;
+		Instructions = 0;
+		TimeMs = 0;
+	}
+
+	uint32_t            Calls;
+	uint64_t            Instructions;
+	uint32_t            TimeMs;     // inclusive time, in milliseconds
+};
+
+// Predecoded byte-code of the script instance, shared with its forks
+struct ScriptDecodedCode {
+	std::vector<ScriptDecodedOp> Ops;
+	std::vector<int32_t> OpIndex;   // code position -> index in Ops, or -1
+	// Function profiles, keyed by the function's starting code position
+	std::unordered_map<int32_t, ScriptFunctionProfile> Profile;
+};
+
 struct ScriptVariable {
 	ScriptVariable() {
 		ScAddress = -1; // address = 0 is valid one, -1 means undefined
@@ -140,6 +189,9 @@ public:
 
 	char *code_fixups;
 
+	// predecoded operations, created after all the fixups are resolved
+	std::shared_ptr<ScriptDecodedCode> decoded_code;
+
 	// returns the currently executing instance, or NULL if none
 	static ccInstance *GetCurrentInstance(void);
 	// clears recorded stack of current instances
@@ -184,6 +236,13 @@ public:
 	// Also change CALLEXT op-codes to CALLAS when they pertain to a script instance
 	bool    ResolveImportFixups(const ccScript *scri);
 
+	// Predecode the byte-code into the operation stream used by Run()
+	void    DecodeCode();
+	// Get the execution statistics of the script functions
+	const ScriptDecodedCode *GetDecodedCode() const { return decoded_code.get(); }
+	// Reset the execution statistics of the script functions
+	void    ResetProfile();
+
 private:
 	bool    _Create(PScript scri, ccInstance *joined);
 	// free the memory associated with the instance
@@ -194,6 +253,12 @@ private:
 	ScriptVariable *FindGlobalVar(int32_t var_addr);
 	bool    CreateRuntimeCodeFixups(const ccScript *scri);
 	//bool    ReadOperation(ScriptOperation &op, int32_t at_pc);
+	// Decode a single operation at the given code position
+	void    DecodeOperation(int32_t at_pc, ScriptDecodedOp &op) const;
+	// Merge the frequent instruction pairs into the fused operations
+	void    FuseOperations();
+	// Resolve the operation argument, in the same way as the original byte-code reader
+	bool    ResolveArgument(const ScriptDecodedOp &op, int arg_idx, RuntimeScriptValue &argument);
 
 	// Begin executing script starting from the given bytecode index
 	int     Run(int32_t curpc);
@@ -88,6 +88,9 @@ void    can_run_delayed_command();
 // Gets current running script position
 bool    get_script_position(ScriptPosition &script_pos);
 AGS::Shared::String cc_get_callstack(int max_lines = INT_MAX);
+// Gets the execution statistics of the script functions, most used first
+AGS::Shared::String cc_get_script_profile(int max_lines = INT_MAX);
+void    cc_reset_script_profile();
 
 } // namespace AGS3
 
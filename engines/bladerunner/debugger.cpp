@@ -145,6 +145,7 @@ Debugger::Debugger(BladeRunnerEngine *vm) : GUI::Debugger() {
 	registerCmd("outtake", WRAP_METHOD(Debugger, cmdOuttake));
 	registerCmd("playvqa", WRAP_METHOD(Debugger, cmdPlayVqa));
 	registerCmd("ammo", WRAP_METHOD(Debugger, cmdAmmo));
+	registerCmd("vqastats", WRAP_METHOD(Debugger, cmdVqaStats));
 #if BLADERUNNER_ORIGINAL_BUGS
 #else
 	registerCmd("effect", WRAP_METHOD(Debugger, cmdEffect));
@@ -2138,6 +2139,37 @@ bool Debugger::cmdDifficulty(int argc, const char **argv) {
 	}
 	return true;
 }
+
+bool Debugger::cmdVqaStats(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && scumm_stricmp(argv[1], "reset") != 0)) {
+		debugPrintf("Show or reset the decoding times of the scene's background video.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	VQAPlayer *vqaPlayer = _vm->_scene->_vqaPlayer;
+	if (vqaPlayer == nullptr) {
+		debugPrintf("No background video is playing\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		vqaPlayer->resetDecodeStats();
+		debugPrintf("Decoding statistics of %s were reset\n", vqaPlayer->_name.c_str());
+		return true;
+	}
+
+	const VQAPlayer::DecodeStats &stats = vqaPlayer->getDecodeStats();
+	debugPrintf("Video: %s, frame %d\n", vqaPlayer->_name.c_str(), vqaPlayer->_frame);
+	debugPrintf("Frames decoded: %u\n", stats.framesDecoded);
+	if (stats.framesDecoded > 0) {
+		debugPrintf("Frame decoding: last %u ms, max %u ms, avg %.2f ms\n", stats.frameTimeLast, stats.frameTimeMax, (float)stats.frameTimeTotal / stats.framesDecoded);
+		debugPrintf("Z-buffer decoding: max %u ms, avg %.2f ms\n", stats.zbufferTimeMax, (float)stats.zbufferTimeTotal / stats.framesDecoded);
+	}
+	debugPrintf("Codebooks decoded ahead: %u\n", stats.codebooksPrefetched);
+	return true;
+}
+
 #if BLADERUNNER_ORIGINAL_BUGS
 #else
 bool Debugger::cmdEffect(int argc, const char **argv) {
@@ -27,6 +27,7 @@
 #include "bladerunner/view.h"
 #include "bladerunner/matrix.h"
 
+#include "common/array.h"
 #include "common/rect.h"
 
 #include "graphics/surface.h"
@@ -42,7 +43,26 @@ class BladeRunnerEngine;
 class Lights;
 class SetEffects;
 
+#ifdef SCUMMVM_SSE2
+// Vectorized z-buffered span filling, see slice_renderer_sse2.cpp
+void fillSliceSpanSSE2(uint16 *zbufferLine, byte *dst, int bytesPerPixel, int count, uint16 z, uint32 color);
+#endif
+
 class SliceRenderer {
+	/**
+	 * Everything needed to rasterize one screen line of an actor. The lines are
+	 * set up one after the other, as the light and fog calculations depend on the
+	 * previous lines, but the rasterization of each line is independent.
+	 */
+	struct SliceLine {
+		int   y;
+		int   slice;
+		int   m13;
+		int   m23;
+		Color lightsColor;
+		Color setEffectColor;
+	};
+
 	BladeRunnerEngine *_vm;
 
 	int       _animation;
@@ -75,20 +95,18 @@ class SliceRenderer {
 
 	int _m11lookup[256];
 	int _m12lookup[256];
-	int _m13;
 	int _m21lookup[256];
 	int _m22lookup[256];
-	int _m23;
+
+	Common::Array<SliceLine> _lines;
 
 	bool _animationsShadowEnabled[997];
 
 	Vector3 _shadowPolygonDefault[12];
 	Vector3 _shadowPolygonCurrent[12];
 
-	Color _setEffectColor;
-	Color _lightsColor;
-
 	Graphics::PixelFormat _pixelFormat;
+	bool _useSIMD;
 
 public:
 	SliceRenderer(BladeRunnerEngine *vm);
@@ -113,7 +131,8 @@ private:
 	Matrix3x2 calculateFacingRotationMatrix();
 	void loadFrame(int animation, int frame);
 
-	void drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine);
+	void drawSliceLines(uint first, uint last, Graphics::Surface &surface, uint16 *zbuffer);
+	void drawSlice(const SliceLine &line, bool advanced, Graphics::Surface &surface, uint16 *zbufferLine);
 	void drawShadowInWorld(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 	void drawShadowPolygon(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 };
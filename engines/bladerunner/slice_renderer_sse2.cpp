@@ -0,0 +1,76 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <emmintrin.h>
+
+#include "bladerunner/slice_renderer.h"
+
+namespace BladeRunner {
+
+// Fills the pixels of a slice span which are closer than the z-buffer, and
+// updates the z-buffer for them. The z-buffer is unsigned, so both sides of
+// the comparison are biased by 0x8000 to use the signed 16-bit comparison.
+
+void fillSliceSpanSSE2(uint16 *zbufferLine, byte *dst, int bytesPerPixel, int count, uint16 z, uint32 color) {
+	const __m128i bias = _mm_set1_epi16((int16)0x8000);
+	const __m128i zVec = _mm_set1_epi16((int16)z);
+	const __m128i zBiased = _mm_xor_si128(zVec, bias);
+	int x = 0;
+
+	if (bytesPerPixel == 2) {
+		const __m128i colorVec = _mm_set1_epi16((int16)color);
+		for (; x + 8 <= count; x += 8) {
+			__m128i zbuffer = _mm_loadu_si128((const __m128i *)(zbufferLine + x));
+			__m128i mask = _mm_cmpgt_epi16(_mm_xor_si128(zbuffer, bias), zBiased);
+			_mm_storeu_si128((__m128i *)(zbufferLine + x), _mm_or_si128(_mm_and_si128(mask, zVec), _mm_andnot_si128(mask, zbuffer)));
+
+			__m128i pixels = _mm_loadu_si128((const __m128i *)(dst + 2 * x));
+			_mm_storeu_si128((__m128i *)(dst + 2 * x), _mm_or_si128(_mm_and_si128(mask, colorVec), _mm_andnot_si128(mask, pixels)));
+		}
+	} else {
+		const __m128i colorVec = _mm_set1_epi32((int32)color);
+		for (; x + 8 <= count; x += 8) {
+			__m128i zbuffer = _mm_loadu_si128((const __m128i *)(zbufferLine + x));
+			__m128i mask = _mm_cmpgt_epi16(_mm_xor_si128(zbuffer, bias), zBiased);
+			_mm_storeu_si128((__m128i *)(zbufferLine + x), _mm_or_si128(_mm_and_si128(mask, zVec), _mm_andnot_si128(mask, zbuffer)));
+
+			// Every 16-bit mask lane covers one 32-bit pixel
+			__m128i maskLo = _mm_unpacklo_epi16(mask, mask);
+			__m128i maskHi = _mm_unpackhi_epi16(mask, mask);
+			__m128i pixelsLo = _mm_loadu_si128((const __m128i *)(dst + 4 * x));
+			__m128i pixelsHi = _mm_loadu_si128((const __m128i *)(dst + 4 * x + 16));
+			_mm_storeu_si128((__m128i *)(dst + 4 * x), _mm_or_si128(_mm_and_si128(maskLo, colorVec), _mm_andnot_si128(maskLo, pixelsLo)));
+			_mm_storeu_si128((__m128i *)(dst + 4 * x + 16), _mm_or_si128(_mm_and_si128(maskHi, colorVec), _mm_andnot_si128(maskHi, pixelsHi)));
+		}
+	}
+
+	for (; x < count; x++) {
+		if (z < zbufferLine[x]) {
+			zbufferLine[x] = z;
+			if (bytesPerPixel == 2)
+				*(uint16 *)(dst + 2 * x) = (uint16)color;
+			else
+				*(uint32 *)(dst + 4 * x) = color;
+		}
+	}
+}
+
+} // End of namespace BladeRunner
@@ -288,6 +288,25 @@ void VQADecoder::readFrame(int frame, uint readFlags) {
 	readPacket(readFlags);
 }
 
+// Reads the codebook of a frame ahead of its playback, so the codebook does not
+// have to be decompressed in the middle of the frame update.
+// Returns true if a new codebook was decompressed.
+bool VQADecoder::prefetchCodebook(int frame) {
+	// Old v2 VQAs assemble their codebooks from parts while playing
+	if (_oldV2VQA || _codebooks.empty() || frame < 0 || frame >= numFrames()) {
+		return false;
+	}
+
+	CodebookInfo &codebookInfo = codebookInfoForFrame(frame);
+	if (codebookInfo.data) {
+		return false;
+	}
+
+	// The codebook is stored in the first frame that uses it
+	readFrame(codebookInfo.frame, kVQAReadCodebook);
+	return codebookInfo.data != nullptr;
+}
+
 bool VQADecoder::readVQHD(Common::SeekableReadStream *s, uint32 size) {
 	if (size != 42)
 		return false;
@@ -66,6 +66,7 @@ public:
 	bool loadStream(Common::SeekableReadStream *s);
 
 	void readFrame(int frame, uint readFlags = kVQAReadAll);
+	bool prefetchCodebook(int frame);
 
 	void                        decodeVideoFrame(Graphics::Surface *surface, int frame, bool forceDraw = false);
 	void                        decodeZBuffer(ZBuffer *zbuffer);
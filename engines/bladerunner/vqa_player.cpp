@@ -273,11 +273,21 @@ int VQAPlayer::update(bool forceDraw, bool advanceFrame, bool useTime, Graphics:
 		// Note, we use unsigned difference to avoid potential time overflow issues
 		result = -1;
 
+		// Use the time until then to get the next frame ready
+		prefetchUpcomingFrame();
+
 	} else if (advanceFrame) {
 		_frame = _frameNext;
+		uint32 decodeStart = _vm->_time->currentSystem();
 		_decoder.readFrame(_frameNext, kVQAReadVideo);
 		_decoder.decodeVideoFrame(customSurface != nullptr ? customSurface : _surface, _frameNext);
 
+		uint32 decodeTime = _vm->_time->currentSystem() - decodeStart;
+		++_decodeStats.framesDecoded;
+		_decodeStats.frameTimeLast = decodeTime;
+		_decodeStats.frameTimeMax = MAX(_decodeStats.frameTimeMax, decodeTime);
+		_decodeStats.frameTimeTotal += decodeTime;
+
 		int maxAllowedAudioPreloadedFrames = kMaxAudioPreloadedFrames;
 		if (_frameEnd - _frameNext < kMaxAudioPreloadedFrames - 1) {
 			maxAllowedAudioPreloadedFrames = _frameEnd - _frameNext + 1;
@@ -361,7 +371,11 @@ int VQAPlayer::update(bool forceDraw, bool advanceFrame, bool useTime, Graphics:
 }
 
 void VQAPlayer::updateZBuffer(ZBuffer *zbuffer) {
+	uint32 decodeStart = _vm->_time->currentSystem();
 	_decoder.decodeZBuffer(zbuffer);
+	uint32 decodeTime = _vm->_time->currentSystem() - decodeStart;
+	_decodeStats.zbufferTimeMax = MAX(_decodeStats.zbufferTimeMax, decodeTime);
+	_decodeStats.zbufferTimeTotal += decodeTime;
 #if !BLADERUNNER_ORIGINAL_BUGS
 	if (_specialPS15GlitchFix) {
 		// The glitch (bad z-buffer, value zero (0))
@@ -494,6 +508,35 @@ int VQAPlayer::getQueuedAudioFrames() const {
 	return _audioStream->numQueuedStreams();
 }
 
+// Returns the frame update() is going to decode next, following the loop
+// points set by setLoop() and setBeginAndEndFrame(), or -1 if the video ends
+int VQAPlayer::getUpcomingFrame() const {
+	int frameNext = _frameNext < 0 ? _frameBeginNext : _frameNext;
+
+	if (frameNext > _frameEnd) {
+		if (_repeatsCount > 0 || _repeatsCount == -1) {
+			return _frameBeginNext;
+		}
+		return -1;
+	}
+	return frameNext;
+}
+
+// Decompresses the codebook of the upcoming frame, if it was not used yet.
+// Large codebooks are usually at the start of the loops, so this keeps the
+// loop transitions from stalling on them.
+void VQAPlayer::prefetchUpcomingFrame() {
+	int frame = getUpcomingFrame();
+	if (frame < 0 || frame == _framePrefetched) {
+		return;
+	}
+
+	_framePrefetched = frame;
+	if (_decoder.prefetchCodebook(frame)) {
+		++_decodeStats.codebooksPrefetched;
+	}
+}
+
 // Adds another audio "frame" to the queue of the audio stream
 void VQAPlayer::queueAudioFrame(Audio::AudioStream *audioStream) {
 	if (audioStream == nullptr) {
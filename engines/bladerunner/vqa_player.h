@@ -46,6 +46,30 @@ class VQAPlayer {
 	friend class Debugger;
 	friend class OuttakePlayer;
 
+public:
+	struct DecodeStats {
+		uint32 framesDecoded;
+		uint32 frameTimeLast;  // in milliseconds, reading and decoding of the video
+		uint32 frameTimeMax;
+		uint32 frameTimeTotal;
+		uint32 zbufferTimeMax; // in milliseconds, decoding of the z-buffer
+		uint32 zbufferTimeTotal;
+		uint32 codebooksPrefetched;
+
+		DecodeStats() { reset(); }
+		void reset() {
+			framesDecoded       = 0;
+			frameTimeLast       = 0;
+			frameTimeMax        = 0;
+			frameTimeTotal      = 0;
+			zbufferTimeMax      = 0;
+			zbufferTimeTotal    = 0;
+			codebooksPrefetched = 0;
+		}
+	};
+
+private:
+
 	BladeRunnerEngine           *_vm;
 	Common::String               _name;
 	Common::SeekableReadStream  *_s;
@@ -89,6 +113,9 @@ class VQAPlayer {
 	bool   _specialPS15GlitchFix;
 	bool   _specialUG18DoNotRepeatLastLoop;
 
+	int         _framePrefetched;
+	DecodeStats _decodeStats;
+
 	void (*_callbackLoopEnded)(void *, int frame, int loopId);
 	void  *_callbackData;
 
@@ -117,6 +144,7 @@ public:
 		  _audioStarted(false),
 		  _specialPS15GlitchFix(false),
 		  _specialUG18DoNotRepeatLastLoop(false),
+		  _framePrefetched(-1),
 		  _callbackLoopEnded(nullptr),
 		  _callbackData(nullptr) { }
 
@@ -150,8 +178,13 @@ public:
 
 	int getQueuedAudioFrames() const;
 
+	const DecodeStats &getDecodeStats() const { return _decodeStats; }
+	void resetDecodeStats() { _decodeStats.reset(); }
+
 private:
 	void queueAudioFrame(Audio::AudioStream *audioStream);
+	int  getUpcomingFrame() const;
+	void prefetchUpcomingFrame();
 };
 
 } // End of namespace BladeRunner
@@ -517,26 +517,30 @@ void LC::c_proprefpush() {
 }
 
 void LC::c_varpush() {
-	LC::c_varrefpush();
-	Datum d = g_lingo->pop();
+	Common::String name(g_lingo->readString());
+	Datum d(name);
+	d.type = VARREF;
 	g_lingo->push(g_lingo->varFetch(d));
 }
 
 void LC::c_globalpush() {
-	LC::c_globalrefpush();
-	Datum d = g_lingo->pop();
+	Common::String name(g_lingo->readString());
+	Datum d(name);
+	d.type = GLOBALREF;
 	g_lingo->push(g_lingo->varFetch(d));
 }
 
 void LC::c_localpush() {
-	LC::c_localrefpush();
-	Datum d = g_lingo->pop();
+	Common::String name(g_lingo->readString());
+	Datum d(name);
+	d.type = LOCALREF;
 	g_lingo->push(g_lingo->varFetch(d));
 }
 
 void LC::c_proppush() {
-	LC::c_proprefpush();
-	Datum d = g_lingo->pop();
+	Common::String name(g_lingo->readString());
+	Datum d(name);
+	d.type = PROPREF;
 	g_lingo->push(g_lingo->varFetch(d));
 }
 
@@ -335,8 +335,11 @@ Symbol Lingo::getHandler(const Common::String &name) {
 	Symbol sym;
 
 	// local functions
-	if (_state->context && _state->context->_functionHandlers.contains(name))
-		return _state->context->_functionHandlers[name];
+	if (_state->context) {
+		SymbolHash::const_iterator it = _state->context->_functionHandlers.find(name);
+		if (it != _state->context->_functionHandlers.end())
+			return it->_value;
+	}
 
 	sym = g_director->getCurrentMovie()->getHandler(name);
 	if (sym.type != VOIDSYM)
@@ -864,26 +867,31 @@ int Lingo::getAlignedType(const Datum &d1, const Datum &d2, bool equality) {
 Datum::Datum() {
 	u.s = nullptr;
 	type = VOID;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
+	intrusiveRefCount = false;
 	ignoreGlobal = false;
 }
 
 Datum::Datum(const Datum &d) {
 	type = d.type;
 	u = d.u;
-	refCount = d.refCount;
-	*refCount += 1;
+	refCount = d.shareRefCount();
+	intrusiveRefCount = d.intrusiveRefCount;
 	ignoreGlobal = false;
 }
 
 Datum& Datum::operator=(const Datum &d) {
-	if (this != &d && refCount != d.refCount) {
+	if (this != &d && (!refCount || refCount != d.refCount)) {
+		// Take the new reference first, d may be owned by our payload
+		int *newRefCount = d.shareRefCount();
+		DatumType newType = d.type;
+		bool newIntrusive = d.intrusiveRefCount;
+		auto newU = d.u;
 		reset();
-		type = d.type;
-		u = d.u;
-		refCount = d.refCount;
-		*refCount += 1;
+		type = newType;
+		u = newU;
+		refCount = newRefCount;
+		intrusiveRefCount = newIntrusive;
 	}
 	ignoreGlobal = false;
 	return *this;
@@ -892,24 +900,24 @@ Datum& Datum::operator=(const Datum &d) {
 Datum::Datum(int val) {
 	u.i = val;
 	type = INT;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
+	intrusiveRefCount = false;
 	ignoreGlobal = false;
 }
 
 Datum::Datum(double val) {
 	u.f = val;
 	type = FLOAT;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
+	intrusiveRefCount = false;
 	ignoreGlobal = false;
 }
 
 Datum::Datum(const Common::String &val) {
 	u.s = new Common::String(val);
 	type = STRING;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
+	intrusiveRefCount = false;
 	ignoreGlobal = false;
 }
 
@@ -921,17 +929,17 @@ Datum::Datum(AbstractObject *val) {
 		*refCount += 1;
 	} else {
 		type = VOID;
-		refCount = new int;
-		*refCount = 1;
+		refCount = nullptr;
 	}
+	intrusiveRefCount = false;
 	ignoreGlobal = false;
 }
 
 Datum::Datum(const CastMemberID &val) {
 	u.cast = new CastMemberID(val);
 	type = CASTREF;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
+	intrusiveRefCount = false;
 	ignoreGlobal = false;
 }
 
@@ -940,8 +948,8 @@ Datum::Datum(const Common::Point &point) {
 	u.farr = new FArray;
 	u.farr->arr.push_back(Datum(point.x));
 	u.farr->arr.push_back(Datum(point.y));
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
+	intrusiveRefCount = false;
 	ignoreGlobal = false;
 }
 
@@ -952,78 +960,124 @@ Datum::Datum(const Common::Rect &rect) {
 	u.farr->arr.push_back(Datum(rect.top));
 	u.farr->arr.push_back(Datum(rect.right));
 	u.farr->arr.push_back(Datum(rect.bottom));
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
+	intrusiveRefCount = false;
 	ignoreGlobal = false;
 }
 
-void Datum::reset() {
-	if (!refCount)
-		return;
-
-	*refCount -= 1;
-	// Coverity thinks that we always free memory, as it assumes
-	// (correctly) that there are cases when refCount == 0
-	// Thus, DO NOT COMPILE, trick it and shut tons of false positives
-#ifndef __COVERITY__
-	if (*refCount <= 0) {
+int *Datum::shareRefCount() const {
+	if (!refCount) {
 		switch (type) {
 		case VOID:
 		case INT:
 		case FLOAT:
 		case ARGC:
 		case ARGCNORET:
-			break;
-		case VARREF:
-		case GLOBALREF:
-		case LOCALREF:
-		case PROPREF:
-		case STRING:
-		case SYMBOL:
-			delete u.s;
-			break;
+			// Values are copied, nothing to share
+			return nullptr;
 		case ARRAY:
 		case POINT:
 		case RECT:
-			delete u.farr;
+			if (u.farr) {
+				refCount = &u.farr->_refCount;
+				intrusiveRefCount = true;
+			}
 			break;
 		case PARRAY:
-			delete u.parr;
-			break;
-		case OBJECT:
-			if (u.obj->getObjType() == kWindowObj) {
-				// Window has an override for decRefCount, use it directly
-				*refCount += 1;
-				static_cast<Window *>(u.obj)->decRefCount();
-			} else {
-				// *refCount is copied between the Datum and the Object,
-				// so should be safe to delete the Object
-				delete u.obj;
+			if (u.parr) {
+				refCount = &u.parr->_refCount;
+				intrusiveRefCount = true;
 			}
 			break;
-		case CHUNKREF:
-			delete u.cref;
-			break;
-		case CASTREF:
-		case FIELDREF:
-			delete u.cast;
-			break;
-		case MENUREF:
-			delete u.menu;
-			break;
-		case PICTUREREF:
-			delete u.picture;
-			break;
 		default:
-			warning("Datum::reset(): Unprocessed REF type %d", type);
 			break;
 		}
-		if (type != OBJECT) // object owns refCount
-			delete refCount;
+		if (!refCount) {
+			refCount = new int;
+			intrusiveRefCount = false;
+		}
+		*refCount = 1;
+	}
+	*refCount += 1;
+	return refCount;
+}
+
+void Datum::reset() {
+	if (!refCount) {
+		// Nobody else refers to the payload
+		if (type != OBJECT)
+			freePayload();
+		return;
+	}
+
+	*refCount -= 1;
+	// Coverity thinks that we always free memory, as it assumes
+	// (correctly) that there are cases when refCount == 0
+	// Thus, DO NOT COMPILE, trick it and shut tons of false positives
+#ifndef __COVERITY__
+	if (*refCount <= 0) {
+		// An intrusive counter goes away together with the payload
+		int *ownRefCount = (type != OBJECT && !intrusiveRefCount) ? refCount : nullptr;
+		freePayload();
+		delete ownRefCount;
 	}
 #endif
 }
 
+void Datum::freePayload() {
+	switch (type) {
+	case VOID:
+	case INT:
+	case FLOAT:
+	case ARGC:
+	case ARGCNORET:
+		break;
+	case VARREF:
+	case GLOBALREF:
+	case LOCALREF:
+	case PROPREF:
+	case STRING:
+	case SYMBOL:
+		delete u.s;
+		break;
+	case ARRAY:
+	case POINT:
+	case RECT:
+		delete u.farr;
+		break;
+	case PARRAY:
+		delete u.parr;
+		break;
+	case OBJECT:
+		if (u.obj->getObjType() == kWindowObj) {
+			// Window has an override for decRefCount, use it directly
+			*refCount += 1;
+			static_cast<Window *>(u.obj)->decRefCount();
+		} else {
+			// *refCount is copied between the Datum and the Object,
+			// so should be safe to delete the Object
+			delete u.obj;
+		}
+		break;
+	case CHUNKREF:
+		delete u.cref;
+		break;
+	case CASTREF:
+	case FIELDREF:
+		delete u.cast;
+		break;
+	case MENUREF:
+		delete u.menu;
+		break;
+	case PICTUREREF:
+		delete u.picture;
+		break;
+	default:
+		warning("Datum::reset(): Unprocessed REF type %d", type);
+		break;
+	}
+}
+
 Datum Datum::eval() const {
 	if (isRef()) {
 		return g_lingo->varFetch(*this);
@@ -1619,11 +1673,14 @@ void Lingo::varAssign(const Datum &var, const Datum &value) {
 	switch (var.type) {
 	case VARREF:
 		{
-			Common::String name = *var.u.s;
-			if (_state->localVars && _state->localVars->contains(name)) {
-				(*_state->localVars)[name] = value;
-				g_debugger->varWriteHook(name);
-				return;
+			const Common::String &name = *var.u.s;
+			if (_state->localVars) {
+				DatumHash::iterator it = _state->localVars->find(name);
+				if (it != _state->localVars->end()) {
+					it->_value = value;
+					g_debugger->varWriteHook(name);
+					return;
+				}
 			}
 			if (_state->me.type == OBJECT && _state->me.u.obj->hasProp(name)) {
 				_state->me.u.obj->setProp(name, value);
@@ -1643,9 +1700,10 @@ void Lingo::varAssign(const Datum &var, const Datum &value) {
 		break;
 	case LOCALREF:
 		{
-			Common::String name = *var.u.s;
-			if (_state->localVars && _state->localVars->contains(name)) {
-				(*_state->localVars)[name] = value;
+			const Common::String &name = *var.u.s;
+			DatumHash::iterator it;
+			if (_state->localVars && (it = _state->localVars->find(name)) != _state->localVars->end()) {
+				it->_value = value;
 				g_debugger->varWriteHook(name);
 			} else {
 				warning("varAssign: local variable %s not defined", name.c_str());
@@ -1654,7 +1712,7 @@ void Lingo::varAssign(const Datum &var, const Datum &value) {
 		break;
 	case PROPREF:
 		{
-			Common::String name = *var.u.s;
+			const Common::String &name = *var.u.s;
 			if (_state->me.type == OBJECT && _state->me.u.obj->hasProp(name)) {
 				_state->me.u.obj->setProp(name, value);
 				g_debugger->varWriteHook(name);
@@ -1735,18 +1793,20 @@ Datum Lingo::varFetch(const Datum &var, bool silent) {
 	switch (var.type) {
 	case VARREF:
 		{
-			Datum d;
-			Common::String name = *var.u.s;
+			const Common::String &name = *var.u.s;
 			g_debugger->varReadHook(name);
 
-			if (_state->localVars && _state->localVars->contains(name)) {
-				return (*_state->localVars)[name];
+			if (_state->localVars) {
+				DatumHash::const_iterator it = _state->localVars->find(name);
+				if (it != _state->localVars->end())
+					return it->_value;
 			}
 			if (_state->me.type == OBJECT && _state->me.u.obj->hasProp(name)) {
 				return _state->me.u.obj->getProp(name);
 			}
-			if (_globalvars.contains(name)) {
-				return _globalvars[name];
+			DatumHash::const_iterator it = _globalvars.find(name);
+			if (it != _globalvars.end()) {
+				return it->_value;
 			}
 
 			if (!silent)
@@ -1756,10 +1816,11 @@ Datum Lingo::varFetch(const Datum &var, bool silent) {
 		break;
 	case GLOBALREF:
 		{
-			Common::String name = *var.u.s;
+			const Common::String &name = *var.u.s;
 			g_debugger->varReadHook(name);
-			if (_globalvars.contains(name)) {
-				return _globalvars[name];
+			DatumHash::const_iterator it = _globalvars.find(name);
+			if (it != _globalvars.end()) {
+				return it->_value;
 			}
 			debugC(1, kDebugLingoExec, "varFetch: global variable %s not defined", name.c_str());
 			return result;
@@ -1767,10 +1828,12 @@ Datum Lingo::varFetch(const Datum &var, bool silent) {
 		break;
 	case LOCALREF:
 		{
-			Common::String name = *var.u.s;
+			const Common::String &name = *var.u.s;
 			g_debugger->varReadHook(name);
-			if (_state->localVars && _state->localVars->contains(name)) {
-				return (*_state->localVars)[name];
+			if (_state->localVars) {
+				DatumHash::const_iterator it = _state->localVars->find(name);
+				if (it != _state->localVars->end())
+					return it->_value;
 			}
 			debugC(1, kDebugLingoExec, "varFetch: local variable %s not defined", name.c_str());
 			return result;
@@ -1778,7 +1841,7 @@ Datum Lingo::varFetch(const Datum &var, bool silent) {
 		break;
 	case PROPREF:
 		{
-			Common::String name = *var.u.s;
+			const Common::String &name = *var.u.s;
 			g_debugger->varReadHook(name);
 			if (_state->me.type == OBJECT && _state->me.u.obj->hasProp(name)) {
 				return _state->me.u.obj->getProp(name);
@@ -110,20 +110,22 @@ struct Symbol {	/* symbol table entry */
 
 struct PArray {
 	bool _sorted;
+	int _refCount;	// used by the owning Datums once the list is shared
 	PropertyArray arr;
 
-	PArray() : _sorted(false) {}
+	PArray() : _sorted(false), _refCount(0) {}
 
-	PArray(int size) : _sorted(false), arr(size) {}
+	PArray(int size) : _sorted(false), _refCount(0), arr(size) {}
 };
 
 struct FArray {
 	bool _sorted;
+	int _refCount;	// used by the owning Datums once the list is shared
 	DatumArray arr;
 
-	FArray() : _sorted(false) {}
+	FArray() : _sorted(false), _refCount(0) {}
 
-	FArray(int size) : _sorted(false), arr(size) {}
+	FArray(int size) : _sorted(false), _refCount(0), arr(size) {}
 };
 
 
@@ -143,7 +145,11 @@ struct Datum {	/* interpreter stack type */
 		PictureReference *picture; /* PICTUREREF */
 	} u;
 
-	int *refCount;
+	// The reference counter is only created when the payload gets shared,
+	// a Datum without one is the sole owner of its payload. Scalar values
+	// never have one. String payloads are still allocated separately.
+	mutable int *refCount;
+	mutable bool intrusiveRefCount; // refCount is stored in the payload itself
 
 	bool ignoreGlobal; // True if this Datum should be ignored by showGlobals and clearGlobals
 
@@ -186,6 +192,11 @@ struct Datum {	/* interpreter stack type */
 	bool operator<(Datum &d) const;
 	bool operator>=(Datum &d) const;
 	bool operator<=(Datum &d) const;
+
+private:
+	// Get the reference counter for sharing the payload, creating it if needed
+	int *shareRefCount() const;
+	void freePayload();
 };
 
 struct ChunkReference {
@@ -23,7 +23,6 @@
 // available at https://github.com/TomHarte/Phantasma/ (MIT)
 
 #include "common/algorithm.h"
-#include "common/hash-ptr.h"
 
 #include "freescape/freescape.h"
 #include "freescape/area.h"
@@ -96,6 +95,8 @@ Area::Area(uint16 areaID_, uint16 areaFlags_, ObjectMap *objectsByID_, ObjectMap
 
 	Common::sort(_drawableObjects.begin(), _drawableObjects.end(), compareObjects);
 	_lastTick = 0;
+	_drawnObjects = 0;
+	_culledObjects = 0;
 }
 
 Area::~Area() {
@@ -229,6 +230,8 @@ void Area::draw(Freescape::Renderer *gfx, uint32 animationTicks, Math::Vector3d
 	ObjectArray nonPlanarObjects;
 	Object *floor = nullptr;
 	float offset = !gfx->_isAccelerated ? 2.0 : 1.0;
+	_drawnObjects = 0;
+	_culledObjects = 0;
 
 	for (auto &obj : _drawableObjects) {
 		if (!obj->isDestroyed() && !obj->isInvisible()) {
@@ -239,6 +242,7 @@ void Area::draw(Freescape::Renderer *gfx, uint32 animationTicks, Math::Vector3d
 
 			if (obj->getType() == ObjectType::kGroupType) {
 				drawGroup(gfx, (Group *)obj, runAnimation);
+				_drawnObjects++;
 				continue;
 			}
 
@@ -255,9 +259,66 @@ void Area::draw(Freescape::Renderer *gfx, uint32 animationTicks, Math::Vector3d
 		gfx->depthTesting(true);
 	}
 
-	Common::HashMap<Object *, float> offsetMap;
+	if (updatePlanarOffsetStates(planarObjects, nonPlanarObjects))
+		computePlanarOffsets(planarObjects, nonPlanarObjects, offset);
+
+	for (auto &pair : _planarOffsets) {
+		if (!isCulled(gfx, pair._key, pair._value))
+			pair._key->draw(gfx, pair._value);
+	}
+
+	for (auto &obj : nonPlanarObjects) {
+		if (!isCulled(gfx, obj, 0))
+			obj->draw(gfx);
+	}
+
+	_lastTick = animationTicks;
+}
+
+bool Area::updatePlanarOffsetStates(const ObjectArray &planarObjects, const ObjectArray &nonPlanarObjects) {
+	uint stateIndex = 0;
+	bool changed = false;
+
+	for (int i = 0; i < 2; i++) {
+		const ObjectArray &objects = i == 0 ? planarObjects : nonPlanarObjects;
+		for (auto &object : objects) {
+			// Objects moved by groups are ignored by computePlanarOffsets
+			if (i == 1 && object->_partOfGroup)
+				continue;
+
+			PlanarOffsetState state;
+			state.object = object;
+			state.planar = i == 0;
+			state.origin = object->getOrigin();
+			state.min = object->_boundingBox.getMin();
+			state.max = object->_boundingBox.getMax();
+
+			if (stateIndex == _planarOffsetStates.size()) {
+				_planarOffsetStates.push_back(state);
+				changed = true;
+			} else {
+				PlanarOffsetState &cached = _planarOffsetStates[stateIndex];
+				if (cached.object != state.object || cached.planar != state.planar || cached.origin != state.origin ||
+					cached.min != state.min || cached.max != state.max) {
+					cached = state;
+					changed = true;
+				}
+			}
+			stateIndex++;
+		}
+	}
+
+	if (stateIndex != _planarOffsetStates.size()) {
+		_planarOffsetStates.resize(stateIndex);
+		changed = true;
+	}
+	return changed;
+}
+
+void Area::computePlanarOffsets(const ObjectArray &planarObjects, const ObjectArray &nonPlanarObjects, float offset) {
+	_planarOffsets.clear();
 	for (auto &planar : planarObjects)
-		offsetMap[planar] = 0;
+		_planarOffsets[planar] = 0;
 
 	for (auto &planar : planarObjects) {
 		Math::Vector3d centerPlanar = planar->_boundingBox.getMin() + planar->_boundingBox.getMax();
@@ -273,19 +334,19 @@ void Area::draw(Freescape::Renderer *gfx, uint32 animationTicks, Math::Vector3d
 
 			if (planar->getSize().x() == 0) {
 				if (object->getOrigin().x() >= centerPlanar.x())
-					offsetMap[planar] = -offset;
+					_planarOffsets[planar] = -offset;
 				else
-					offsetMap[planar] = offset;
+					_planarOffsets[planar] = offset;
 			} else if (planar->getSize().y() == 0) {
 				if (object->getOrigin().y() >= centerPlanar.y())
-					offsetMap[planar] = -offset;
+					_planarOffsets[planar] = -offset;
 				else
-					offsetMap[planar] = offset;
+					_planarOffsets[planar] = offset;
 			} else if (planar->getSize().z() == 0) {
 				if (object->getOrigin().z() >= centerPlanar.z())
-					offsetMap[planar] = -offset;
+					_planarOffsets[planar] = -offset;
 				else
-					offsetMap[planar] = offset;
+					_planarOffsets[planar] = offset;
 			} else
 				; //It was not really planar?!
 		}
@@ -316,40 +377,51 @@ void Area::draw(Freescape::Renderer *gfx, uint32 animationTicks, Math::Vector3d
 				continue;
 
 			//debug("planar object %d collides with planar object %d", planar->getObjectID(), object->getObjectID());
-			if (offsetMap[planar] == offsetMap[object] && offsetMap[object] != 0) {
+			if (_planarOffsets[planar] == _planarOffsets[object] && _planarOffsets[object] != 0) {
 				// Nothing to do?
-			} else if (offsetMap[planar] == offsetMap[object] && offsetMap[object] == 0) {
+			} else if (_planarOffsets[planar] == _planarOffsets[object] && _planarOffsets[object] == 0) {
 				if (planar->getSize().x() == 0) {
 					if (object->getOrigin().x() < centerPlanar.x())
-						offsetMap[planar] = -offset;
+						_planarOffsets[planar] = -offset;
 					else
-						offsetMap[planar] = offset;
+						_planarOffsets[planar] = offset;
 				} else if (planar->getSize().y() == 0) {
 					if (object->getOrigin().y() < centerPlanar.y())
-						offsetMap[planar] = -offset;
+						_planarOffsets[planar] = -offset;
 					else
-						offsetMap[planar] = offset;
+						_planarOffsets[planar] = offset;
 				} else if (planar->getSize().z() == 0) {
 					if (object->getOrigin().z() < centerPlanar.z())
-						offsetMap[planar] = -offset;
+						_planarOffsets[planar] = -offset;
 					else
-						offsetMap[planar] = offset;
+						_planarOffsets[planar] = offset;
 				} else
 					; //It was not really planar?!
 			}
 		}
 	}
+}
 
+bool Area::isCulled(Renderer *gfx, Object *obj, float offset) {
+	Math::AABB boundingBox = obj->_boundingBox;
+	if (!boundingBox.isValid()) {
+		_drawnObjects++;
+		return false;
+	}
 
-	for (auto &pair : offsetMap) {
-		pair._key->draw(gfx, pair._value);
+	if (offset != 0) {
+		Math::Vector3d margin(fabs(offset), fabs(offset), fabs(offset));
+		boundingBox.expand(boundingBox.getMin() - margin);
+		boundingBox.expand(boundingBox.getMax() + margin);
 	}
 
-	for (auto &obj : nonPlanarObjects) {
-		obj->draw(gfx);
+	if (gfx->isBoxInFrustum(boundingBox)) {
+		_drawnObjects++;
+		return false;
 	}
 
-	_lastTick = animationTicks;
+	_culledObjects++;
+	return true;
 }
 
 void Area::drawGroup(Freescape::Renderer *gfx, Group* group, bool runAnimation) {
@@ -25,6 +25,7 @@
 #ifndef FREESCAPE_AREA_H
 #define FREESCAPE_AREA_H
 
+#include "common/hash-ptr.h"
 #include "math/ray.h"
 #include "math/vector3d.h"
 
@@ -93,6 +94,10 @@ public:
 
 	uint32 _lastTick;
 
+	// Objects drawn and skipped for being out of view in the last frame
+	uint _drawnObjects;
+	uint _culledObjects;
+
 private:
 	uint16 _areaID;
 	uint16 _areaFlags;
@@ -101,6 +106,21 @@ private:
 	ObjectArray _drawableObjects;
 	ObjectMap _addedObjects;
 	Object *objectWithIDFromMap(ObjectMap *map, uint16 objectID);
+
+	// The offsets used to draw the planar objects on top of the objects
+	// they lie on, which are only computed again when these objects change
+	struct PlanarOffsetState {
+		Object *object;
+		bool planar;
+		Math::Vector3d origin;
+		Math::Vector3d min;
+		Math::Vector3d max;
+	};
+	Common::Array<PlanarOffsetState> _planarOffsetStates;
+	Common::HashMap<Object *, float> _planarOffsets;
+	bool updatePlanarOffsetStates(const ObjectArray &planarObjects, const ObjectArray &nonPlanarObjects);
+	void computePlanarOffsets(const ObjectArray &planarObjects, const ObjectArray &nonPlanarObjects, float offset);
+	bool isCulled(Renderer *gfx, Object *obj, float offset);
 };
 
 } // End of namespace Freescape
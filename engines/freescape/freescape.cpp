@@ -163,6 +163,10 @@ FreescapeEngine::FreescapeEngine(OSystem *syst, const ADGameDescription *gd)
 	_lastMinute = -1;
 	_frameLimiter = nullptr;
 	_vsyncEnabled = false;
+	_showFps = ConfMan.getBool("show_fps");
+	_fps = 0;
+	_frameCounter = 0;
+	_lastFpsTime = 0;
 
 	_underFireFrames = 0;
 	_shootingFrames = 0;
@@ -439,6 +443,17 @@ void FreescapeEngine::drawFrame() {
 		_shootingFrames--;
 	}
 
+	if (_showFps) {
+		_frameCounter++;
+		uint32 currentTime = g_system->getMillis();
+		uint32 delta = currentTime - _lastFpsTime;
+		if (delta >= 1000) {
+			_fps = _frameCounter * 1000 / delta;
+			_frameCounter = 0;
+			_lastFpsTime = currentTime;
+		}
+	}
+
 	drawBorder();
 	drawUI();
 }
@@ -149,6 +149,7 @@ public:
 	void clearBackground();
 	virtual void drawUI();
 	virtual void drawInfoMenu();
+	void drawRenderStats(Graphics::Surface *surface);
 	void drawBorderScreenAndWait(Graphics::Surface *surface);
 
 	virtual void drawCrossair(Graphics::Surface *surface);
@@ -404,6 +405,10 @@ public:
 	Renderer *_gfx;
 	Graphics::FrameLimiter *_frameLimiter;
 	bool _vsyncEnabled;
+	bool _showFps;
+	uint _fps;
+	uint _frameCounter;
+	uint32 _lastFpsTime;
 	Common::RenderMode _renderMode;
 	ColorMap _colorMap;
 	int _underFireFrames;
@@ -543,6 +543,15 @@ Common::Rect Renderer::viewport() const {
 	return _screenViewport;
 }
 
+void Renderer::updateFrustum() {
+	Math::Matrix4 proj = _projectionMatrix;
+	Math::Matrix4 model = _modelViewMatrix;
+	proj.transpose();
+	model.transpose();
+
+	_frustum.setup(proj * model);
+}
+
 bool Renderer::computeScreenViewport() {
 	int32 screenWidth = g_system->getWidth();
 	int32 screenHeight = g_system->getHeight();
@@ -153,6 +153,12 @@ public:
 	virtual void updateProjectionMatrix(float fov, float nearClipPlane, float farClipPlane) = 0;
 
 	Math::Matrix4 getMvpMatrix() const { return _mvpMatrix; }
+
+	/**
+	 * Check if a box can be seen from the camera set by positionCamera
+	 */
+	bool isBoxInFrustum(const Math::AABB &box) const { return _frustum.isInside(box); }
+
 	virtual Graphics::Surface *getScreenshot() = 0;
 	void flipVertical(Graphics::Surface *s);
 
@@ -172,6 +178,7 @@ protected:
 	Math::Matrix4 _mvpMatrix;
 
 	Math::Frustum _frustum;
+	void updateFrustum();
 
 	Math::Matrix4 makeProjectionMatrix(float fov, float nearClipPlane, float farClipPlane) const;
 };
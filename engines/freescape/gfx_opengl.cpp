@@ -203,6 +203,7 @@ void OpenGLRenderer::updateProjectionMatrix(float fov, float nearClipPlane, floa
 
 	glFrustum(xmaxValue, -xmaxValue, -ymaxValue, ymaxValue, nearClipPlane, farClipPlane);*/
 	glFrustum(1.5, -1.5, -0.625, 0.625, nearClipPlane, farClipPlane);
+	_projectionMatrix = Math::makeFrustumMatrix(1.5, -1.5, -0.625, 0.625, nearClipPlane, farClipPlane);
 	glMatrixMode(GL_MODELVIEW);
 	glLoadIdentity();
 }
@@ -213,6 +214,12 @@ void OpenGLRenderer::positionCamera(const Math::Vector3d &pos, const Math::Vecto
 	Math::Matrix4 lookMatrix = Math::makeLookAtMatrix(pos, interest, up_vec);
 	glMultMatrixf(lookMatrix.getData());
 	glTranslatef(-pos.x(), -pos.y(), -pos.z());
+
+	Math::Matrix4 viewMatrix;
+	viewMatrix.translate(-pos);
+	viewMatrix.transpose();
+	_modelViewMatrix = viewMatrix * lookMatrix;
+	updateFrustum();
 }
 
 void OpenGLRenderer::renderSensorShoot(byte color, const Math::Vector3d sensor, const Math::Vector3d target, const Common::Rect viewArea) {
@@ -162,6 +162,8 @@ void OpenGLShaderRenderer::positionCamera(const Math::Vector3d &pos, const Math:
 	model.transpose();
 	_mvpMatrix = proj * model;
 	_mvpMatrix.transpose();
+
+	updateFrustum();
 }
 void OpenGLShaderRenderer::renderSensorShoot(byte color, const Math::Vector3d sensor, const Math::Vector3d target, const Common::Rect viewArea) {
 	glEnable(GL_BLEND);
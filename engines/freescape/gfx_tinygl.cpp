@@ -109,6 +109,7 @@ void TinyGLRenderer::updateProjectionMatrix(float fov, float nearClipPlane, floa
 
 	tglFrustumf(xmaxValue, -xmaxValue, -ymaxValue, ymaxValue, nearClipPlane, farClipPlane);*/
 	tglFrustumf(1.5, -1.5, -0.625, 0.625, nearClipPlane, farClipPlane);
+	_projectionMatrix = Math::makeFrustumMatrix(1.5, -1.5, -0.625, 0.625, nearClipPlane, farClipPlane);
 	tglMatrixMode(TGL_MODELVIEW);
 	tglLoadIdentity();
 }
@@ -119,6 +120,12 @@ void TinyGLRenderer::positionCamera(const Math::Vector3d &pos, const Math::Vecto
 	Math::Matrix4 lookMatrix = Math::makeLookAtMatrix(pos, interest, up_vec);
 	tglMultMatrixf(lookMatrix.getData());
 	tglTranslatef(-pos.x(), -pos.y(), -pos.z());
+
+	Math::Matrix4 viewMatrix;
+	viewMatrix.translate(-pos);
+	viewMatrix.transpose();
+	_modelViewMatrix = viewMatrix * lookMatrix;
+	updateFrustum();
 }
 
 void TinyGLRenderer::renderSensorShoot(byte color, const Math::Vector3d sensor, const Math::Vector3d player, const Common::Rect viewArea) {
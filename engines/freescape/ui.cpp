@@ -335,6 +335,9 @@ void FreescapeEngine::drawUI() {
 	else if (isAmiga() || isAtariST())
 		drawAmigaAtariSTUI(surface);
 
+	if (_showFps && _currentArea)
+		drawRenderStats(surface);
+
 	drawFullscreenSurface(surface);
 
 	_gfx->setViewport(_fullscreenViewArea);
@@ -344,6 +347,17 @@ void FreescapeEngine::drawUI() {
 	delete surface;
 }
 
+void FreescapeEngine::drawRenderStats(Graphics::Surface *surface) {
+	uint32 white = _gfx->_texturePixelFormat.ARGBToColor(0xFF, 0xFF, 0xFF, 0xFF);
+	uint32 black = _gfx->_texturePixelFormat.ARGBToColor(0xFF, 0x00, 0x00, 0x00);
+
+	// Drawn over the top left corner of the view
+	int x = _viewArea.left;
+	int y = _viewArea.top;
+	drawStringInSurface(Common::String::format("FPS %d", _fps), x, y, white, black, surface);
+	drawStringInSurface(Common::String::format("DRAWN %d CULLED %d", _currentArea->_drawnObjects, _currentArea->_culledObjects), x, y + 8, white, black, surface);
+}
+
 void FreescapeEngine::drawInfoMenu() {
 	warning("Function \"%s\" not implemented", __FUNCTION__);
 }
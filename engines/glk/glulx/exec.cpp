@@ -28,7 +28,8 @@ void Glulx::execute_loop() {
 	bool done_executing = false;
 	int ix;
 	uint opcode;
-	const operandlist_t *oplist;
+	const decodedinst_t *dinst;
+	decodedinst_t scratchinst;
 	oparg_t inst[MAX_OPERANDS];
 	uint value, addr, val0, val1;
 	int vals0, vals1;
@@ -48,44 +49,13 @@ void Glulx::execute_loop() {
 		/* Stash the current opcode's address, in case the interpreter needs to serialize the VM state out-of-band. */
 		prevpc = pc;
 
-		/* Fetch the opcode number. */
-		opcode = Mem1(pc);
-		pc++;
-		if (opcode & 0x80) {
-			/* More than one-byte opcode. */
-			if (opcode & 0x40) {
-				/* Four-byte opcode */
-				opcode &= 0x3F;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-			} else {
-				/* Two-byte opcode */
-				opcode &= 0x7F;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-			}
-		}
-
-		/* Now we have an opcode number. */
-
-		/* Fetch the structure that describes how the operands for this
-		   opcode are arranged. This is a pointer to an immutable,
-		   static object. */
-		if (opcode < 0x80)
-			oplist = fast_operandlist[opcode];
-		else
-			oplist = lookup_operandlist(opcode);
-
-		if (!oplist)
-			fatal_error_i("Encountered unknown opcode.", opcode);
-
-		/* Based on the oplist structure, load the actual operand values
+		/* Fetch the decoded instruction, and load the actual operand values
 		   into inst. This moves the PC up to the end of the instruction. */
-		parse_operands(inst, oplist);
+		dinst = fetch_instruction(pc, &scratchinst);
+		opcode = dinst->opcode;
+		pc = dinst->nextpc;
+		load_operands(inst, dinst);
+		turn_opcount++;
 
 		/* Perform the opcode. This switch statement is split in two, based
 		   on some paranoid suspicions about the ability of compilers to
@@ -1051,5 +1021,16 @@ PerformJump: /* goto label for successful jumping... ironic, no? */
 #endif /* VM_DEBUGGER */
 }
 
+void Glulx::report_turn_stats() {
+	uint now = g_system->getMillis();
+
+	debugC(1, kDebugCore, "Glulx turn: %u ms, %u instructions executed, %u decoded",
+		now - turn_starttime, turn_opcount, turn_decodecount);
+
+	turn_starttime = now;
+	turn_opcount = 0;
+	turn_decodecount = 0;
+}
+
 } // End of namespace Glulx
 } // End of namespace Glk
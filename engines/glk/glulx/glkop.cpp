@@ -153,6 +153,7 @@ uint Glulx::perform_glk(uint funcnum, uint numargs, uint *arglist) {
 		/* call a library hook on every glk_select() */
 		if (library_select_hook)
 			library_select_hook(arglist[0]);
+		report_turn_stats();
 		/* but then fall through to full dispatcher, because there's no real
 		   need for speed here */
 		goto FullDispatcher;
@@ -233,6 +234,10 @@ FullDispatcher:
 	}
 	}
 
+	/* Don't count the time spent waiting for input */
+	if (funcnum == 0x00C0)
+		turn_starttime = g_system->getMillis();
+
 	return retval;
 }
 
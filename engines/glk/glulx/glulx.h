@@ -145,6 +145,18 @@ private:
 	 */
 	const operandlist_t *fast_operandlist[0x80];
 
+	/**
+	 * The decoded instructions in ROM, indexed by their address modulo DECODED_CACHE_SIZE.
+	 */
+	decodedinst_t *decoded_cache;
+
+	/**
+	 * Statistics reported on the core debug channel every time the VM blocks for input
+	 */
+	uint turn_starttime;
+	uint turn_opcount;
+	uint turn_decodecount;
+
 	/**@}*/
 
 	/**
@@ -543,13 +555,39 @@ public:
 	const operandlist_t *lookup_operandlist(uint opcode);
 
 	/**
-	 * Read the list of operands of an instruction, and put the values in args. This assumes
-	 * that the PC is at the beginning of the operand mode list (right after an opcode number.)
-	 * Upon return, the PC will be at the beginning of the next instruction.
+	 * Allocate the cache of decoded instructions. This is called just once, when the terp starts up.
+	 */
+	void init_decoded_cache();
+
+	void final_decoded_cache();
+
+	/**
+	 * Forget all the decoded instructions.
+	 */
+	void clear_decoded_cache();
+
+	/**
+	 * Return the decoded instruction at the given address. Instructions in ROM come from the cache
+	 * when they have been decoded before; any other instruction is decoded into the given scratch entry.
+	 */
+	const decodedinst_t *fetch_instruction(uint addr, decodedinst_t *scratch);
+
+	/**
+	 * Decode the opcode and the operand addressing modes of the instruction at the given address.
+	 */
+	void decode_instruction(decodedinst_t *dinst, uint addr);
+
+	/**
+	 * Fetch the operands of a decoded instruction, and put the values in args.
 	 *
-	 * This also assumes that args points at an allocated array of MAX_OPERANDS oparg_t structures.
+	 * This assumes that args points at an allocated array of MAX_OPERANDS oparg_t structures.
 	*/
-	void parse_operands(oparg_t *opargs, const operandlist_t *oplist);
+	void load_operands(oparg_t *opargs, const decodedinst_t *dinst);
+
+	/**
+	 * Log how long the VM ran since it last blocked for input.
+	 */
+	void report_turn_stats();
 
 	/**
 	 * Store a result value, according to the desttype and destaddress given. This is usually used to store
@@ -351,6 +351,35 @@ typedef oparg_struct oparg_t;
 
 #define MAX_OPERANDS (8)
 
+/**
+ * How an operand is fetched, once its addressing mode has been decoded.
+ */
+enum operandkind {
+	operandkind_Const = 0,  ///< Constant value
+	operandkind_Pop = 1,    ///< Popped off the stack
+	operandkind_Mem = 2,    ///< Loaded from main memory
+	operandkind_Local = 3,  ///< Loaded from the locals segment
+	operandkind_Store = 4   ///< Store operand, the destination is fully decoded
+};
+
+/**
+ * Represents an instruction whose opcode and addressing modes have already been decoded, so that
+ * executing it again only needs to fetch the operand values. Instructions in ROM are kept in a cache
+ * keyed by their address, as ROM can't be written to.
+ */
+struct decodedinst_struct {
+	uint addr;                      ///< Address of the instruction, or 0 if the entry is unused
+	uint nextpc;                    ///< Address of the following instruction
+	uint opcode;
+	const operandlist_t *oplist;
+	byte kinds[MAX_OPERANDS];       ///< operandkind of each operand
+	byte desttypes[MAX_OPERANDS];   ///< Destination type of each store operand
+	uint fields[MAX_OPERANDS];      ///< Constant value, address or locals offset of each operand
+};
+typedef decodedinst_struct decodedinst_t;
+
+#define DECODED_CACHE_SIZE (8192)
+
 typedef uint(Glulx::*acceleration_func)(uint argc, uint *argv);
 
 struct accelentry_struct {
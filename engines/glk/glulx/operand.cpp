@@ -279,22 +279,94 @@ const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
 	}
 }
 
-void Glulx::parse_operands(oparg_t *args, const operandlist_t *oplist) {
+void Glulx::init_decoded_cache() {
+	decoded_cache = (decodedinst_t *)glulx_malloc(DECODED_CACHE_SIZE * sizeof(decodedinst_t));
+	if (!decoded_cache)
+		fatal_error("Unable to allocate the instruction cache.");
+
+	clear_decoded_cache();
+}
+
+void Glulx::final_decoded_cache() {
+	if (decoded_cache) {
+		glulx_free(decoded_cache);
+		decoded_cache = nullptr;
+	}
+}
+
+void Glulx::clear_decoded_cache() {
+	for (int ix = 0; ix < DECODED_CACHE_SIZE; ix++)
+		decoded_cache[ix].addr = 0;
+}
+
+const decodedinst_t *Glulx::fetch_instruction(uint addr, decodedinst_t *scratch) {
+	/* Only instructions entirely in ROM are kept, as anything from ramstart
+	   up can be modified. Address zero is the header, never an instruction. */
+	if (addr < ramstart) {
+		decodedinst_t *dinst = &decoded_cache[addr & (DECODED_CACHE_SIZE - 1)];
+		if (dinst->addr != addr) {
+			decode_instruction(dinst, addr);
+			if (dinst->nextpc > ramstart)
+				dinst->addr = 0;
+		}
+		return dinst;
+	}
+
+	decode_instruction(scratch, addr);
+	return scratch;
+}
+
+void Glulx::decode_instruction(decodedinst_t *dinst, uint addr) {
+	uint instaddr = addr;
+	uint opcode;
+	const operandlist_t *oplist;
 	int ix;
-	oparg_t *curarg;
-	int numops = oplist->num_ops;
-	int argsize = oplist->arg_size;
-	uint modeaddr = pc;
+	int numops;
+	uint modeaddr;
 	int modeval = 0;
 
-	pc += (numops + 1) / 2;
+	turn_decodecount++;
+
+	/* Fetch the opcode number. */
+	opcode = Mem1(addr);
+	addr++;
+	if (opcode & 0x80) {
+		/* More than one-byte opcode. */
+		if (opcode & 0x40) {
+			/* Four-byte opcode */
+			opcode &= 0x3F;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+		} else {
+			/* Two-byte opcode */
+			opcode &= 0x7F;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+		}
+	}
 
-	for (ix = 0, curarg = args; ix < numops; ix++, curarg++) {
-		int mode;
-		uint value;
-		uint addr;
+	/* Fetch the structure that describes how the operands for this
+	   opcode are arranged. This is a pointer to an immutable,
+	   static object. */
+	if (opcode < 0x80)
+		oplist = fast_operandlist[opcode];
+	else
+		oplist = lookup_operandlist(opcode);
 
-		curarg->desttype = 0;
+	if (!oplist)
+		fatal_error_i("Encountered unknown opcode.", opcode);
+
+	numops = oplist->num_ops;
+	modeaddr = addr;
+	addr += (numops + 1) / 2;
+
+	for (ix = 0; ix < numops; ix++) {
+		int mode;
+		uint field;
 
 		if ((ix & 1) == 0) {
 			modeval = Mem1(modeaddr);
@@ -304,203 +376,122 @@ void Glulx::parse_operands(oparg_t *args, const operandlist_t *oplist) {
 			modeaddr++;
 		}
 
-		if (oplist->formlist[ix] == modeform_Load) {
+		/* Read the constant or address following the modes. */
+		switch (mode) {
+		case 1:
+			/* Sign-extend from 8 bits to 32 */
+			field = (int)(signed char)(Mem1(addr));
+			addr++;
+			break;
+
+		case 2:
+			/* Sign-extend the first byte from 8 bits to 32; the subsequent
+			   byte must not be sign-extended. */
+			field = (int)(signed char)(Mem1(addr));
+			field = (field << 8) | (uint)(Mem1(addr + 1));
+			addr += 2;
+			break;
+
+		case 5:
+		case 9:
+		case 13:
+			field = (uint)(Mem1(addr));
+			addr++;
+			break;
+
+		case 6:
+		case 10:
+		case 14:
+			field = (uint)Mem2(addr);
+			addr += 2;
+			break;
+
+		case 3:
+		case 7:
+		case 11:
+		case 15:
+			/* Bytes must not be sign-extended. */
+			field = Mem4(addr);
+			addr += 4;
+			break;
+
+		default:
+			field = 0;
+			break;
+		}
 
-			switch (mode) {
+		/* cases 13, 14, 15 are main memory RAM addresses. */
+		if (mode >= 13)
+			field += ramstart;
 
-			case 8: /* pop off stack */
-				if (stackptr < valstackbase + 4) {
-					fatal_error("Stack underflow in operand.");
-				}
-				stackptr -= 4;
-				value = Stk4(stackptr);
-				break;
+		dinst->fields[ix] = field;
+		dinst->desttypes[ix] = 0;
 
-			case 0: /* constant zero */
-				value = 0;
-				break;
+		if (oplist->formlist[ix] == modeform_Load) {
 
+			switch (mode) {
+			case 0: /* constant zero */
 			case 1: /* one-byte constant */
-				/* Sign-extend from 8 bits to 32 */
-				value = (int)(signed char)(Mem1(pc));
-				pc++;
-				break;
-
 			case 2: /* two-byte constant */
-				/* Sign-extend the first byte from 8 bits to 32; the subsequent
-				   byte must not be sign-extended. */
-				value = (int)(signed char)(Mem1(pc));
-				pc++;
-				value = (value << 8) | (uint)(Mem1(pc));
-				pc++;
+			case 3: /* four-byte constant */
+				dinst->kinds[ix] = operandkind_Const;
 				break;
 
-			case 3: /* four-byte constant */
-				/* Bytes must not be sign-extended. */
-				value = Mem4(pc);
-				pc += 4;
+			case 8: /* pop off stack */
+				dinst->kinds[ix] = operandkind_Pop;
 				break;
 
-			case 15: /* main memory RAM, four-byte address */
-				addr = Mem4(pc);
-				addr += ramstart;
-				pc += 4;
-				goto MainMemAddr;
-
-			case 14: /* main memory RAM, two-byte address */
-				addr = (uint)Mem2(pc);
-				addr += ramstart;
-				pc += 2;
-				goto MainMemAddr;
-
-			case 13: /* main memory RAM, one-byte address */
-				addr = (uint)(Mem1(pc));
-				addr += ramstart;
-				pc++;
-				goto MainMemAddr;
-
-			case 7: /* main memory, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto MainMemAddr;
-
-			case 6: /* main memory, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto MainMemAddr;
-
-			case 5: /* main memory, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-MainMemAddr:
-				/* cases 5, 6, 7, 13, 14, 15 all wind up here. */
-				if (argsize == 4) {
-					value = Mem4(addr);
-				} else if (argsize == 2) {
-					value = Mem2(addr);
-				} else {
-					value = Mem1(addr);
-				}
+			case 5: /* main memory */
+			case 6:
+			case 7:
+			case 13: /* main memory RAM */
+			case 14:
+			case 15:
+				dinst->kinds[ix] = operandkind_Mem;
 				break;
 
-			case 11: /* locals, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto LocalsAddr;
-
-			case 10: /* locals, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto LocalsAddr;
-
-			case 9: /* locals, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-LocalsAddr:
-				/* cases 9, 10, 11 all wind up here. It's illegal for addr to not
-				   be four-byte aligned, but we don't check this explicitly.
-				   A "strict mode" interpreter probably should. It's also illegal
-				   for addr to be less than zero or greater than the size of
-				   the locals segment. */
-				addr += localsbase;
-				if (argsize == 4) {
-					value = Stk4(addr);
-				} else if (argsize == 2) {
-					value = Stk2(addr);
-				} else {
-					value = Stk1(addr);
-				}
+			case 9: /* locals */
+			case 10:
+			case 11:
+				/* It's illegal for addr to not be four-byte aligned, but we don't
+				   check this explicitly. A "strict mode" interpreter probably should.
+				   It's also illegal for addr to be less than zero or greater than
+				   the size of the locals segment. */
+				dinst->kinds[ix] = operandkind_Local;
 				break;
 
 			default:
-				value = 0;
 				fatal_error("Unknown addressing mode in load operand.");
 			}
 
-			curarg->value = value;
-
 		} else { /* modeform_Store */
-			switch (mode) {
+			dinst->kinds[ix] = operandkind_Store;
 
+			switch (mode) {
 			case 0: /* discard value */
-				curarg->desttype = 0;
-				curarg->value = 0;
+				dinst->desttypes[ix] = 0;
 				break;
 
 			case 8: /* push on stack */
-				curarg->desttype = 3;
-				curarg->value = 0;
+				dinst->desttypes[ix] = 3;
 				break;
 
-			case 15: /* main memory RAM, four-byte address */
-				addr = Mem4(pc);
-				addr += ramstart;
-				pc += 4;
-				goto WrMainMemAddr;
-
-			case 14: /* main memory RAM, two-byte address */
-				addr = (uint)Mem2(pc);
-				addr += ramstart;
-				pc += 2;
-				goto WrMainMemAddr;
-
-			case 13: /* main memory RAM, one-byte address */
-				addr = (uint)(Mem1(pc));
-				addr += ramstart;
-				pc++;
-				goto WrMainMemAddr;
-
-			case 7: /* main memory, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto WrMainMemAddr;
-
-			case 6: /* main memory, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto WrMainMemAddr;
-
-			case 5: /* main memory, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-WrMainMemAddr:
-				/* cases 5, 6, 7 all wind up here. */
-				curarg->desttype = 1;
-				curarg->value = addr;
+			case 5: /* main memory */
+			case 6:
+			case 7:
+			case 13: /* main memory RAM */
+			case 14:
+			case 15:
+				dinst->desttypes[ix] = 1;
 				break;
 
-			case 11: /* locals, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto WrLocalsAddr;
-
-			case 10: /* locals, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto WrLocalsAddr;
-
-			case 9: /* locals, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-WrLocalsAddr:
-				/* cases 9, 10, 11 all wind up here. It's illegal for addr to not
-				   be four-byte aligned, but we don't check this explicitly.
-				   A "strict mode" interpreter probably should. It's also illegal
-				   for addr to be less than zero or greater than the size of
-				   the locals segment. */
-				curarg->desttype = 2;
+			case 9: /* locals */
+			case 10:
+			case 11:
 				/* We don't add localsbase here; the store address for desttype 2
 				   is relative to the current locals segment, not an absolute
 				   stack position. */
-				curarg->value = addr;
+				dinst->desttypes[ix] = 2;
 				break;
 
 			case 1:
@@ -514,6 +505,64 @@ WrLocalsAddr:
 			}
 		}
 	}
+
+	dinst->opcode = opcode;
+	dinst->oplist = oplist;
+	dinst->nextpc = addr;
+	dinst->addr = instaddr;
+}
+
+void Glulx::load_operands(oparg_t *args, const decodedinst_t *dinst) {
+	int ix;
+	oparg_t *curarg;
+	int numops = dinst->oplist->num_ops;
+	int argsize = dinst->oplist->arg_size;
+
+	for (ix = 0, curarg = args; ix < numops; ix++, curarg++) {
+		uint addr = dinst->fields[ix];
+
+		curarg->desttype = 0;
+
+		switch (dinst->kinds[ix]) {
+		case operandkind_Const:
+			curarg->value = addr;
+			break;
+
+		case operandkind_Pop:
+			if (stackptr < valstackbase + 4) {
+				fatal_error("Stack underflow in operand.");
+			}
+			stackptr -= 4;
+			curarg->value = Stk4(stackptr);
+			break;
+
+		case operandkind_Mem:
+			if (argsize == 4) {
+				curarg->value = Mem4(addr);
+			} else if (argsize == 2) {
+				curarg->value = Mem2(addr);
+			} else {
+				curarg->value = Mem1(addr);
+			}
+			break;
+
+		case operandkind_Local:
+			addr += localsbase;
+			if (argsize == 4) {
+				curarg->value = Stk4(addr);
+			} else if (argsize == 2) {
+				curarg->value = Stk2(addr);
+			} else {
+				curarg->value = Stk1(addr);
+			}
+			break;
+
+		default: /* operandkind_Store */
+			curarg->desttype = dinst->desttypes[ix];
+			curarg->value = addr;
+			break;
+		}
+	}
 }
 
 void Glulx::store_operand(uint desttype, uint destaddr, uint storeval) {
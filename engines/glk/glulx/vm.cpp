@@ -89,6 +89,7 @@ void Glulx::setup_vm() {
 
 	// Initialize various other things in the terp.
 	init_operands();
+	init_decoded_cache();
 	init_serial();
 
 	// Set up the initial machine state.
@@ -116,6 +117,7 @@ void Glulx::finalize_vm() {
 	}
 
 	final_serial();
+	final_decoded_cache();
 }
 
 void Glulx::vm_restart() {
@@ -127,6 +129,12 @@ void Glulx::vm_restart() {
 	/* Deactivate the heap (if it was active). */
 	heap_clear();
 
+	/* Start decoding the instructions afresh. */
+	clear_decoded_cache();
+	turn_starttime = g_system->getMillis();
+	turn_opcount = 0;
+	turn_decodecount = 0;
+
 	/* Reset memory to the original size. */
 	lx = change_memsize(origendmem, false);
 	if (lx)
@@ -132,6 +132,15 @@ public:
 	 * @returns         Width of string multiplied by GLI_SUBPIX
 	 */
 	size_t stringWidthUni(int fontIdx, const Common::U32String &text, int spw = 0);
+
+	/**
+	 * Get the advance in pixels of a single unicode character
+	 * @param fontIdx   Which font to use
+	 * @param prev      Preceding character for kerning, or 0 at the start of a string
+	 * @param ch        Character to get the advance of
+	 * @returns         Advance of the character multiplied by GLI_SUBPIX
+	 */
+	int charAdvanceUni(int fontIdx, uint32 prev, uint32 ch);
 };
 
 } // End of namespace Glk
@@ -36,15 +36,15 @@ namespace Glk {
 
 
 TextBufferWindow::TextBufferWindow(Windows *windows, uint rock) : TextWindow(windows, rock),
-		_font(g_conf->_propInfo), _historyPos(0), _historyFirst(0), _historyPresent(0),
-		_lastSeen(0), _scrollPos(0), _scrollMax(0), _scrollBack(SCROLLBACK), _width(-1), _height(-1),
+		_font(g_conf->_propInfo), _lineWidthsValid(0), _historyPos(0), _historyFirst(0), _historyPresent(0),
+		_lastSeen(0), _scrollPos(0), _scrollMax(0), _lines(SCROLLBACK), _scrollBack(SCROLLBACK), _width(-1), _height(-1),
 		_inBuf(nullptr), _lineTerminators(nullptr), _echoLineInput(true), _ladjw(0), _radjw(0),
 		_ladjn(0), _radjn(0), _numChars(0), _chars(nullptr), _attrs(nullptr), _spaced(0), _dashed(0),
 		_copyBuf(nullptr), _copyPos(0) {
 	_type = wintype_TextBuffer;
 	_history.resize(HISTORYLEN);
 
-	_lines.resize(SCROLLBACK);
+	_lineWidths[0] = 0;
 	_chars = _lines[0]._chars;
 	_attrs = _lines[0]._attrs;
 
@@ -67,7 +67,7 @@ TextBufferWindow::~TextBufferWindow() {
 	delete[] _copyBuf;
 	delete[] _lineTerminators;
 
-	for (int i = 0; i < _scrollBack; i++) {
+	for (int i = 0; i <= _scrollMax; i++) {
 		if (_lines[i]._lPic)
 			_lines[i]._lPic->decrement();
 		if (_lines[i]._rPic)
@@ -129,14 +129,18 @@ void TextBufferWindow::reflow() {
 		return;
 
 	_lines[0]._len = _numChars;
+	s = _scrollMax;
 
-	// allocate temp buffers
-	Attributes *attrbuf = new Attributes[SCROLLBACK * TBLINELEN];
-	uint32 *charbuf = new uint32[SCROLLBACK * TBLINELEN];
-	int *alignbuf = new int[SCROLLBACK];
-	Picture **pictbuf = new Picture *[SCROLLBACK];
-	uint *hyperbuf = new uint[SCROLLBACK];
-	int *offsetbuf = new int[SCROLLBACK];
+	// allocate temp buffers, big enough for the text and pictures in use
+	for (k = s, p = 0; k >= 0; k--)
+		p += _lines[k]._len + 1;
+
+	Attributes *attrbuf = new Attributes[p];
+	uint32 *charbuf = new uint32[p];
+	int *alignbuf = new int[2 * (s + 1)];
+	Picture **pictbuf = new Picture *[2 * (s + 1)];
+	uint *hyperbuf = new uint[2 * (s + 1)];
+	int *offsetbuf = new int[2 * (s + 1) + 1];
 
 	if (!attrbuf || !charbuf || !alignbuf || !pictbuf || !hyperbuf || !offsetbuf) {
 		delete[] attrbuf;
@@ -155,7 +159,6 @@ void TextBufferWindow::reflow() {
 
 	x = 0;
 	p = 0;
-	s = _scrollMax < SCROLLBACK ? _scrollMax : SCROLLBACK - 1;
 
 	for (k = s; k >= 0; k--) {
 		if (k == 0 && _lineRequest)
@@ -240,7 +243,8 @@ void TextBufferWindow::touchScroll() {
 	g_vm->_selection->clearSelection();
 	_windows->repaint(_bbox);
 
-	for (int i = 0; i < _scrollMax; i++)
+	// Only the visible lines get redrawn, so only they need to be touched
+	for (int i = _scrollPos; i < _scrollPos + _height && i < _lines.size(); i++)
 		_lines[i]._dirty = true;
 }
 
@@ -309,6 +313,8 @@ void TextBufferWindow::putText(const char *buf, int len, int pos, int oldlen) {
 	if (_numChars + diff >= TBLINELEN)
 		return;
 
+	invalidateLineWidth(pos);
+
 	if (diff != 0 && pos + oldlen < _numChars) {
 		memmove(_chars + pos + len,
 				_chars + pos + oldlen,
@@ -341,6 +347,8 @@ void TextBufferWindow::putTextUni(const uint32 *buf, int len, int pos, int oldle
 	if (_numChars + diff >= TBLINELEN)
 		return;
 
+	invalidateLineWidth(pos);
+
 	if (diff != 0 && pos + oldlen < _numChars) {
 		memmove(_chars + pos + len,
 				_chars + pos + oldlen,
@@ -478,6 +486,7 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 		}
 	}
 
+	invalidateLineWidth(_numChars);
 	_chars[_numChars] = ch;
 	_attrs[_numChars] = _attr;
 	_numChars++;
@@ -489,7 +498,7 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 			&& !_styles[_attrs[linelen - 1].style].reverse)
 		linelen--;
 
-	if (calcWidth(_chars, _attrs, 0, linelen, -1) >= pw) {
+	if (lineWidth(linelen) >= pw) {
 		bpoint = _numChars;
 
 		for (i = _numChars - 1; i > 0; i--) {
@@ -541,8 +550,9 @@ void TextBufferWindow::clear() {
 	_dashed = 0;
 
 	_numChars = 0;
+	_lineWidthsValid = 0;
 
-	for (i = 0; i < _scrollBack; i++) {
+	for (i = 0; i <= _scrollMax; i++) {
 		_lines[i]._len = 0;
 
 		if (_lines[i]._lPic) _lines[i]._lPic->decrement();
@@ -625,7 +635,7 @@ void TextBufferWindow::requestLineEvent(char *buf, uint maxlen, uint initlen) {
 	// make sure we have some space left for typing...
 	pw = (_bbox.right - _bbox.left - g_conf->_tMarginX * 2) * GLI_SUBPIX;
 	pw = pw - 2 * SLOP - _radjw + _ladjw;
-	if (calcWidth(_chars, _attrs, 0, _numChars, -1) >= pw * 3 / 4)
+	if (lineWidth(_numChars) >= pw * 3 / 4)
 		putCharUni('\n');
 
 	_inBuf = buf;
@@ -683,7 +693,7 @@ void TextBufferWindow::requestLineEventUni(uint32 *buf, uint maxlen, uint initle
 	// make sure we have some space left for typing...
 	pw = (_bbox.right - _bbox.left - g_conf->_tMarginX * 2) * GLI_SUBPIX;
 	pw = pw - 2 * SLOP - _radjw + _ladjw;
-	if (calcWidth(_chars, _attrs, 0, _numChars, -1) >= pw * 3 / 4)
+	if (lineWidth(_numChars) >= pw * 3 / 4)
 		putCharUni('\n');
 
 	//_lastSeen = 0;
@@ -819,6 +829,7 @@ void TextBufferWindow::redraw() {
 	int selrow, selchar, sx0, sx1, selleft, selright;
 	bool selBuf;
 	int tx, tsc, tsw, lsc, rsc;
+	TextBufferRow selln;
 	Screen &screen = *g_vm->_screen;
 
 	gli_tts_flush();
@@ -856,7 +867,8 @@ void TextBufferWindow::redraw() {
 		if (selrow)
 			_lines[i]._dirty = true;
 
-		TextBufferRow ln(_lines[i]);
+		// selected characters get highlighted in a copy of the line
+		TextBufferRow &ln = selrow ? (selln = _lines[i]) : _lines[i];
 
 		// skip if we can
 		if (!ln._dirty && !ln._repaint && !Windows::_forceRedraw && _scrollPos == 0)
@@ -1021,7 +1033,7 @@ void TextBufferWindow::redraw() {
 		 */
 
 		if (_windows->getFocusWindow() == this && i == 0 && (_lineRequest || _lineRequestUni)) {
-			w = calcWidth(_chars, _attrs, 0, _inCurs, spw);
+			w = lineWidth(_inCurs);
 			if (w < pw - _font._caretShape * 2 * GLI_SUBPIX)
 				_font.drawCaret(Point(x0 + SLOP + ln._lm + w, y + _font._baseLine));
 		}
@@ -1086,8 +1098,8 @@ void TextBufferWindow::redraw() {
 	/*
 	 * draw the images
 	 */
-	for (i = 0; i < _scrollBack; i++) {
-		TextBufferRow ln(_lines[i]);
+	for (i = 0; i <= _scrollMax; i++) {
+		const TextBufferRow &ln = _lines[i];
 
 		y = y0 + (_height - (i - _scrollPos) - 1) * _font._leading;
 
@@ -1530,9 +1542,11 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	_lastSeen++;
 	_scrollMax++;
 
-	if (_scrollMax > _scrollBack - 1
-			|| _lastSeen > _scrollBack - 1)
-		scrollResize();
+	// the oldest line is dropped once the scrollback is full
+	if (_scrollMax > _scrollBack - 1)
+		_scrollMax = _scrollBack - 1;
+	if (_lastSeen > _scrollBack - 1)
+		_lastSeen = _scrollBack - 1;
 
 	if (_lastSeen >= _height)
 		_scrollPos++;
@@ -1549,11 +1563,10 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	_lines[0]._len = _numChars;
 	_lines[0]._newLine = forced;
 
-	for (int i = _scrollBack - 1; i > 0; i--) {
-		memcpy(&_lines[i], &_lines[i - 1], sizeof(TextBufferRow));
-		if (i < _height)
-			touch(i);
-	}
+	_lines.scroll();
+	_chars = _lines[0]._chars;
+	_attrs = _lines[0]._attrs;
+	_lineWidthsValid = 0;
 
 	if (_radjn)
 		_radjn--;
@@ -1565,6 +1578,11 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 		_ladjw = 0;
 
 	touch(0);
+	if (_lines[0]._lPic)
+		_lines[0]._lPic->decrement();
+	if (_lines[0]._rPic)
+		_lines[0]._rPic->decrement();
+
 	_lines[0]._len = 0;
 	_lines[0]._newLine = 0;
 	_lines[0]._lm = _ladjw;
@@ -1585,33 +1603,6 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 
 }
 
-void TextBufferWindow::scrollResize() {
-	int i;
-
-	_lines.clear();
-	_lines.resize(_scrollBack + SCROLLBACK);
-
-	_chars = _lines[0]._chars;
-	_attrs = _lines[0]._attrs;
-
-	for (i = _scrollBack; i < (_scrollBack + SCROLLBACK); i++) {
-		_lines[i]._dirty = false;
-		_lines[i]._repaint = false;
-		_lines[i]._lm = 0;
-		_lines[i]._rm = 0;
-		_lines[i]._lPic = nullptr;
-		_lines[i]._rPic = nullptr;
-		_lines[i]._lHyper = 0;
-		_lines[i]._rHyper = 0;
-		_lines[i]._len = 0;
-		_lines[i]._newLine = 0;
-		*(_lines[i]._chars) = 0;
-		_lines[i]._attrs->clear();
-	}
-
-	_scrollBack += SCROLLBACK;
-}
-
 int TextBufferWindow::calcWidth(const uint32 *chars, const Attributes *attrs, int startchar, int numChars, int spw) {
 	Screen &screen = *g_vm->_screen;
 	int w = 0;
@@ -1631,6 +1622,20 @@ int TextBufferWindow::calcWidth(const uint32 *chars, const Attributes *attrs, in
 	return w;
 }
 
+int TextBufferWindow::lineWidth(int numChars) {
+	Screen &screen = *g_vm->_screen;
+
+	for (; _lineWidthsValid < numChars; _lineWidthsValid++) {
+		int i = _lineWidthsValid;
+
+		// kerning doesn't apply across a change of attributes
+		uint32 prev = (i > 0 && _attrs[i - 1] == _attrs[i]) ? _chars[i - 1] : 0;
+		_lineWidths[i + 1] = _lineWidths[i] + screen.charAdvanceUni(_attrs[i].attrFont(_styles), prev, _chars[i]);
+	}
+
+	return _lineWidths[numChars];
+}
+
 void TextBufferWindow::getSize(uint *width, uint *height) const {
 	if (width)
 		*width = (_bbox.width() - g_conf->_tMarginX * 2) / _font._cellW;
@@ -1651,4 +1656,26 @@ TextBufferWindow::TextBufferRow::TextBufferRow() : _len(0), _newLine(0), _dirty(
 	Common::fill(&_chars[0], &_chars[TBLINELEN], 0);
 }
 
+/*--------------------------------------------------------------------------*/
+
+TextBufferWindow::TextBufferRows::TextBufferRows(int size) : _size(size), _head(0) {
+	_pages.resize((size + SCROLLBACK_PAGE - 1) / SCROLLBACK_PAGE);
+	Common::fill(_pages.begin(), _pages.end(), (TextBufferRow *)nullptr);
+}
+
+TextBufferWindow::TextBufferRows::~TextBufferRows() {
+	for (uint i = 0; i < _pages.size(); i++)
+		delete[] _pages[i];
+}
+
+TextBufferWindow::TextBufferRow &TextBufferWindow::TextBufferRows::operator[](int idx) {
+	int pos = (_head + idx) % _size;
+	TextBufferRow *&page = _pages[pos / SCROLLBACK_PAGE];
+
+	if (!page)
+		page = new TextBufferRow[SCROLLBACK_PAGE];
+
+	return page[pos % SCROLLBACK_PAGE];
+}
+
 } // End of namespace Glk
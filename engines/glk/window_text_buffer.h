@@ -52,9 +52,52 @@ class TextBufferWindow : public TextWindow, Speech {
 		 */
 		TextBufferRow();
 	};
-	typedef Common::Array<TextBufferRow> TextBufferRows;
+
+	/**
+	 * Scrollback store. Rows are kept in a ring so that scrolling in a new
+	 * line doesn't move any of the others, and are allocated in pages as
+	 * they're first used, up to a fixed number of rows. Row 0 is always
+	 * the bottom line of the window.
+	 */
+	class TextBufferRows {
+	private:
+		Common::Array<TextBufferRow *> _pages;
+		int _size;
+		int _head;
+	public:
+		/**
+		 * Constructor
+		 */
+		TextBufferRows(int size);
+
+		/**
+		 * Destructor
+		 */
+		~TextBufferRows();
+
+		/**
+		 * Returns the number of rows
+		 */
+		int size() const { return _size; }
+
+		/**
+		 * Returns a row, counting upwards from the bottom line
+		 */
+		TextBufferRow &operator[](int idx);
+
+		/**
+		 * Moves all rows up by one. The new bottom line is the former top
+		 * row, which the caller has to reset
+		 */
+		void scroll() {
+			_head = (_head == 0) ? _size - 1 : _head - 1;
+		}
+	};
 private:
 	PropFontInfo &_font;
+
+	int _lineWidths[TBLINELEN + 1];  ///< widths of the bottom line up to each character
+	int _lineWidthsValid;            ///< number of characters _lineWidths is valid for
 private:
 	void reflow();
 	void touchScroll();
@@ -89,8 +132,20 @@ private:
 	void touch(int line);
 
 	void scrollOneLine(bool forced);
-	void scrollResize();
 	int calcWidth(const uint32 *chars, const Attributes *attrs, int startchar, int numchars, int spw);
+
+	/**
+	 * Returns the width of the first characters of the bottom line. Widths
+	 * are cached, so only characters added since the last call are measured
+	 */
+	int lineWidth(int numChars);
+
+	/**
+	 * Flags the bottom line widths from a given character onwards as out of date
+	 */
+	void invalidateLineWidth(int pos) {
+		_lineWidthsValid = MIN(_lineWidthsValid, pos);
+	}
 public:
 	int _width, _height;
 	int _spaced;
@@ -39,7 +39,8 @@ class Window;
 class PairWindow;
 
 #define HISTORYLEN 100
-#define SCROLLBACK 512
+#define SCROLLBACK 2048
+#define SCROLLBACK_PAGE 64
 #define TBLINELEN 300
 #define GLI_SUBPIX 8
 
@@ -29,7 +29,8 @@ namespace ZCode {
 
 Mem::Mem() : story_fp(nullptr), story_size(0), first_undo(nullptr), last_undo(nullptr),
 		curr_undo(nullptr), undo_mem(nullptr), zmp(nullptr), pcp(nullptr), prev_zmp(nullptr),
-		undo_diff(nullptr), undo_count(0), reserve_mem(0) {
+		undo_diff(nullptr), undo_count(0), reserve_mem(0), _propertyCacheLow(0xffff),
+		_propertyCacheHigh(0), _propertyCacheStale(false) {
 }
 
 void Mem::initialize() {
@@ -201,6 +202,9 @@ void Mem::storeb(zword addr, zbyte value) {
 		flagsChanged(value);
 	}
 
+	if (addr >= _propertyCacheLow && addr < _propertyCacheHigh)
+		_propertyCacheStale = true;
+
 	SET_BYTE(addr, value);
 }
 
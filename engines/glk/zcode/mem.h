@@ -66,6 +66,11 @@ protected:
 	zbyte *undo_mem, *prev_zmp, *undo_diff;
 	int undo_count;
 	int reserve_mem;
+
+	// Address range [low, high) read by cached property lookups, and whether
+	// storeb() has written into it since, see Processor::find_property()
+	uint _propertyCacheLow, _propertyCacheHigh;
+	bool _propertyCacheStale;
 private:
 	/**
 	 * Handles setting the story file, parsing it if it's a Blorb file
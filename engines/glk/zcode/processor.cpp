@@ -138,7 +138,8 @@ Processor::Processor(OSystem *syst, const GlkGameDescription &gameDesc) :
 		_randomInterval(0), _randomCtr(0), first_restart(true), script_valid(false),
 		_bufPos(0), _locked(false), _prevC('\0'), script_width(0),
 		sfp(nullptr), rfp(nullptr), pfp(nullptr), ostream_screen(true), ostream_script(false),
-		ostream_memory(false), ostream_record(false), istream_replay(false), message(false) {
+		ostream_memory(false), ostream_record(false), istream_replay(false), message(false),
+		_turnStartTime(0), _turnOpcount(0) {
 	static const Opcode OP0_OPCODES[16] = {
 		&Processor::z_rtrue,
 		&Processor::z_rfalse,
@@ -184,6 +185,8 @@ Processor::Processor(OSystem *syst, const GlkGameDescription &gameDesc) :
 	Common::fill(&zargs[0], &zargs[8], 0);
 	Common::fill(&_buffer[0], &_buffer[TEXT_BUFFER_SIZE], '\0');
 	Common::fill(&_errorCount[0], &_errorCount[ERR_NUM_ERRORS], 0);
+	Common::fill(&_opcodes[0], &_opcodes[256], (Opcode)nullptr);
+	clear_property_cache();
 }
 
 void Processor::initialize() {
@@ -197,38 +200,18 @@ void Processor::initialize() {
 		op0_opcodes[9] = &Processor::z_catch;
 		op1_opcodes[15] = &Processor::z_call_n;
 	}
-}
-
-void Processor::load_operand(zbyte type) {
-	zword value;
-
-	if (type & 2) {
-		// variable
-		zbyte variable;
-
-		CODE_BYTE(variable);
-
-		if (variable == 0)
-			value = *_sp++;
-		else if (variable < 16)
-			value = *(_fp - variable);
-		else {
-			zword addr = h_globals + 2 * (variable - 16);
-			LOW_WORD(addr, value);
-		}
-	} else if (type & 1) {
-		// small constant
-		zbyte bvalue;
-
-		CODE_BYTE(bvalue);
-		value = bvalue;
-
-	} else {
-		// large constant
-		CODE_WORD(value);
-	}
 
-	zargs[zargc++] = value;
+	// Map every opcode byte straight to its handler
+	for (int i = 0; i < 0x80; i++)
+		_opcodes[i] = var_opcodes[i & 0x1f];
+	for (int i = 0x80; i < 0xb0; i++)
+		_opcodes[i] = op1_opcodes[i & 0x0f];
+	for (int i = 0xb0; i < 0xc0; i++)
+		_opcodes[i] = op0_opcodes[i - 0xb0];
+	for (int i = 0xc0; i < 0x100; i++)
+		_opcodes[i] = var_opcodes[i - 0xc0];
+
+	_turnStartTime = g_system->getMillis();
 }
 
 void Processor::load_all_operands(zbyte specifier) {
@@ -246,31 +229,29 @@ void Processor::interpret() {
 	do {
 		zbyte opcode;
 		CODE_BYTE(opcode);
-		zargc = 0;
 
 		if (opcode < 0x80) {
-			// 2OP opcodes
-			load_operand((zbyte)(opcode & 0x40) ? 2 : 1);
-			load_operand((zbyte)(opcode & 0x20) ? 2 : 1);
-
-			(*this.*var_opcodes[opcode & 0x1f])();
+			// 2OP opcodes, whose operands are small constants or variables
+			zargs[0] = read_operand((opcode & 0x40) ? 2 : 1);
+			zargs[1] = read_operand((opcode & 0x20) ? 2 : 1);
+			zargc = 2;
 
 		} else if (opcode < 0xb0) {
 			// 1OP opcodes
-			load_operand((zbyte)(opcode >> 4));
-
-			(*this.*op1_opcodes[opcode & 0x0f])();
+			zargs[0] = read_operand((zbyte)(opcode >> 4));
+			zargc = 1;
 
 		} else if (opcode < 0xc0) {
 			// 0OP opcodes
-			(*this.*op0_opcodes[opcode - 0xb0])();
-
+			zargc = 0;
 
 		} else {
 			// VAR opcodes
 			zbyte specifier1;
 			zbyte specifier2;
 
+			zargc = 0;
+
 			if (opcode == 0xec || opcode == 0xfa) {	// opcodes 0xec
 				CODE_BYTE(specifier1);			// and 0xfa are
 				CODE_BYTE(specifier2);          // call opcodes
@@ -280,10 +261,11 @@ void Processor::interpret() {
 				CODE_BYTE(specifier1);
 				load_all_operands(specifier1);
 			}
-
-			(*this.*var_opcodes[opcode - 0xc0])();
 		}
 
+		(*this.*_opcodes[opcode])();
+		_turnOpcount++;
+
 #if defined(DJGPP) && defined(SOUND_SUPPORT)
 		if (end_of_sound_flag)
 			end_of_sound();
@@ -293,6 +275,16 @@ void Processor::interpret() {
 	_finished--;
 }
 
+void Processor::report_turn_stats() {
+	uint32 now = g_system->getMillis();
+	uint32 time = MAX<uint32>(now - _turnStartTime, 1);
+
+	debugC(1, kDebugCore, "Z-machine turn: %u instructions in %u ms, %u instructions/s",
+		_turnOpcount, time, (uint32)((uint64)_turnOpcount * 1000 / time));
+
+	_turnOpcount = 0;
+}
+
 void Processor::call(zword routine, int argc, zword *args, int ct) {
 	uint32 pc;
 	zword value;
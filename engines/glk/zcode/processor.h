@@ -31,6 +31,7 @@ namespace Glk {
 namespace ZCode {
 
 #define TEXT_BUFFER_SIZE 200
+#define PROPERTY_CACHE_SIZE 256
 
 #define CODE_BYTE(v)	   v = codeByte()
 #define CODE_WORD(v)       v = codeWord()
@@ -57,6 +58,7 @@ private:
 	static Opcode ext_opcodes[64];
 	Common::Array<Opcode> op0_opcodes;
 	Common::Array<Opcode> op1_opcodes;
+	Opcode _opcodes[256];
 
 	int _finished;
 	zword zargs[8];
@@ -94,16 +96,54 @@ private:
 	bool istream_replay;
 	bool message;
 	Common::FixedStack<Redirect, MAX_NESTING> _redirect;
+
+	// Object related fields
+	struct PropertyCacheEntry {
+		zword _obj;
+		zword _prop;
+		zword _table;	///< Property table address of the object when cached
+		zword _addr;	///< Address where the scan of the property list stopped
+	};
+	PropertyCacheEntry _propertyCache[PROPERTY_CACHE_SIZE];
+
+	// Statistics reported on the core debug channel every time input is read
+	uint32 _turnStartTime;
+	uint32 _turnOpcount;
 protected:
 	/**
 	 * \defgroup General support methods
 	 * @{
 	 */
 
+	/**
+	 * Read an operand, either a variable or a constant.
+	 */
+	inline zword read_operand(zbyte type) {
+		if (type & 2) {
+			// variable
+			zbyte variable = codeByte();
+
+			if (variable == 0)
+				return *_sp++;
+			else if (variable < 16)
+				return *(_fp - variable);
+			else
+				return READ_BE_UINT16(&zmp[h_globals + 2 * (variable - 16)]);
+		} else if (type & 1) {
+			// small constant
+			return codeByte();
+		}
+
+		// large constant
+		return codeWord();
+	}
+
 	/**
 	 * Load an operand, either a variable or a constant.
 	 */
-	void load_operand(zbyte type);
+	void load_operand(zbyte type) {
+		zargs[zargc++] = read_operand(type);
+	}
 
 	/**
 	 * Given the operand specifier byte, load all (up to four) operands
@@ -279,6 +319,11 @@ protected:
 	 */
 	void memory_word(const zchar *s);
 
+	/**
+	 * Log how many instructions were executed since input was last read.
+	 */
+	void report_turn_stats();
+
 	/**@}*/
 
 	/**
@@ -306,6 +351,19 @@ protected:
 	 */
 	zword next_property(zword prop_addr);
 
+	/**
+	 * Scan the property list of an object for a property, and return the address
+	 * of the size byte where the scan stopped. That is the property itself if the
+	 * object has it. Lookups are cached until storeb() writes over a scanned list.
+	 */
+	zword find_property(zword obj, zword prop);
+
+	/**
+	 * Forget the cached property lookups, after the memory has been reloaded
+	 * or written without storeb().
+	 */
+	void clear_property_cache();
+
 	/**
 	 * Unlink an object from its parent and siblings.
 	 */
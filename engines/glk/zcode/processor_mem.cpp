@@ -113,6 +113,7 @@ int Processor::restore_undo(void) {
 	curr_undo = curr_undo->prev;
 
 	restart_header();
+	clear_property_cache();
 
 	return 2;
 }
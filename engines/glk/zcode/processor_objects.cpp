@@ -115,6 +115,61 @@ zword Processor::next_property(zword prop_addr) {
 	return prop_addr + value + 1;
 }
 
+zword Processor::find_property(zword obj, zword prop) {
+	zword table;
+	zword prop_addr;
+	zbyte size;
+	zbyte value;
+	zbyte mask;
+
+	// Something was written over the cached property lists
+	if (_propertyCacheStale)
+		clear_property_cache();
+
+	// Fetch address of object name, the start of its property table
+	table = object_name(obj);
+
+	PropertyCacheEntry &entry = _propertyCache[(obj * 7 + prop) & (PROPERTY_CACHE_SIZE - 1)];
+	if (entry._obj == obj && entry._prop == prop && entry._table == table)
+		return entry._addr;
+
+	// Property id is in bottom five (six) bits
+	mask = (h_version <= V3) ? 0x1f : 0x3f;
+
+	// Load address of first property
+	LOW_BYTE(table, size);
+	prop_addr = table + 1 + 2 * size;
+
+	// Scan down the property list
+	for (;;) {
+		LOW_BYTE(prop_addr, value);
+		if ((value & mask) <= prop)
+			break;
+		prop_addr = next_property(prop_addr);
+	}
+
+	entry._obj = obj;
+	entry._prop = prop;
+	entry._table = table;
+	entry._addr = prop_addr;
+
+	// Writes from the table up to the size bytes of the last property
+	// scanned make the cache stale, see Mem::storeb()
+	_propertyCacheLow = MIN<uint>(_propertyCacheLow, table);
+	_propertyCacheHigh = MAX<uint>(_propertyCacheHigh, prop_addr + 2);
+
+	return prop_addr;
+}
+
+void Processor::clear_property_cache() {
+	for (int i = 0; i < PROPERTY_CACHE_SIZE; i++)
+		_propertyCache[i]._obj = 0;
+
+	_propertyCacheLow = 0xffff;
+	_propertyCacheHigh = 0;
+	_propertyCacheStale = false;
+}
+
 void Processor::unlink_object(zword object) {
 	zword obj_addr;
 	zword parent_addr;
@@ -407,16 +462,9 @@ void Processor::z_get_prop() {
 	// Property id is in bottom five (six) bits
 	mask = (h_version <= V3) ? 0x1f : 0x3f;
 
-	// Load address of first property
-	prop_addr = first_property(zargs[0]);
-
-	// Scan down the property list
-	for (;;) {
-		LOW_BYTE(prop_addr, value);
-		if ((value & mask) <= zargs[1])
-			break;
-		prop_addr = next_property(prop_addr);
-	}
+	// Find the property, or where the scan of the property list stopped
+	prop_addr = find_property(zargs[0], zargs[1]);
+	LOW_BYTE(prop_addr, value);
 
 	if ((value & mask) == zargs[1]) {
 		// property found
@@ -460,16 +508,9 @@ void Processor::z_get_prop_addr() {
 	// Property id is in bottom five (six) bits
 	mask = (h_version <= V3) ? 0x1f : 0x3f;
 
-	// Load address of first property
-	prop_addr = first_property(zargs[0]);
-
-	// Scan down the property list
-	for (;;) {
-		LOW_BYTE(prop_addr, value);
-		if ((value & mask) <= zargs[1])
-			break;
-		prop_addr = next_property(prop_addr);
-	}
+	// Find the property, or where the scan of the property list stopped
+	prop_addr = find_property(zargs[0], zargs[1]);
+	LOW_BYTE(prop_addr, value);
 
 	// Calculate the property address or return zero
 	if ((value & mask) == zargs[1]) {
@@ -614,22 +655,19 @@ void Processor::z_put_prop() {
 	// Property id is in bottom five or six bits
 	mask = (h_version <= V3) ? 0x1f : 0x3f;
 
-	// Load address of first property
-	prop_addr = first_property(zargs[0]);
-
-	// Scan down the property list
-	for (;;) {
-		LOW_BYTE(prop_addr, value);
-		if ((value & mask) <= zargs[1])
-			break;
-
-		prop_addr = next_property(prop_addr);
-	}
+	// Find the property, or where the scan of the property list stopped
+	prop_addr = find_property(zargs[0], zargs[1]);
+	LOW_BYTE(prop_addr, value);
 
 	// Exit if the property does not exist
-	if ((value & mask) != zargs[1])
+	if ((value & mask) != zargs[1]) {
 		runtimeError(ERR_NO_PROP);
 
+		// When errors are ignored, the value is written where the scan
+		// stopped, which may be past the end of the property list
+		clear_property_cache();
+	}
+
 	// Store the new property value (byte or word sized)
 	prop_addr++;
 
@@ -135,6 +135,7 @@ zchar Processor::stream_read_key(zword timeout, zword routine, bool hot_keys) {
 	zchar key = ZC_BAD;
 
 	flush_buffer();
+	report_turn_stats();
 
 	// Read key from current input stream
 continue_input:
@@ -148,6 +149,9 @@ continue_input:
 			return ZC_BAD;
 	} while (key == ZC_BAD);
 
+	// Don't count the time spent waiting for input
+	_turnStartTime = g_system->getMillis();
+
 	// Copy key to the command file
 	if (ostream_record && !istream_replay)
 		record_write_key(key);
@@ -165,6 +169,7 @@ zchar Processor::stream_read_input(int max, zchar *buf, zword timeout, zword rou
 			  bool hot_keys, bool no_scripting) {
 	zchar key = ZC_BAD;
 	flush_buffer();
+	report_turn_stats();
 
 	// Remove initial input from the transscript file or from the screen
 	if (ostream_script && enable_scripting && !no_scripting)
@@ -182,6 +187,9 @@ continue_input:
 			return ZC_BAD;
 	} while (key == ZC_BAD);
 
+	// Don't count the time spent waiting for input
+	_turnStartTime = g_system->getMillis();
+
 	// Copy input line to the command file
 	if (ostream_record && !istream_replay)
 		record_write_input(buf, key);
@@ -541,6 +549,7 @@ void Processor::z_restart() {
 
 	restart_header();
 	restart_screen();
+	clear_property_cache();
 
 	_sp = _fp = _stack + STACK_SIZE;
 	_frameCount = 0;
@@ -593,6 +602,7 @@ void Processor::z_restore() {
 			strid_t f = glk_stream_open_file(ref, filemode_Read);
 
 			glk_get_buffer_stream(f, (char *)zmp + zargs[0], zargs[1]);
+			clear_property_cache();
 
 			glk_stream_close(f);
 			success = true;
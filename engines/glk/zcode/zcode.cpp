@@ -113,6 +113,7 @@ Common::Error ZCode::loadGameState(int slot) {
 
 		// Reload cached header fields
 		restart_header();
+		clear_property_cache();
 
 		/* Since QUETZAL files may be saved on many different machines,
 		 * the screen sizes may vary a lot. Erasing the status window
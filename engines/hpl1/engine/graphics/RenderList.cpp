@@ -26,12 +26,14 @@
  */
 
 #include "hpl1/engine/graphics/RenderList.h"
+#include "common/algorithm.h"
 #include "hpl1/engine/graphics/Graphics.h"
 #include "hpl1/engine/graphics/Material.h"
 #include "hpl1/engine/graphics/RenderState.h"
 #include "hpl1/engine/graphics/Renderable.h"
 #include "hpl1/engine/graphics/Renderer3D.h"
 #include "hpl1/engine/graphics/RendererPostEffects.h"
+#include "hpl1/engine/graphics/occlusion_buffer.h"
 #include "hpl1/engine/math/Math.h"
 #include "hpl1/engine/scene/Camera3D.h"
 #include "hpl1/engine/scene/MeshEntity.h"
@@ -40,6 +42,13 @@ namespace hpl {
 
 int cRenderList::mlGlobalRenderCount = 0;
 
+// Size of the software depth buffer used for occlusion culling
+static const int kOcclusionBufferWidth = 160;
+static const int kOcclusionBufferHeight = 120;
+
+// Objects smaller than this on the occlusion buffer are not worth drawing as occluders
+static const int kMinOccluderPixels = 64;
+
 //////////////////////////////////////////////////////////////////////////
 // MOTION BLUR OBJECT COMPARE
 //////////////////////////////////////////////////////////////////////////
@@ -135,8 +144,13 @@ cRenderList::cRenderList(cGraphics *apGraphics) {
 	mlRenderCount = 0;
 	mlLastRenderCount = 0;
 
+	mlFogCulledNum = 0;
+	mlOcclusionCulledNum = 0;
+
 	mpGraphics = apGraphics;
 
+	mpOcclusionBuffer = hplNew(OcclusionBuffer, (kOcclusionBufferWidth, kOcclusionBufferHeight));
+
 	m_poolRenderState = hplNew(cMemoryPool<iRenderState>, (3000, NULL));
 	m_poolRenderNode = hplNew(cMemoryPool<cRenderNode>, (3000, NULL));
 
@@ -153,6 +167,8 @@ cRenderList::~cRenderList() {
 	hplDelete(m_poolRenderState);
 	hplDelete(m_poolRenderNode);
 
+	hplDelete(mpOcclusionBuffer);
+
 	g_poolRenderState = NULL;
 	g_poolRenderNode = NULL;
 }
@@ -185,6 +201,9 @@ void cRenderList::Clear() {
 
 	mlLastRenderCount = mlRenderCount;
 	mlRenderCount++;
+
+	mlFogCulledNum = 0;
+	mlOcclusionCulledNum = 0;
 }
 
 //-----------------------------------------------------------------------
@@ -259,6 +278,10 @@ void cRenderList::Compile() {
 	for (int i = 0; i < lLightNum; ++i)
 		mvObjectsPerLight[i] = 0;
 
+	// Remove the objects hidden behind other objects before building the trees.
+	if (mpGraphics->GetRenderer3D()->GetOcclusionCullingActive())
+		CullOccludedObjects();
+
 	// Iterate the objects to be rendered and build trees with render states.
 	tRenderableSetIt it = m_setObjects.begin();
 	for (; it != m_setObjects.end(); ++it) {
@@ -337,6 +360,7 @@ bool cRenderList::Add(iRenderable *apObject) {
 		if (cMath::CheckCollisionBV(*pRenderer->GetFogBV(), *apObject->GetBoundingVolume())) {
 
 		} else {
+			++mlFogCulledNum;
 			return false;
 		}
 	}
@@ -670,6 +694,60 @@ void cRenderList::AddToTree(iRenderable *apObject, eRenderListDrawType aObjectTy
 	// Log("-------------------------\n");
 }
 
+//-----------------------------------------------------------------------
+
+static bool IsOccluder(iRenderable *apObject) {
+	if (apObject->GetRenderType() != eRenderableType_Normal)
+		return false;
+
+	// Only solid objects that fill the depth buffer hide what is behind them.
+	iMaterial *pMaterial = apObject->GetMaterial();
+	if (pMaterial == NULL || pMaterial->IsTransperant() || pMaterial->HasAlpha() ||
+		pMaterial->GetDepthTest() == false || pMaterial->UsesType(eMaterialRenderType_Z) == false)
+		return false;
+
+	return apObject->GetVertexBuffer() != NULL;
+}
+
+static bool SortOcclusionObjects(const Common::Pair<float, iRenderable *> &aObjectA,
+								 const Common::Pair<float, iRenderable *> &aObjectB) {
+	return aObjectA.first < aObjectB.first;
+}
+
+void cRenderList::CullOccludedObjects() {
+	const cMatrixf &mtxView = mpCamera->GetViewMatrix();
+	mpOcclusionBuffer->clear(cMath::MatrixMul(mpCamera->GetProjectionMatrix(), mtxView),
+							 mpCamera->GetNearClipPlane());
+
+	// Sort the objects front to back, so that each object is tested against
+	// the occluders in front of it before being drawn as an occluder itself.
+	mvOcclusionObjects.clear();
+	for (tRenderableSetIt it = m_setObjects.begin(); it != m_setObjects.end(); ++it) {
+		iRenderable *pObject = *it;
+		if (pObject->GetRenderType() == eRenderableType_Mesh)
+			continue;
+
+		float fDist = -cMath::MatrixMul(mtxView, pObject->GetBoundingVolume()->GetWorldCenter()).z;
+		mvOcclusionObjects.push_back(Common::Pair<float, iRenderable *>(fDist, pObject));
+	}
+	Common::sort(mvOcclusionObjects.begin(), mvOcclusionObjects.end(), SortOcclusionObjects);
+
+	for (uint i = 0; i < mvOcclusionObjects.size(); ++i) {
+		iRenderable *pObject = mvOcclusionObjects[i].second;
+		cBoundingVolume *pBV = pObject->GetBoundingVolume();
+
+		int lCoveredPixels;
+		if (mpOcclusionBuffer->isBoxVisible(pBV->GetMin(), pBV->GetMax(), lCoveredPixels) == false) {
+			m_setObjects.erase(pObject);
+			++mlOcclusionCulledNum;
+			continue;
+		}
+
+		if (lCoveredPixels >= kMinOccluderPixels && IsOccluder(pObject))
+			mpOcclusionBuffer->drawOccluder(pObject->GetVertexBuffer(), pObject->GetModelMatrix(mpCamera));
+	}
+}
+
 //----------------------------------------------------------------------------------------------
 
 /*void cRenderList::AddToTree(iRenderable* apObject,eRenderListDrawType aObjectType,
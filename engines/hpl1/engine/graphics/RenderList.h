@@ -46,6 +46,7 @@ class cGraphics;
 
 class iRenderState;
 class cRenderSettings;
+class OcclusionBuffer;
 
 //-------------------------------------------------------------
 
@@ -174,6 +175,9 @@ public:
 
 	int GetLightObjects(int alLightIdx) { return mvObjectsPerLight[alLightIdx]; }
 
+	int GetFogCulledNum() { return mlFogCulledNum; }
+	int GetOcclusionCulledNum() { return mlOcclusionCulledNum; }
+
 	void SetFrameTime(float afTime) { mfFrameTime = afTime; }
 
 	cRenderNode *GetRootNode(eRenderListDrawType aObjectType, eMaterialRenderType aPassType, int alLightNum);
@@ -187,6 +191,8 @@ private:
 				   eMaterialRenderType mPassType, int alLightNum, iLight3D *apLight,
 				   bool abUseDepth, int alPass);
 
+	void CullOccludedObjects();
+
 	static int mlGlobalRenderCount;
 
 	tLight3DSet m_setLights;
@@ -209,6 +215,12 @@ private:
 	int mlRenderCount;
 	int mlLastRenderCount;
 
+	int mlFogCulledNum;
+	int mlOcclusionCulledNum;
+
+	OcclusionBuffer *mpOcclusionBuffer;
+	Common::Array<Common::Pair<float, iRenderable *> > mvOcclusionObjects;
+
 	float mfFrameTime;
 
 	cMemoryPool<iRenderState> *m_poolRenderState;
@@ -542,6 +542,7 @@ void iRenderState::SetRenderMode(cRenderSettings *apSettings) {
 	} else {
 		apSettings->mpVtxBuffer->Draw();
 	}
+	++apSettings->mlDrawCalls;
 }
 
 //-----------------------------------------------------------------------
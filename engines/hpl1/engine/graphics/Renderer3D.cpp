@@ -28,6 +28,7 @@
 #include "hpl1/engine/graphics/Renderer3D.h"
 
 #include "hpl1/debug.h"
+#include "hpl1/graphics.h"
 #include "hpl1/engine/graphics/GPUProgram.h"
 #include "hpl1/engine/graphics/LowLevelGraphics.h"
 #include "hpl1/engine/graphics/MeshCreator.h"
@@ -63,6 +64,7 @@ cRenderSettings::cRenderSettings() {
 	mfFogEnd = 5.0f;
 	mFogColor = cColor(1, 1);
 	mbFogCulling = false;
+	mlDrawCalls = 0;
 }
 
 //-----------------------------------------------------------------------
@@ -99,6 +101,9 @@ cRenderer3D::cRenderer3D(iLowLevelGraphics *apLowLevelGraphics, cResources *apRe
 
 	mbRefractionUsed = true;
 
+	// The software renderer gains much more from drawing less than it loses culling on the CPU
+	mbOcclusionCullingActive = !Hpl1::useOpenGL();
+
 	mvVtxRect.resize(4);
 	mvVtxRect[0] = cVertex(cVector3f(0, 0, 0), cVector2f(0, 1), cColor(1, 1));
 	mvVtxRect[1] = cVertex(cVector3f(1, 0, 0), cVector2f(1, 1), cColor(1, 1));
@@ -345,6 +350,7 @@ void cRenderer3D::RenderWorld(cWorld3D *apWorld, cCamera3D *apCamera, float afFr
 		mRenderSettings.mbLog = false;
 	}
 	mRenderSettings.mDebugFlags = mDebugFlags;
+	mRenderSettings.mlDrawCalls = 0;
 
 	/////////////////////////////////
 	// Set up rendering
@@ -626,6 +632,7 @@ void cRenderer3D::RenderFog(cCamera3D *apCamera) {
 
 		pObject->GetVertexBuffer()->Bind();
 		pObject->GetVertexBuffer()->Draw();
+		++mRenderSettings.mlDrawCalls;
 		pObject->GetVertexBuffer()->UnBind();
 	}
 
@@ -679,6 +686,7 @@ void cRenderer3D::RenderSkyBox(cCamera3D *apCamera) {
 
 	mpSkyBox->Bind();
 	mpSkyBox->Draw();
+	++mRenderSettings.mlDrawCalls;
 	mpSkyBox->UnBind();
 }
 //-----------------------------------------------------------------------
@@ -785,6 +793,7 @@ void cRenderer3D::RenderOcclusionQueries(cCamera3D *apCamera) {
 
 		pObject->mpQuery->Begin();
 		pObject->mpVtxBuffer->Draw();
+		++mRenderSettings.mlDrawCalls;
 		pObject->mpQuery->End();
 
 		if (mbLog)
@@ -1045,6 +1054,7 @@ void cRenderer3D::RenderTrans(cCamera3D *apCamera) {
 				if (bLog)
 					Log("    Drawing vtx buffer %d\n", pVtxBuffer);
 				pVtxBuffer->Draw();
+				++mRenderSettings.mlDrawCalls;
 
 				pVtxBuffer->UnBind();
 
@@ -1173,6 +1183,7 @@ void cRenderer3D::RenderTrans(cCamera3D *apCamera) {
 			pVtxBuffer->Bind();
 
 			pVtxBuffer->Draw();
+			++mRenderSettings.mlDrawCalls;
 
 			pVtxBuffer->UnBind();
 
@@ -1332,6 +1343,7 @@ void cRenderer3D::RenderTrans(cCamera3D *apCamera) {
 		if (bLog)
 			Log("Draw\n");
 		pVtxBuffer->Draw();
+		++mRenderSettings.mlDrawCalls;
 	}
 
 	if (mRenderSettings.mpVtxBuffer)
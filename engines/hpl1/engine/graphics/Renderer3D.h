@@ -132,6 +132,8 @@ public:
 	eMaterialBlendMode mTextureBlend[MAX_TEXTUREUNITS];
 
 	iVertexBuffer *mpVtxBuffer;
+
+	int mlDrawCalls;
 };
 
 //---------------------------------------------
@@ -185,6 +187,15 @@ public:
 	void SetDebugFlags(tRendererDebugFlag aFlags) { mDebugFlags = aFlags; }
 	tRendererDebugFlag GetDebugFlags() { return mDebugFlags; }
 
+	/**
+	 * Skips objects hidden behind other objects using a software depth buffer.
+	 * Enabled by default when rendering with TinyGL.
+	 */
+	void SetOcclusionCullingActive(bool abX) { mbOcclusionCullingActive = abX; }
+	bool GetOcclusionCullingActive() { return mbOcclusionCullingActive; }
+
+	int GetDrawCalls() { return mRenderSettings.mlDrawCalls; }
+
 	cRenderList *GetRenderList() { return mpRenderList; }
 	cRenderSettings *GetRenderSettings() { return &mRenderSettings; }
 
@@ -259,6 +270,8 @@ private:
 	cResources *mpResources;
 
 	tRendererDebugFlag mDebugFlags;
+
+	bool mbOcclusionCullingActive;
 };
 
 } // namespace hpl
@@ -154,6 +154,7 @@ public:
 	int GetElementNum() { return mlElementNum; }
 
 	tVertexFlag GetVertexFlags() { return mVertexFlags; }
+	eVertexBufferDrawType GetDrawType() { return mDrawType; }
 
 	bool HasTangents() { return mbTangents; }
 	void SetTangents(bool abX) { mbTangents = abX; }
@@ -0,0 +1,223 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "hpl1/engine/graphics/occlusion_buffer.h"
+#include "common/algorithm.h"
+#include "common/util.h"
+#include "hpl1/engine/graphics/VertexBuffer.h"
+#include "hpl1/engine/math/Math.h"
+
+namespace hpl {
+
+OcclusionBuffer::OcclusionBuffer(int width, int height) : _width(width), _height(height), _nearClipPlane(0) {
+	_depth.resize(width * height);
+}
+
+void OcclusionBuffer::clear(const cMatrixf &viewProjection, float nearClipPlane) {
+	_viewProjection = viewProjection;
+	_nearClipPlane = nearClipPlane;
+	Common::fill(_depth.begin(), _depth.end(), 0.0f);
+}
+
+void OcclusionBuffer::drawOccluder(iVertexBuffer *vtxBuffer, const cMatrixf *modelMatrix) {
+	const eVertexBufferDrawType drawType = vtxBuffer->GetDrawType();
+	if (drawType != eVertexBufferDrawType_Tri && drawType != eVertexBufferDrawType_Quad)
+		return;
+
+	const int vertexNum = vtxBuffer->GetVertexNum();
+	int indexNum = vtxBuffer->GetElementNum();
+	if (indexNum < 0)
+		indexNum = vtxBuffer->GetIndexNum();
+	if (vertexNum == 0 || indexNum == 0)
+		return;
+
+	const cMatrixf mtx = modelMatrix ? cMath::MatrixMul(_viewProjection, *modelMatrix) : _viewProjection;
+	const float *positions = vtxBuffer->GetArray(eVertexFlag_Position);
+	const unsigned int *indices = vtxBuffer->GetIndices();
+	const int stride = kvVertexElements[cMath::Log2ToInt(eVertexFlag_Position)];
+
+	if (drawType == eVertexBufferDrawType_Tri) {
+		for (int i = 0; i + 3 <= indexNum; i += 3) {
+			drawClipTriangle(transform(mtx, positions + indices[i] * stride),
+							 transform(mtx, positions + indices[i + 1] * stride),
+							 transform(mtx, positions + indices[i + 2] * stride));
+		}
+	} else {
+		for (int i = 0; i + 4 <= indexNum; i += 4) {
+			const ClipVertex v0 = transform(mtx, positions + indices[i] * stride);
+			const ClipVertex v2 = transform(mtx, positions + indices[i + 2] * stride);
+			drawClipTriangle(v0, transform(mtx, positions + indices[i + 1] * stride), v2);
+			drawClipTriangle(v0, v2, transform(mtx, positions + indices[i + 3] * stride));
+		}
+	}
+}
+
+bool OcclusionBuffer::isBoxVisible(const cVector3f &min, const cVector3f &max, int &coveredPixels) {
+	float minX = (float)_width, minY = (float)_height;
+	float maxX = 0, maxY = 0;
+	float nearestInvW = 0;
+
+	for (int i = 0; i < 8; ++i) {
+		const float corner[3] = {(i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z};
+		const ClipVertex v = transform(_viewProjection, corner);
+
+		// Boxes reaching past the near plane cover a large part of the screen
+		if (v.w < _nearClipPlane) {
+			coveredPixels = _width * _height;
+			return true;
+		}
+
+		const ScreenVertex s = project(v);
+		minX = MIN(minX, s.x);
+		minY = MIN(minY, s.y);
+		maxX = MAX(maxX, s.x);
+		maxY = MAX(maxY, s.y);
+		nearestInvW = MAX(nearestInvW, s.invW);
+	}
+
+	// Every pixel touched by the rectangle is tested, with a one pixel border
+	const int x0 = (int)floorf(CLIP(minX - 1.0f, 0.0f, (float)_width));
+	const int y0 = (int)floorf(CLIP(minY - 1.0f, 0.0f, (float)_height));
+	const int x1 = (int)ceilf(CLIP(maxX + 1.0f, 0.0f, (float)_width));
+	const int y1 = (int)ceilf(CLIP(maxY + 1.0f, 0.0f, (float)_height));
+
+	// Off screen, leave it to the frustum culling
+	if (x0 >= x1 || y0 >= y1) {
+		coveredPixels = 0;
+		return true;
+	}
+
+	coveredPixels = (x1 - x0) * (y1 - y0);
+
+	for (int y = y0; y < y1; ++y) {
+		const float *depth = &_depth[y * _width];
+		for (int x = x0; x < x1; ++x) {
+			if (depth[x] <= nearestInvW)
+				return true;
+		}
+	}
+
+	return false;
+}
+
+OcclusionBuffer::ClipVertex OcclusionBuffer::transform(const cMatrixf &mtx, const float *pos) const {
+	ClipVertex v;
+	v.x = mtx.m[0][0] * pos[0] + mtx.m[0][1] * pos[1] + mtx.m[0][2] * pos[2] + mtx.m[0][3];
+	v.y = mtx.m[1][0] * pos[0] + mtx.m[1][1] * pos[1] + mtx.m[1][2] * pos[2] + mtx.m[1][3];
+	v.w = mtx.m[3][0] * pos[0] + mtx.m[3][1] * pos[1] + mtx.m[3][2] * pos[2] + mtx.m[3][3];
+	return v;
+}
+
+OcclusionBuffer::ScreenVertex OcclusionBuffer::project(const ClipVertex &v) const {
+	ScreenVertex s;
+	s.invW = 1.0f / v.w;
+	s.x = (v.x * s.invW * 0.5f + 0.5f) * _width;
+	s.y = (0.5f - v.y * s.invW * 0.5f) * _height;
+	return s;
+}
+
+void OcclusionBuffer::drawClipTriangle(const ClipVertex &v0, const ClipVertex &v1, const ClipVertex &v2) {
+	// Clip against the near plane, which leaves at most four vertices
+	const ClipVertex *in[3] = {&v0, &v1, &v2};
+	ClipVertex out[4];
+	int outNum = 0;
+
+	for (int i = 0; i < 3; ++i) {
+		const ClipVertex &cur = *in[i];
+		const ClipVertex &next = *in[(i + 1) % 3];
+		const bool curInside = cur.w >= _nearClipPlane;
+		const bool nextInside = next.w >= _nearClipPlane;
+
+		if (curInside)
+			out[outNum++] = cur;
+
+		if (curInside != nextInside) {
+			const float t = (_nearClipPlane - cur.w) / (next.w - cur.w);
+			ClipVertex &v = out[outNum++];
+			v.x = cur.x + (next.x - cur.x) * t;
+			v.y = cur.y + (next.y - cur.y) * t;
+			v.w = _nearClipPlane;
+		}
+	}
+
+	if (outNum < 3)
+		return;
+
+	const ScreenVertex s0 = project(out[0]);
+	const ScreenVertex s2 = project(out[2]);
+	drawScreenTriangle(s0, project(out[1]), s2);
+	if (outNum == 4)
+		drawScreenTriangle(s0, s2, project(out[3]));
+}
+
+void OcclusionBuffer::drawScreenTriangle(const ScreenVertex &v0, const ScreenVertex &v1, const ScreenVertex &v2) {
+	// The renderer treats clockwise triangles as front facing, which is
+	// counter clockwise here as the y axis points down. Back facing
+	// triangles are skipped like they are by the renderer.
+	const float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+	if (area <= 0)
+		return;
+
+	const int x0 = (int)floorf(CLIP(MIN(v0.x, MIN(v1.x, v2.x)), 0.0f, (float)_width));
+	const int y0 = (int)floorf(CLIP(MIN(v0.y, MIN(v1.y, v2.y)), 0.0f, (float)_height));
+	const int x1 = (int)ceilf(CLIP(MAX(v0.x, MAX(v1.x, v2.x)), 0.0f, (float)_width));
+	const int y1 = (int)ceilf(CLIP(MAX(v0.y, MAX(v1.y, v2.y)), 0.0f, (float)_height));
+	if (x0 >= x1 || y0 >= y1)
+		return;
+
+	// 1/w is linear in screen space
+	const float dzdx = ((v1.invW - v0.invW) * (v2.y - v0.y) - (v2.invW - v0.invW) * (v1.y - v0.y)) / area;
+	const float dzdy = ((v2.invW - v0.invW) * (v1.x - v0.x) - (v1.invW - v0.invW) * (v2.x - v0.x)) / area;
+	const float pixelDepthRange = 0.5f * (fabsf(dzdx) + fabsf(dzdy));
+
+	// Edge functions are positive inside the triangle
+	const ScreenVertex *edgeStart[3] = {&v0, &v1, &v2};
+	const ScreenVertex *edgeEnd[3] = {&v1, &v2, &v0};
+	float edgeDx[3], edgeDy[3];
+	for (int i = 0; i < 3; ++i) {
+		edgeDx[i] = edgeEnd[i]->x - edgeStart[i]->x;
+		edgeDy[i] = edgeEnd[i]->y - edgeStart[i]->y;
+	}
+
+	for (int y = y0; y < y1; ++y) {
+		const float py = y + 0.5f;
+		float *depth = &_depth[y * _width];
+
+		for (int x = x0; x < x1; ++x) {
+			const float px = x + 0.5f;
+
+			bool covered = true;
+			for (int i = 0; i < 3 && covered; ++i) {
+				const float e = edgeDx[i] * (py - edgeStart[i]->y) - edgeDy[i] * (px - edgeStart[i]->x);
+				covered = e >= 0;
+			}
+			if (!covered)
+				continue;
+
+			// Keep the farthest depth the triangle has inside the pixel
+			const float z = v0.invW + dzdx * (px - v0.x) + dzdy * (py - v0.y) - pixelDepthRange;
+			if (z > depth[x])
+				depth[x] = z;
+		}
+	}
+}
+
+} // namespace hpl
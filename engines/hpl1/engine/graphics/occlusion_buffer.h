@@ -0,0 +1,88 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef HPL_OCCLUSION_BUFFER_H
+#define HPL_OCCLUSION_BUFFER_H
+
+#include "common/array.h"
+#include "hpl1/engine/math/MathTypes.h"
+
+namespace hpl {
+
+class iVertexBuffer;
+
+/**
+ * Low resolution software depth buffer, used to skip objects hidden behind
+ * other objects before they are sent to the renderer.
+ *
+ * The buffer stores 1/w, so larger values are nearer to the camera. Occluders
+ * write the pixels whose centers they cover, with the farthest depth they
+ * have inside the pixel. Tested boxes check every pixel they touch and a one
+ * pixel border around them, which makes up for the parts of the pixels on
+ * the edges of occluders that the occluders do not cover.
+ */
+class OcclusionBuffer {
+public:
+	OcclusionBuffer(int width, int height);
+
+	/**
+	 * Clears the buffer and sets up the camera used by the following calls.
+	 */
+	void clear(const cMatrixf &viewProjection, float nearClipPlane);
+
+	/**
+	 * Draws the front facing triangles of a vertex buffer into the buffer.
+	 * \param modelMatrix the model matrix of the buffer, NULL if the vertices are in world space.
+	 */
+	void drawOccluder(iVertexBuffer *vtxBuffer, const cMatrixf *modelMatrix);
+
+	/**
+	 * Checks if any part of a world space box can be seen past the occluders drawn so far.
+	 * \param coveredPixels is set to the number of pixels in the screen rectangle of the box.
+	 */
+	bool isBoxVisible(const cVector3f &min, const cVector3f &max, int &coveredPixels);
+
+private:
+	struct ClipVertex {
+		float x, y, w;
+	};
+
+	struct ScreenVertex {
+		float x, y, invW;
+	};
+
+	ClipVertex transform(const cMatrixf &mtx, const float *pos) const;
+	ScreenVertex project(const ClipVertex &v) const;
+
+	void drawClipTriangle(const ClipVertex &v0, const ClipVertex &v1, const ClipVertex &v2);
+	void drawScreenTriangle(const ScreenVertex &v0, const ScreenVertex &v1, const ScreenVertex &v2);
+
+	int _width;
+	int _height;
+	Common::Array<float> _depth;
+
+	cMatrixf _viewProjection;
+	float _nearClipPlane;
+};
+
+} // namespace hpl
+
+#endif // HPL_OCCLUSION_BUFFER_H
@@ -113,10 +113,10 @@ void cPhysicsWorldNewton::Simulate(float afTimeStep) {
 	// if(lUpdate % 30==0)
 	{
 		while (afTimeStep > mfMaxTimeStep) {
-			NewtonUpdate(mpNewtonWorld, mfMaxTimeStep);
+			UpdateNewton(mfMaxTimeStep);
 			afTimeStep -= mfMaxTimeStep;
 		}
-		NewtonUpdate(mpNewtonWorld, afTimeStep);
+		UpdateNewton(afTimeStep);
 	}
 	// lUpdate++;
 	// cPhysicsBodyNewton::SetUseCallback(true);
@@ -130,6 +130,30 @@ void cPhysicsWorldNewton::Simulate(float afTimeStep) {
 
 //-----------------------------------------------------------------------
 
+static unsigned GetNewtonPerformanceTicks() {
+	return (unsigned)GetApplicationTime();
+}
+
+void cPhysicsWorldNewton::OnSetProfilingActive(bool abX) {
+	// Read the phase times in ms, NULL restores the default counter of Newton
+	NewtonSetPerformanceClock(mpNewtonWorld, abX ? GetNewtonPerformanceTicks : NULL);
+}
+
+//-----------------------------------------------------------------------
+
+void cPhysicsWorldNewton::UpdateNewton(float afTimeStep) {
+	NewtonUpdate(mpNewtonWorld, afTimeStep);
+
+	if (mbProfilingActive) {
+		AddSimulateTimes(NewtonReadPerformanceTicks(mpNewtonWorld, NEWTON_PROFILER_COLLISION_UPDATE),
+						 NewtonReadPerformanceTicks(mpNewtonWorld, NEWTON_PROFILER_COLLISION_UPDATE_BROAD_PHASE),
+						 NewtonReadPerformanceTicks(mpNewtonWorld, NEWTON_PROFILER_COLLISION_UPDATE_NARROW_PHASE),
+						 NewtonReadPerformanceTicks(mpNewtonWorld, NEWTON_PROFILER_DYNAMICS_UPDATE));
+	}
+}
+
+//-----------------------------------------------------------------------
+
 void cPhysicsWorldNewton::SetMaxTimeStep(float afTimeStep) {
 	mfMaxTimeStep = afTimeStep;
 }
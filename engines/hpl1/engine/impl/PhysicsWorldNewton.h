@@ -95,6 +95,9 @@ public:
 	NewtonWorld *GetNewtonWorld() { return mpNewtonWorld; }
 
 private:
+	void OnSetProfilingActive(bool abX) override;
+	void UpdateNewton(float afTimeStep);
+
 	NewtonWorld *mpNewtonWorld;
 
 	float *mpTempPoints;
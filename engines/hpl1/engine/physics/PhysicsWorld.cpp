@@ -52,6 +52,8 @@ namespace hpl {
 iPhysicsWorld::iPhysicsWorld() {
 	mbLogDebug = false;
 	mbSaveContactPoints = false;
+	mbProfilingActive = false;
+	mlProfiledUpdates = 0;
 }
 
 //-----------------------------------------------------------------------
@@ -68,6 +70,8 @@ iPhysicsWorld::~iPhysicsWorld() {
 //-----------------------------------------------------------------------
 
 void iPhysicsWorld::Update(float afTimeStep) {
+	unsigned long lStartTime = mbProfilingActive ? GetApplicationTime() : 0;
+
 	// Clear all contact points.
 	mvContactPoints.clear();
 
@@ -132,6 +136,52 @@ void iPhysicsWorld::Update(float afTimeStep) {
 
 		pBody->UpdateAfterSimulate(afTimeStep);
 	}
+
+	////////////////////////////////////
+	// Average the update times
+	if (mbProfilingActive) {
+		float fTime = (float)(GetApplicationTime() - lStartTime);
+		mStepTimesSum.mfUpdate += fTime;
+		mStepTimesSum.mfMaxUpdate = MAX(mStepTimesSum.mfMaxUpdate, fTime);
+
+		if (++mlProfiledUpdates == kProfiledUpdates) {
+			float fMul = 1.0f / (float)kProfiledUpdates;
+			mStepTimes.mfUpdate = mStepTimesSum.mfUpdate * fMul;
+			mStepTimes.mfMaxUpdate = mStepTimesSum.mfMaxUpdate;
+			mStepTimes.mfCollision = mStepTimesSum.mfCollision * fMul;
+			mStepTimes.mfBroadPhase = mStepTimesSum.mfBroadPhase * fMul;
+			mStepTimes.mfNarrowPhase = mStepTimesSum.mfNarrowPhase * fMul;
+			mStepTimes.mfDynamics = mStepTimesSum.mfDynamics * fMul;
+			mStepTimes.mfSimulateSteps = mStepTimesSum.mfSimulateSteps * fMul;
+
+			mStepTimesSum = cPhysicsStepTimes();
+			mlProfiledUpdates = 0;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------
+
+void iPhysicsWorld::SetProfilingActive(bool abX) {
+	if (mbProfilingActive == abX)
+		return;
+
+	mbProfilingActive = abX;
+	mlProfiledUpdates = 0;
+	mStepTimes = cPhysicsStepTimes();
+	mStepTimesSum = cPhysicsStepTimes();
+
+	OnSetProfilingActive(abX);
+}
+
+//-----------------------------------------------------------------------
+
+void iPhysicsWorld::AddSimulateTimes(unsigned alCollision, unsigned alBroadPhase, unsigned alNarrowPhase, unsigned alDynamics) {
+	mStepTimesSum.mfCollision += (float)alCollision;
+	mStepTimesSum.mfBroadPhase += (float)alBroadPhase;
+	mStepTimesSum.mfNarrowPhase += (float)alNarrowPhase;
+	mStepTimesSum.mfDynamics += (float)alDynamics;
+	mStepTimesSum.mfSimulateSteps += 1.0f;
 }
 
 //-----------------------------------------------------------------------
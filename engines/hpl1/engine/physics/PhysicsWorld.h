@@ -112,6 +112,20 @@ public:
 
 //----------------------------------------------------
 
+//! Time in ms spent in the parts of a physics update, averaged over a number of updates
+class cPhysicsStepTimes {
+public:
+	float mfUpdate = 0;
+	float mfMaxUpdate = 0;
+	float mfCollision = 0;
+	float mfBroadPhase = 0;
+	float mfNarrowPhase = 0;
+	float mfDynamics = 0;
+	float mfSimulateSteps = 0;
+};
+
+//----------------------------------------------------
+
 class iPhysicsWorld {
 public:
 	iPhysicsWorld();
@@ -216,6 +230,10 @@ public:
 	void SetLogDebug(bool abX) { mbLogDebug = abX; }
 	bool GetLogDebug() { return mbLogDebug; }
 
+	void SetProfilingActive(bool abX);
+	bool GetProfilingActive() { return mbProfilingActive; }
+	const cPhysicsStepTimes &GetStepTimes() { return mStepTimes; }
+
 	void AddSaveData(cSaveDataHandler *apHandler);
 
 	virtual iPhysicsController *CreateController(const tString &asName) = 0;
@@ -266,6 +284,17 @@ protected:
 
 	tCollidePointVec mvContactPoints;
 	bool mbSaveContactPoints;
+
+	// The times are averaged over this number of updates, one second of game time
+	static const int kProfiledUpdates = 60;
+
+	virtual void OnSetProfilingActive(bool abX) {}
+	void AddSimulateTimes(unsigned alCollision, unsigned alBroadPhase, unsigned alNarrowPhase, unsigned alDynamics);
+
+	bool mbProfilingActive;
+	int mlProfiledUpdates;
+	cPhysicsStepTimes mStepTimes;
+	cPhysicsStepTimes mStepTimesSum;
 };
 
 } // namespace hpl
@@ -778,6 +778,7 @@ void iLight3D::RenderShadow(iRenderable *apObject, cRenderSettings *apRenderSett
 	// Draw vertex buffer
 	if (apLowLevelGraphics->GetCaps(eGraphicCaps_TwoSideStencil)) {
 		pSubEntity->GetVertexBuffer()->DrawIndices(mpIndexArray, lIndexCount);
+		++apRenderSettings->mlDrawCalls;
 		if (apRenderSettings->mbLog)
 			Log(" Drawing front and back simultaneously.\n");
 	} else {
@@ -789,23 +790,27 @@ void iLight3D::RenderShadow(iRenderable *apObject, cRenderSettings *apRenderSett
 			apLowLevelGraphics->SetStencil(eStencilFunc_Always, 0, 0x0,
 										   eStencilOp_Keep, eStencilOp_DecrementWrap, eStencilOp_Keep);
 			pSubEntity->GetVertexBuffer()->DrawIndices(mpIndexArray, lIndexCount);
+			++apRenderSettings->mlDrawCalls;
 
 			// Back
 			apLowLevelGraphics->SetCullMode(eCullMode_Clockwise);
 			apLowLevelGraphics->SetStencil(eStencilFunc_Always, 0, 0x0,
 										   eStencilOp_Keep, eStencilOp_IncrementWrap, eStencilOp_Keep);
 			pSubEntity->GetVertexBuffer()->DrawIndices(mpIndexArray, lIndexCount);
+			++apRenderSettings->mlDrawCalls;
 		} else {
 			// Front
 			apLowLevelGraphics->SetStencil(eStencilFunc_Always, 0, 0x0,
 										   eStencilOp_Keep, eStencilOp_Keep, eStencilOp_IncrementWrap);
 			pSubEntity->GetVertexBuffer()->DrawIndices(mpIndexArray, lIndexCount);
+			++apRenderSettings->mlDrawCalls;
 
 			// Back
 			apLowLevelGraphics->SetCullMode(eCullMode_Clockwise);
 			apLowLevelGraphics->SetStencil(eStencilFunc_Always, 0, 0x0,
 										   eStencilOp_Keep, eStencilOp_Keep, eStencilOp_DecrementWrap);
 			pSubEntity->GetVertexBuffer()->DrawIndices(mpIndexArray, lIndexCount);
+			++apRenderSettings->mlDrawCalls;
 		}
 
 		apLowLevelGraphics->SetCullMode(eCullMode_CounterClockwise);
@@ -68,6 +68,7 @@ MODULE_OBJS := \
 	engine/graphics/Renderer2D.o \
 	engine/graphics/Renderer3D.o \
 	engine/graphics/RendererPostEffects.o \
+	engine/graphics/occlusion_buffer.o \
 	engine/graphics/Skeleton.o \
 	engine/graphics/SubMesh.o \
 	engine/graphics/bitmap2D.o \
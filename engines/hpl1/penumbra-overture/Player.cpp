@@ -69,6 +69,8 @@ cPlayer::cPlayer(cInit *apInit) : iUpdateable("Player") {
 	// Get Debug variables
 	mbShowHealth = mpInit->mpConfig->GetBool("Debug", "ShowHealth", false);
 	mbShowSoundsPlaying = mpInit->mpConfig->GetBool("Debug", "ShowSoundsPlaying", false);
+	mbShowPhysicsTimes = mpInit->mpConfig->GetBool("Debug", "ShowPhysicsTimes", false);
+	mbShowRenderStats = mpInit->mpConfig->GetBool("Debug", "ShowRenderStats", false);
 
 	mvSize.x = mpInit->mpGameConfig->GetFloat("Player", "Width", 1);
 	mvSize.y = mpInit->mpGameConfig->GetFloat("Player", "Height", 1);
@@ -247,6 +249,8 @@ cPlayer::~cPlayer(void) {
 
 	mpInit->mpConfig->SetBool("Debug", "ShowHealth", mbShowHealth);
 	mpInit->mpConfig->SetBool("Debug", "ShowSoundsPlaying", mbShowSoundsPlaying);
+	mpInit->mpConfig->SetBool("Debug", "ShowPhysicsTimes", mbShowPhysicsTimes);
+	mpInit->mpConfig->SetBool("Debug", "ShowRenderStats", mbShowRenderStats);
 
 	STLDeleteAll(mvMoveStates);
 	STLDeleteAll(mvStates);
@@ -1388,6 +1392,31 @@ void cPlayer::OnDraw() {
 	// mpFont->Draw(cVector3f(5,20,0),12,cColor(1,1,1,1),eFontAlign_Left,"Gravity: %s",
 	//														vGravity.ToString().c_str());
 
+	// DEBUG: physics step times
+	if (mbShowPhysicsTimes) {
+		iPhysicsWorld *pPhysicsWorld = mpInit->mpGame->GetScene()->GetWorld3D() ? mpInit->mpGame->GetScene()->GetWorld3D()->GetPhysicsWorld() : NULL;
+		if (pPhysicsWorld) {
+			pPhysicsWorld->SetProfilingActive(true);
+
+			const cPhysicsStepTimes &times = pPhysicsWorld->GetStepTimes();
+			mpFont->draw(cVector3f(5, 560, 0), 12, cColor(1, 1, 1, 1), eFontAlign_Left,
+						 Common::U32String::format("Physics: %.2f ms (max %.0f ms) Steps: %.1f", times.mfUpdate, times.mfMaxUpdate, times.mfSimulateSteps));
+			mpFont->draw(cVector3f(5, 574, 0), 12, cColor(1, 1, 1, 1), eFontAlign_Left,
+						 Common::U32String::format("Collision: %.2f ms (broad %.2f, narrow %.2f) Dynamics: %.2f ms",
+												   times.mfCollision, times.mfBroadPhase, times.mfNarrowPhase, times.mfDynamics));
+		}
+	}
+
+	// DEBUG: render statistics of the last frame
+	if (mbShowRenderStats) {
+		cRenderer3D *pRenderer = mpInit->mpGame->GetGraphics()->GetRenderer3D();
+		cRenderList *pRenderList = pRenderer->GetRenderList();
+		mpFont->draw(cVector3f(5, 546, 0), 12, cColor(1, 1, 1, 1), eFontAlign_Left,
+					 Common::U32String::format("Objects: %d Draw calls: %d Culled by occlusion: %d Culled by fog: %d",
+											   pRenderList->GetObjectNum(), pRenderer->GetDrawCalls(),
+											   pRenderList->GetOcclusionCulledNum(), pRenderList->GetFogCulledNum()));
+	}
+
 	// DEBUG: sounds playing
 	if (mbShowSoundsPlaying) {
 		tStringVec vSoundNames;
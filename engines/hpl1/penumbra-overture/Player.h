@@ -480,6 +480,8 @@ private:
 	// Debug
 	bool mbShowHealth;
 	bool mbShowSoundsPlaying;
+	bool mbShowPhysicsTimes;
+	bool mbShowRenderStats;
 
 	tGameCollideScriptMap m_mapCollideCallbacks;
 };
@@ -24,6 +24,7 @@
 #include "engines/myst3/archive.h"
 #include "engines/myst3/database.h"
 #include "engines/myst3/effects.h"
+#include "engines/myst3/facecache.h"
 #include "engines/myst3/inventory.h"
 #include "engines/myst3/script.h"
 #include "engines/myst3/state.h"
@@ -43,6 +44,7 @@ Console::Console(Myst3Engine *vm) : GUI::Debugger(), _vm(vm) {
 	registerCmd("fillInventory",			WRAP_METHOD(Console, Cmd_FillInventory));
 	registerCmd("dumpArchive",			WRAP_METHOD(Console, Cmd_DumpArchive));
 	registerCmd("dumpMasks",			WRAP_METHOD(Console, Cmd_DumpMasks));
+	registerCmd("faceCache",			WRAP_METHOD(Console, Cmd_FaceCache));
 }
 
 Console::~Console() {
@@ -454,6 +456,35 @@ bool Console::Cmd_DumpMasks(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::Cmd_FaceCache(int argc, const char **argv) {
+	if (argc != 1 && (argc != 2 || strcmp(argv[1], "clear") != 0)) {
+		debugPrintf("Show the statistics of the decoded cube face cache.\n");
+		debugPrintf("Usage :\n");
+		debugPrintf("faceCache [clear]\n");
+		return true;
+	}
+
+	FaceCache *cache = _vm->_faceCache;
+
+	if (argc == 2) {
+		cache->clear();
+		debugPrintf("Face cache cleared\n");
+		return true;
+	}
+
+	const FaceCache::Stats &stats = cache->getStats();
+	uint32 requests = stats.hits + stats.misses;
+
+	debugPrintf("Faces: %d, memory: %d / %d KB\n", cache->getEntryCount(),
+	            cache->getMemoryUsed() / 1024, cache->getMemoryBudget() / 1024);
+	debugPrintf("Hits: %d, misses: %d, hit rate: %d%%\n", stats.hits, stats.misses,
+	            requests ? stats.hits * 100 / requests : 0);
+	debugPrintf("Prefetched: %d, used after prefetch: %d, queued: %d\n", stats.prefetched,
+	            stats.prefetchHits, cache->getQueuedCount());
+
+	return true;
+}
+
 bool Console::dumpFaceMask(uint16 index, int face, Archive::ResourceType type) {
 	ResourceDescription maskDesc = _vm->getFileDescription("", index, face, type);
 
@@ -0,0 +1,245 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "engines/myst3/facecache.h"
+#include "engines/myst3/archive.h"
+#include "engines/myst3/database.h"
+#include "engines/myst3/hotspot.h"
+#include "engines/myst3/myst3.h"
+#include "engines/myst3/state.h"
+
+#include "common/algorithm.h"
+
+#include "graphics/surface.h"
+
+namespace Myst3 {
+
+// The script opcodes moving the player to another node of the same room
+enum GoToNodeOpcodes {
+	kOpGoToNodeTransition = 136,
+	kOpGoToNodeTrans2     = 137,
+	kOpGoToNodeTrans1     = 138
+};
+
+FaceCache::FaceCache(Myst3Engine *vm) :
+		_vm(vm),
+		_memoryUsed(0),
+		_generation(0) {
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+FaceCache::~FaceCache() {
+	clear();
+}
+
+void FaceCache::clear() {
+	for (Common::List<Entry>::iterator it = _entries.begin(); it != _entries.end(); it++) {
+		freeEntry(*it);
+	}
+	_entries.clear();
+	_queue.clear();
+	_memoryUsed = 0;
+}
+
+void FaceCache::freeEntry(Entry &entry) {
+	entry.surface->free();
+	delete entry.surface;
+	entry.surface = nullptr;
+}
+
+Common::String FaceCache::getCurrentRoomName() const {
+	return _vm->_db->getRoomName(_vm->_state->getLocationRoom(), _vm->_state->getLocationAge());
+}
+
+FaceCache::Entry *FaceCache::find(const Common::String &room, uint16 node, uint16 face) {
+	for (Common::List<Entry>::iterator it = _entries.begin(); it != _entries.end(); it++) {
+		if (it->node == node && it->face == face && it->room == room) {
+			// Move the entry to the front, as it is the most recently used now
+			if (it != _entries.begin()) {
+				_entries.push_front(*it);
+				_entries.erase(it);
+			}
+			return &_entries.front();
+		}
+	}
+
+	return nullptr;
+}
+
+Graphics::Surface *FaceCache::decode(const Common::String &room, uint16 node, uint16 face) {
+	ResourceDescription jpegDesc = _vm->getFileDescription(room, node, face + 1, Archive::kCubeFace);
+	if (!jpegDesc.isValid())
+		return nullptr;
+
+	return Myst3Engine::decodeJpeg(&jpegDesc);
+}
+
+bool FaceCache::makeRoom(uint32 size, bool evictCurrent) {
+	while (_memoryUsed + size > kMemoryBudget && !_entries.empty()) {
+		Entry &last = _entries.back();
+
+		// Faces prefetched for the current node must not push each other out
+		if (!evictCurrent && last.generation == _generation)
+			return false;
+
+		_memoryUsed -= last.surface->pitch * last.surface->h;
+		freeEntry(last);
+		_entries.pop_back();
+	}
+
+	return _memoryUsed + size <= kMemoryBudget;
+}
+
+Graphics::Surface *FaceCache::getCubeFace(uint16 nodeId, uint16 faceId) {
+	Common::String room = getCurrentRoomName();
+
+	Graphics::Surface *copy = new Graphics::Surface();
+
+	Entry *entry = find(room, nodeId, faceId);
+	if (entry) {
+		_stats.hits++;
+		if (entry->prefetched) {
+			_stats.prefetchHits++;
+			entry->prefetched = false;
+		}
+		entry->generation = _generation;
+
+		copy->copyFrom(*entry->surface);
+		return copy;
+	}
+
+	_stats.misses++;
+
+	Graphics::Surface *surface = decode(room, nodeId, faceId);
+	if (!surface)
+		error("Face %d of node %d does not exist", faceId, nodeId);
+
+	copy->copyFrom(*surface);
+
+	if (makeRoom(surface->pitch * surface->h, true)) {
+		Entry newEntry;
+		newEntry.room = room;
+		newEntry.node = nodeId;
+		newEntry.face = faceId;
+		newEntry.surface = surface;
+		newEntry.generation = _generation;
+		newEntry.prefetched = false;
+		_entries.push_front(newEntry);
+		_memoryUsed += surface->pitch * surface->h;
+	} else {
+		surface->free();
+		delete surface;
+	}
+
+	return copy;
+}
+
+void FaceCache::prefetchAdjacentNodes() {
+	_queue.clear();
+	_generation++;
+
+	uint16 currentNode = _vm->_state->getLocationNode();
+	uint32 room = _vm->_state->getLocationRoom();
+	uint32 age = _vm->_state->getLocationAge();
+	Common::String roomName = getCurrentRoomName();
+
+	// The faces of the current node were just loaded, keep them
+	for (Common::List<Entry>::iterator it = _entries.begin(); it != _entries.end(); it++) {
+		if (it->node == currentNode && it->room == roomName)
+			it->generation = _generation;
+	}
+
+	NodePtr nodeData = _vm->_db->getNodeData(currentNode, room, age);
+	if (!nodeData)
+		return;
+
+	Common::Array<uint16> queuedNodes;
+	for (uint i = 0; i < nodeData->hotspots.size(); i++) {
+		const Common::Array<Opcode> &script = nodeData->hotspots[i].script;
+
+		for (uint j = 0; j < script.size(); j++) {
+			const Opcode &opcode = script[j];
+			if (opcode.op != kOpGoToNodeTransition && opcode.op != kOpGoToNodeTrans2 && opcode.op != kOpGoToNodeTrans1)
+				continue;
+
+			if (opcode.args.empty())
+				continue;
+
+			int16 node = opcode.args[0];
+			if (node <= 0 || node == currentNode || Common::find(queuedNodes.begin(), queuedNodes.end(), node) != queuedNodes.end())
+				continue;
+
+			// Only the cube nodes have faces to decode
+			if (!_vm->getFileDescription(roomName, node, 1, Archive::kCubeFace).isValid())
+				continue;
+
+			queuedNodes.push_back(node);
+			for (uint16 face = 0; face < 6; face++) {
+				QueuedFace queuedFace;
+				queuedFace.room = roomName;
+				queuedFace.node = node;
+				queuedFace.face = face;
+				_queue.push(queuedFace);
+			}
+		}
+	}
+}
+
+void FaceCache::decodeQueued() {
+	while (!_queue.empty()) {
+		QueuedFace queuedFace = _queue.pop();
+
+		Entry *entry = find(queuedFace.room, queuedFace.node, queuedFace.face);
+		if (entry) {
+			entry->generation = _generation;
+			continue; // Already decoded, try the next one
+		}
+
+		Graphics::Surface *surface = decode(queuedFace.room, queuedFace.node, queuedFace.face);
+		if (!surface)
+			continue;
+
+		if (!makeRoom(surface->pitch * surface->h, false)) {
+			// The budget is used up by the faces of the current and adjacent nodes
+			surface->free();
+			delete surface;
+			_queue.clear();
+			return;
+		}
+
+		Entry newEntry;
+		newEntry.room = queuedFace.room;
+		newEntry.node = queuedFace.node;
+		newEntry.face = queuedFace.face;
+		newEntry.surface = surface;
+		newEntry.generation = _generation;
+		newEntry.prefetched = true;
+		_entries.push_front(newEntry);
+		_memoryUsed += surface->pitch * surface->h;
+		_stats.prefetched++;
+
+		// Decode only one face per frame
+		return;
+	}
+}
+
+} // End of namespace Myst3
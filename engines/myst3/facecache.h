@@ -0,0 +1,118 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef MYST3_FACECACHE_H
+#define MYST3_FACECACHE_H
+
+#include "common/list.h"
+#include "common/queue.h"
+#include "common/str.h"
+
+namespace Graphics {
+struct Surface;
+}
+
+namespace Myst3 {
+
+class Myst3Engine;
+
+/**
+ * Keeps the decoded cube faces of the recently visited nodes, and of the nodes
+ * the player can go to from the current node, up to a memory budget.
+ *
+ * Decoding the six faces of a node takes long enough to stall the node transitions.
+ * The faces of the adjacent nodes are decoded ahead, one at a time, between frames.
+ */
+class FaceCache {
+public:
+	struct Stats {
+		uint32 hits;
+		uint32 misses;
+		uint32 prefetched;
+		uint32 prefetchHits;
+	};
+
+	FaceCache(Myst3Engine *vm);
+	~FaceCache();
+
+	/**
+	 * Returns the decoded face of a node from the current room.
+	 * The caller owns the returned surface.
+	 */
+	Graphics::Surface *getCubeFace(uint16 nodeId, uint16 faceId);
+
+	/**
+	 * Queues the faces of the nodes reachable through the hotspots of the
+	 * current node for decoding
+	 */
+	void prefetchAdjacentNodes();
+
+	/** Decodes the next queued face, if any */
+	void decodeQueued();
+
+	void clear();
+
+	const Stats &getStats() const { return _stats; }
+	uint32 getMemoryUsed() const { return _memoryUsed; }
+	uint32 getMemoryBudget() const { return kMemoryBudget; }
+	uint getEntryCount() const { return _entries.size(); }
+	uint getQueuedCount() const { return _queue.size(); }
+
+private:
+	// Enough for about ten nodes
+	static const uint32 kMemoryBudget = 96 * 1024 * 1024;
+
+	struct Entry {
+		Common::String room;
+		uint16 node;
+		uint16 face;
+		Graphics::Surface *surface;
+		// Set when the face was the last node load, or was prefetched since then
+		uint32 generation;
+		bool prefetched;
+	};
+
+	struct QueuedFace {
+		Common::String room;
+		uint16 node;
+		uint16 face;
+	};
+
+	Myst3Engine *_vm;
+
+	// Most recently used entries first
+	Common::List<Entry> _entries;
+	Common::Queue<QueuedFace> _queue;
+	uint32 _memoryUsed;
+	uint32 _generation;
+	Stats _stats;
+
+	Common::String getCurrentRoomName() const;
+	Entry *find(const Common::String &room, uint16 node, uint16 face);
+	Graphics::Surface *decode(const Common::String &room, uint16 node, uint16 face);
+	bool makeRoom(uint32 size, bool evictCurrent);
+	void freeEntry(Entry &entry);
+};
+
+} // End of namespace Myst3
+
+#endif // MYST3_FACECACHE_H
@@ -61,6 +61,7 @@ enum TransitionType {
 class Archive;
 class Console;
 class Drawable;
+class FaceCache;
 class GameState;
 class HotSpot;
 class Cursor;
@@ -102,6 +103,7 @@ public:
 	Database *_db;
 	Sound *_sound;
 	Ambient *_ambient;
+	FaceCache *_faceCache;
 
 	Common::RandomSource *_rnd;
 
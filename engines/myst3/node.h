@@ -47,6 +47,7 @@ public:
 	~Face();
 
 	void setTextureFromJPEG(const ResourceDescription *jpegDesc);
+	void setTexture(Graphics::Surface *bitmap);
 
 	void addTextureDirtyRect(const Common::Rect &rect);
 	bool isTextureDirty() { return _textureDirty; }
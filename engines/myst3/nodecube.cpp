@@ -19,7 +19,7 @@
  *
  */
 
-#include "engines/myst3/archive.h"
+#include "engines/myst3/facecache.h"
 #include "engines/myst3/nodecube.h"
 #include "engines/myst3/myst3.h"
 
@@ -32,13 +32,8 @@ NodeCube::NodeCube(Myst3Engine *vm, uint16 id) :
 	_is3D = true;
 
 	for (int i = 0; i < 6; i++) {
-		ResourceDescription jpegDesc = _vm->getFileDescription("", id, i + 1, Archive::kCubeFace);
-
-		if (!jpegDesc.isValid())
-			error("Face %d does not exist", id);
-
 		_faces[i] = new Face(_vm, true);
-		_faces[i]->setTextureFromJPEG(&jpegDesc);
+		_faces[i]->setTexture(_vm->_faceCache->getCubeFace(id, i));
 	}
 }
 
@@ -28,6 +28,7 @@
 #include "scumm/actor.h"
 #include "scumm/boxes.h"
 #include "scumm/debugger.h"
+#include "scumm/he/intern_he.h"
 #include "scumm/imuse/imuse.h"
 #include "scumm/imuse_digi/dimuse_engine.h"
 #include "scumm/object.h"
@@ -111,6 +112,12 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 #endif
 
 	registerCmd("resetcursors",    WRAP_METHOD(ScummDebugger, Cmd_ResetCursors));
+	registerCmd("strips",    WRAP_METHOD(ScummDebugger, Cmd_Strips));
+
+#ifdef ENABLE_HE
+	if (_vm->_game.heversion >= 71)
+		registerCmd("wizcache",  WRAP_METHOD(ScummDebugger, Cmd_WizCache));
+#endif
 }
 
 void ScummDebugger::preEnter() {
@@ -1064,6 +1071,72 @@ bool ScummDebugger::Cmd_Debug(int argc, const char **argv) {
 	return true;
 }
 
+bool ScummDebugger::Cmd_Strips(int argc, const char **argv) {
+	if (argc > 1) {
+		if (!strcmp(argv[1], "on")) {
+			_vm->_stripCostAccounting = true;
+			_vm->_frameStripBlits = _vm->_frameStripPixels = 0;
+			debugPrintf("Strip cost accounting on\n");
+		} else if (!strcmp(argv[1], "off")) {
+			_vm->_stripCostAccounting = false;
+			debugPrintf("Strip cost accounting off\n");
+		} else if (!strcmp(argv[1], "reset")) {
+			_vm->_stripCostStats.clear();
+			debugPrintf("Strip cost statistics cleared\n");
+		} else {
+			debugPrintf("Syntax: strips [on|off|reset]\n");
+		}
+		return true;
+	}
+
+	if (_vm->_stripCostStats.empty()) {
+		debugPrintf("No strip statistics collected (accounting is %s) - use 'strips on' to start\n", _vm->_stripCostAccounting ? "on" : "off");
+		return true;
+	}
+
+	debugPrintf("Room | Frames |  Blits | Pixels/frame | Max pixels/frame\n");
+	for (auto &stats : _vm->_stripCostStats) {
+		const ScummEngine::StripCostStats &s = stats._value;
+		debugPrintf("%4d | %6d | %6d | %12llu | %16llu\n", stats._key, s.frames, s.blits,
+			(unsigned long long)(s.frames ? s.pixels / s.frames : 0), (unsigned long long)s.maxFramePixels);
+	}
+
+	return true;
+}
+
+#ifdef ENABLE_HE
+
+bool ScummDebugger::Cmd_WizCache(int argc, const char **argv) {
+	Wiz *wiz = ((ScummEngine_v71he *)_vm)->_wiz;
+
+	if (argc > 1) {
+		if (!strcmp(argv[1], "on")) {
+			wiz->_decodedCacheEnabled = true;
+		} else if (!strcmp(argv[1], "off")) {
+			wiz->_decodedCacheEnabled = false;
+			wiz->clearDecodedStateCache();
+		} else if (!strcmp(argv[1], "clear")) {
+			wiz->clearDecodedStateCache();
+			memset(&wiz->_decodedCacheStats, 0, sizeof(wiz->_decodedCacheStats));
+		} else {
+			debugPrintf("Syntax: wizcache [on|off|clear]\n");
+			return true;
+		}
+	}
+
+	const WizDecodedCacheStats &stats = wiz->_decodedCacheStats;
+	const uint32 lookups = stats.hits + stats.misses;
+
+	debugPrintf("Wiz decoded state cache is %s\n", wiz->_decodedCacheEnabled ? "on" : "off");
+	debugPrintf("  %u states, %u of %u KB used\n", wiz->_decodedCache.size(), wiz->_decodedCacheSize / 1024, wiz->_decodedCacheBudget / 1024);
+	debugPrintf("  %u hits, %u misses (%u%% hit rate)\n", stats.hits, stats.misses, lookups ? (uint)((uint64)stats.hits * 100 / lookups) : 0);
+	debugPrintf("  %u evictions, %u invalidations\n", stats.evictions, stats.invalidations);
+
+	return true;
+}
+
+#endif
+
 bool ScummDebugger::Cmd_Camera(int argc, const char **argv) {
 	debugPrintf("Camera: cur (%d,%d) - dest (%d,%d) - accel (%d,%d) -- last (%d,%d)\n",
 		_vm->camera._cur.x, _vm->camera._cur.y, _vm->camera._dest.x, _vm->camera._dest.y,
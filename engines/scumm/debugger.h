@@ -75,6 +75,10 @@ private:
 	bool Cmd_DiMuse(int argc, const char **argv);
 
 	bool Cmd_ResetCursors(int argc, const char **argv);
+	bool Cmd_Strips(int argc, const char **argv);
+#ifdef ENABLE_HE
+	bool Cmd_WizCache(int argc, const char **argv);
+#endif
 
 	void printBox(int box);
 	void drawBox(int box, int color);
@@ -544,6 +544,27 @@ void ScummEngine::drawDirtyScreenParts() {
 	} else {
 		updateDirtyScreen(kMainVirtScreen);
 	}
+
+	if (_stripCostAccounting)
+		accountStripCost();
+}
+
+/**
+ * Add the strips blitted during the current frame to the statistics of the
+ * current room, see the "strips" debugger command.
+ */
+void ScummEngine::accountStripCost() {
+	StripCostStats &stats = _stripCostStats.getOrCreateVal(_currentRoom);
+	stats.frames++;
+	stats.blits += _frameStripBlits;
+	stats.pixels += _frameStripPixels;
+	stats.maxFramePixels = MAX(stats.maxFramePixels, _frameStripPixels);
+
+	if (_frameStripBlits)
+		debug(5, "Room %d: %d strip blits, %llu pixels composed", _currentRoom, _frameStripBlits, (unsigned long long)_frameStripPixels);
+
+	_frameStripBlits = 0;
+	_frameStripPixels = 0;
 }
 
 void ScummEngine_v6::drawDirtyScreenParts() {
@@ -662,6 +683,11 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 	if (width <= 0 || height <= 0)
 		return;
 
+	if (_stripCostAccounting) {
+		_frameStripBlits++;
+		_frameStripPixels += width * height;
+	}
+
 	if (_macScreen) {
 		mac_drawStripToScreen(vs, top, x, y, width, height);
 		return;
@@ -703,60 +729,24 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 #endif
 		// Compose the text over the game graphics
 		if (_outputPixelFormat.bytesPerPixel == 2) {
-			const byte *srcPtr = (const byte *)src;
-			const byte *textPtr = (byte *)_textSurface.getBasePtr(x * m, y * m);
-			byte *dstPtr = _compositeBuf;
-
-			for (int h = 0; h < height * m; ++h) {
-				for (int w = 0; w < width * m; ++w) {
-					uint16 tmp = *textPtr++;
-					if (tmp == CHARSET_MASK_TRANSPARENCY) {
-						tmp = READ_UINT16(srcPtr);
-						WRITE_UINT16(dstPtr, tmp); dstPtr += 2;
-					} else if (_game.heversion != 0) {
-						error ("16Bit Color HE Game using old charset");
-					} else {
-						WRITE_UINT16(dstPtr, _16BitPalette[tmp]); dstPtr += 2;
-					}
-					srcPtr += vs->format.bytesPerPixel;
-				}
-				srcPtr += vsPitch;
-				textPtr += _textSurface.pitch - width * m;
-			}
+			const int srcPitch = width * m * vs->format.bytesPerPixel + vsPitch;
+#ifdef SCUMMVM_SSE2
+			if (vs->format.bytesPerPixel == 2 && g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+				compositeTextStrip16SSE2(_compositeBuf, (const byte *)src, srcPitch, (const byte *)text, _textSurface.pitch, width * m, height * m, _16BitPalette, _game.heversion != 0);
+			else
+#endif
+				compositeTextStrip16(_compositeBuf, (const byte *)src, srcPitch, vs->format.bytesPerPixel, (const byte *)text, _textSurface.pitch, width * m, height * m, _16BitPalette, _game.heversion != 0);
 		} else {
 #ifdef USE_ARM_GFX_ASM
 			asmDrawStripToScreen(height, width, text, src, _compositeBuf, vs->pitch, width, _textSurface.pitch);
 #else
-			// We blit four pixels at a time, for improved performance.
-			const uint32 *src32 = (const uint32 *)src;
-			uint32 *dst32 = (uint32 *)_compositeBuf;
-
-			vsPitch >>= 2;
-
-			const uint32 *text32 = (const uint32 *)text;
-			const int textPitch = (_textSurface.pitch - width * m) >> 2;
-			for (int h = height * m; h > 0; --h) {
-				for (int w = width * m; w > 0; w -= 4) {
-					uint32 temp = *text32++;
-
-					// Generate a byte mask for those text pixels (bytes) with
-					// value CHARSET_MASK_TRANSPARENCY. In the end, each byte
-					// in mask will be either equal to 0x00 or 0xFF.
-					// Doing it this way avoids branches and bytewise operations,
-					// at the cost of readability ;).
-					uint32 mask = temp ^ CHARSET_MASK_TRANSPARENCY_32;
-					mask = (((mask & 0x7f7f7f7f) + 0x7f7f7f7f) | mask) & 0x80808080;
-					mask = ((mask >> 7) + 0x7f7f7f7f) ^ 0x80808080;
-
-					// The following line is equivalent to this code:
-					//   *dst32++ = (*src32++ & mask) | (temp & ~mask);
-					// However, some compilers can generate somewhat better
-					// machine code for this equivalent statement:
-					*dst32++ = ((temp ^ *src32++) & mask) ^ temp;
-				}
-				src32 += vsPitch;
-				text32 += textPitch;
-			}
+			const int srcPitch = width * m + vsPitch;
+#ifdef SCUMMVM_SSE2
+			if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+				compositeTextStripSSE2(_compositeBuf, (const byte *)src, srcPitch, (const byte *)text, _textSurface.pitch, width * m, height * m);
+			else
+#endif
+				compositeTextStrip(_compositeBuf, (const byte *)src, srcPitch, (const byte *)text, _textSurface.pitch, width * m, height * m);
 #endif
 		}
 		src = _compositeBuf;
@@ -986,17 +976,21 @@ const byte *ScummEngine::ditherVGAtoEGA(int &pitch, int &x, int &y, int &width,
 	int pitch2 = (pitch - width) << 1;
 
 	uint8 *dst0 = _hercCGAScaleBuf;
-	uint8 *dst1 = _hercCGAScaleBuf + pitch;
 	uint8 *src = _compositeBuf;
 
+	// Each source line is dithered once and then doubled, which saves
+	// half of the color map lookups.
 	for (int i = height, st = 1 ^ (y & 1); i; --i, st ^= 1) {
+		const byte *map0 = _egaColorMap[st];
+		const byte *map1 = _egaColorMap[st ^ 1];
+		uint8 *line = dst0;
 		for (int ii = width; ii; --ii) {
 			byte in = *src++;
-			*dst0++ = *dst1++ = _egaColorMap[st][in];
-			*dst0++ = *dst1++ = _egaColorMap[st ^ 1][in];
+			*dst0++ = map0[in];
+			*dst0++ = map1[in];
 		}
+		memcpy(line + pitch, line, width << 1);
 		dst0 += pitch2;
-		dst1 += pitch2;
 	}
 
 	x <<= 1;
@@ -289,6 +289,19 @@ struct StripTable;
 #define CHARSET_MASK_TRANSPARENCY	 0xFD
 #define CHARSET_MASK_TRANSPARENCY_32 0xFDFDFDFD
 
+// Text compositing used by ScummEngine::drawStripToScreen(), see gfx_composite.cpp
+void compositeTextStrip(byte *dst, const byte *src, int srcPitch, const byte *text, int textPitch, int width, int height);
+void compositeTextStrip16(byte *dst, const byte *src, int srcPitch, int srcBpp, const byte *text, int textPitch, int width, int height, const uint16 *palette, bool heGame);
+
+#ifdef SCUMMVM_SSE2
+// Vectorized kernels, see gfx_sse2.cpp
+// Text compositing used by ScummEngine::drawStripToScreen()
+void compositeTextStripSSE2(byte *dst, const byte *src, int srcPitch, const byte *text, int textPitch, int width, int height);
+void compositeTextStrip16SSE2(byte *dst, const byte *src, int srcPitch, const byte *text, int textPitch, int width, int height, const uint16 *palette, bool heGame);
+// Copies the source bytes whose mask byte is 0xFF, used for cached Wiz images
+void copyMaskedRowSSE2(byte *dst, const byte *src, const byte *mask, int count);
+#endif
+
 class Gdi {
 protected:
 	ScummEngine *_vm;
@@ -0,0 +1,92 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+#include "common/endian.h"
+#include "common/textconsole.h"
+
+#include "scumm/gfx.h"
+
+namespace Scumm {
+
+/**
+ * Compose an 8 bit text surface area over the game graphics: every text pixel
+ * with value CHARSET_MASK_TRANSPARENCY lets the game graphics shine through.
+ * The width has to be a multiple of 4, the destination is written linearly.
+ */
+void compositeTextStrip(byte *dst, const byte *src, int srcPitch, const byte *text, int textPitch, int width, int height) {
+	// We blit four pixels at a time, for improved performance.
+	const uint32 *src32 = (const uint32 *)src;
+	const uint32 *text32 = (const uint32 *)text;
+	uint32 *dst32 = (uint32 *)dst;
+
+	srcPitch = (srcPitch - width) >> 2;
+	textPitch = (textPitch - width) >> 2;
+
+	for (int h = height; h > 0; --h) {
+		for (int w = width; w > 0; w -= 4) {
+			uint32 temp = *text32++;
+
+			// Generate a byte mask for those text pixels (bytes) with
+			// value CHARSET_MASK_TRANSPARENCY. In the end, each byte
+			// in mask will be either equal to 0x00 or 0xFF.
+			// Doing it this way avoids branches and bytewise operations,
+			// at the cost of readability ;).
+			uint32 mask = temp ^ CHARSET_MASK_TRANSPARENCY_32;
+			mask = (((mask & 0x7f7f7f7f) + 0x7f7f7f7f) | mask) & 0x80808080;
+			mask = ((mask >> 7) + 0x7f7f7f7f) ^ 0x80808080;
+
+			// The following line is equivalent to this code:
+			//   *dst32++ = (*src32++ & mask) | (temp & ~mask);
+			// However, some compilers can generate somewhat better
+			// machine code for this equivalent statement:
+			*dst32++ = ((temp ^ *src32++) & mask) ^ temp;
+		}
+		src32 += srcPitch;
+		text32 += textPitch;
+	}
+}
+
+/**
+ * Same as compositeTextStrip() for 16 bit output: transparent text pixels copy
+ * the game graphics, all others are converted through the given palette.
+ */
+void compositeTextStrip16(byte *dst, const byte *src, int srcPitch, int srcBpp, const byte *text, int textPitch, int width, int height, const uint16 *palette, bool heGame) {
+	for (int h = 0; h < height; ++h) {
+		const byte *srcPtr = src;
+		for (int w = 0; w < width; ++w) {
+			uint16 tmp = text[w];
+			if (tmp == CHARSET_MASK_TRANSPARENCY) {
+				tmp = READ_UINT16(srcPtr);
+				WRITE_UINT16(dst, tmp); dst += 2;
+			} else if (heGame) {
+				error ("16Bit Color HE Game using old charset");
+			} else {
+				WRITE_UINT16(dst, palette[tmp]); dst += 2;
+			}
+			srcPtr += srcBpp;
+		}
+		src += srcPitch;
+		text += textPitch;
+	}
+}
+
+} // End of namespace Scumm
@@ -0,0 +1,136 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+#include "common/endian.h"
+#include "common/textconsole.h"
+
+#include "scumm/gfx.h"
+
+#include <emmintrin.h>
+
+#ifdef __GNUC__
+#pragma GCC push_options
+
+#ifndef __x86_64__
+#pragma GCC target("sse2")
+#endif
+
+#endif
+
+namespace Scumm {
+
+/**
+ * SSE2 version of compositeTextStrip(), handles 16 pixels per iteration.
+ * The result is identical to the scalar version.
+ */
+void compositeTextStripSSE2(byte *dst, const byte *src, int srcPitch, const byte *text, int textPitch, int width, int height) {
+	const __m128i transparency = _mm_set1_epi8((char)CHARSET_MASK_TRANSPARENCY);
+
+	for (int h = height; h > 0; --h) {
+		int w = 0;
+		for (; w + 16 <= width; w += 16) {
+			const __m128i t = _mm_loadu_si128((const __m128i *)(text + w));
+			const __m128i s = _mm_loadu_si128((const __m128i *)(src + w));
+			const __m128i mask = _mm_cmpeq_epi8(t, transparency);
+			_mm_storeu_si128((__m128i *)(dst + w), _mm_or_si128(_mm_and_si128(mask, s), _mm_andnot_si128(mask, t)));
+		}
+		for (; w < width; ++w)
+			dst[w] = (text[w] == CHARSET_MASK_TRANSPARENCY) ? src[w] : text[w];
+
+		dst += width;
+		src += srcPitch;
+		text += textPitch;
+	}
+}
+
+/**
+ * SSE2 version of compositeTextStrip16() for 16 bit game graphics. Runs of
+ * 8 fully transparent text pixels are copied straight from the game graphics,
+ * everything else goes through the palette one pixel at a time.
+ */
+void compositeTextStrip16SSE2(byte *dst, const byte *src, int srcPitch, const byte *text, int textPitch, int width, int height, const uint16 *palette, bool heGame) {
+	const __m128i transparency = _mm_set1_epi8((char)CHARSET_MASK_TRANSPARENCY);
+
+	for (int h = height; h > 0; --h) {
+		int w = 0;
+		for (; w + 8 <= width; w += 8) {
+			const __m128i t = _mm_loadl_epi64((const __m128i *)(text + w));
+			if ((_mm_movemask_epi8(_mm_cmpeq_epi8(t, transparency)) & 0xFF) == 0xFF) {
+				_mm_storeu_si128((__m128i *)(dst + w * 2), _mm_loadu_si128((const __m128i *)(src + w * 2)));
+				continue;
+			}
+
+			for (int i = w; i < w + 8; ++i) {
+				if (text[i] == CHARSET_MASK_TRANSPARENCY)
+					WRITE_UINT16(dst + i * 2, READ_UINT16(src + i * 2));
+				else if (heGame)
+					error("16Bit Color HE Game using old charset");
+				else
+					WRITE_UINT16(dst + i * 2, palette[text[i]]);
+			}
+		}
+		for (; w < width; ++w) {
+			if (text[w] == CHARSET_MASK_TRANSPARENCY)
+				WRITE_UINT16(dst + w * 2, READ_UINT16(src + w * 2));
+			else if (heGame)
+				error("16Bit Color HE Game using old charset");
+			else
+				WRITE_UINT16(dst + w * 2, palette[text[w]]);
+		}
+
+		dst += width * 2;
+		src += srcPitch;
+		text += textPitch;
+	}
+}
+
+/**
+ * Copy all source pixels whose mask byte is 0xFF and leave the others alone.
+ * Mask bytes must be either 0x00 or 0xFF.
+ */
+void copyMaskedRowSSE2(byte *dst, const byte *src, const byte *mask, int count) {
+	int i = 0;
+	for (; i + 16 <= count; i += 16) {
+		const __m128i m = _mm_loadu_si128((const __m128i *)(mask + i));
+		const int bits = _mm_movemask_epi8(m);
+		if (bits == 0)
+			continue;
+
+		const __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+		if (bits == 0xFFFF) {
+			_mm_storeu_si128((__m128i *)(dst + i), s);
+		} else {
+			const __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+			_mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(_mm_and_si128(m, s), _mm_andnot_si128(m, d)));
+		}
+	}
+	for (; i < count; ++i) {
+		if (mask[i])
+			dst[i] = src[i];
+	}
+}
+
+} // End of namespace Scumm
+
+#ifdef __GNUC__
+#pragma GCC pop_options
+#endif
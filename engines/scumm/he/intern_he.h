@@ -297,7 +297,7 @@ public:
 	byte *heFindResource(uint32 tag, byte *ptr);
 	byte *findWrappedBlock(uint32 tag, byte *ptr, int state, bool flagError);
 
-	Wiz *_wiz;
+	Wiz *_wiz = nullptr;
 	bool _disableActorDrawingFlag = false;
 
 	virtual int setupStringArray(int size);
@@ -0,0 +1,237 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifdef ENABLE_HE
+
+#include "common/system.h"
+#include "scumm/he/intern_he.h"
+#include "scumm/he/wiz_he.h"
+
+namespace Scumm {
+
+static uint32 decodedStateKey(int globNum, int state) {
+	return ((uint32)globNum << 16) | (uint16)state;
+}
+
+/**
+ * Decode one TRLE line into palette indices and opacity mask. Runs which
+ * go past the image width are clipped, just like auxDecompTRLEStream() does.
+ */
+static void decodeTRLELine(byte *pixels, byte *mask, const byte *dataStream, int width) {
+	int pos = 0;
+
+	while (pos < width) {
+		int runCount = *dataStream++;
+
+		if (runCount & 1) {
+			// Transparent run, the mask is already cleared...
+			pos += runCount >> 1;
+		} else if (runCount & 2) {
+			runCount = MIN((runCount >> 2) + 1, width - pos);
+			memset(pixels + pos, *dataStream++, runCount);
+			memset(mask + pos, 0xFF, runCount);
+			pos += runCount;
+		} else {
+			const int literalCount = (runCount >> 2) + 1;
+			runCount = MIN(literalCount, width - pos);
+			memcpy(pixels + pos, dataStream, runCount);
+			memset(mask + pos, 0xFF, runCount);
+			dataStream += literalCount;
+			pos += runCount;
+		}
+	}
+}
+
+static void copyMaskedRow(byte *dst, const byte *src, const byte *mask, int count) {
+	for (int i = 0; i < count; i++) {
+		if (mask[i])
+			dst[i] = src[i];
+	}
+}
+
+const WizDecodedState *Wiz::getDecodedState(int globNum, int state, const byte *compData, int width, int height) {
+	if (!_decodedCacheEnabled || width <= 0 || height <= 0)
+		return nullptr;
+
+	const uint32 key = decodedStateKey(globNum, state);
+	const uint32 size = (uint32)width * height * 2;
+
+	Common::HashMap<uint32, WizDecodedState>::iterator it = _decodedCache.find(key);
+	if (it != _decodedCache.end()) {
+		if (it->_value.compData == compData && it->_value.width == width && it->_value.height == height) {
+			_decodedCacheStats.hits++;
+			it->_value.lastUse = ++_decodedCacheClock;
+			return &it->_value;
+		}
+
+		// The resource moved or was replaced behind our back
+		_decodedCacheSize -= (uint32)it->_value.width * it->_value.height * 2;
+		free(it->_value.pixels);
+		_decodedCache.erase(it);
+	}
+
+	_decodedCacheStats.misses++;
+
+	// Don't let a single huge image (e.g. a backdrop) flush everything else
+	if (size > _decodedCacheBudget / 4)
+		return nullptr;
+
+	// Evict the least recently used states until the new one fits...
+	while (_decodedCacheSize + size > _decodedCacheBudget && !_decodedCache.empty()) {
+		Common::HashMap<uint32, WizDecodedState>::iterator oldest = _decodedCache.begin();
+		for (it = _decodedCache.begin(); it != _decodedCache.end(); ++it) {
+			if (it->_value.lastUse < oldest->_value.lastUse)
+				oldest = it;
+		}
+
+		_decodedCacheSize -= (uint32)oldest->_value.width * oldest->_value.height * 2;
+		free(oldest->_value.pixels);
+		_decodedCache.erase(oldest);
+		_decodedCacheStats.evictions++;
+	}
+
+	byte *pixels = (byte *)malloc(size);
+	if (!pixels)
+		return nullptr;
+
+	byte *mask = pixels + width * height;
+	memset(pixels, 0, size);
+
+	const byte *lineData = compData;
+	for (int y = 0; y < height; y++) {
+		const int lineSize = READ_LE_UINT16(lineData);
+
+		if (lineSize != 0)
+			decodeTRLELine(pixels + y * width, mask + y * width, lineData + 2, width);
+
+		lineData += lineSize + 2;
+	}
+
+	WizDecodedState &decoded = _decodedCache[key];
+	decoded.compData = compData;
+	decoded.width = width;
+	decoded.height = height;
+	decoded.lastUse = ++_decodedCacheClock;
+	decoded.pixels = pixels;
+	decoded.mask = mask;
+	_decodedCacheSize += size;
+
+	return &decoded;
+}
+
+void Wiz::drawDecodedState(const WizDecodedState *decoded, WizRawPixel *bufferPtr, int bufferWidth, int bufferHeight, int x, int y, Common::Rect *clipRectPtr, const byte *remapTable, const WizRawPixel *conversionTable) {
+	Common::Rect sourceRect, destRect, clipRect, workRect;
+
+	// Same clipping as auxDecompTRLEImage()...
+	makeSizedRect(&sourceRect, decoded->width, decoded->height);
+	makeSizedRectAt(&destRect, x, y, decoded->width, decoded->height);
+
+	if (clipRectPtr) {
+		clipRect = *clipRectPtr;
+		makeSizedRect(&workRect, bufferWidth, bufferHeight);
+		if (!findRectOverlap(&clipRect, &workRect)) {
+			return;
+		}
+	} else {
+		makeSizedRect(&clipRect, bufferWidth, bufferHeight);
+	}
+
+	clipRectCoords(&sourceRect, &destRect, &clipRect);
+
+	if (destRect.right < destRect.left || destRect.bottom < destRect.top ||
+		sourceRect.right < sourceRect.left || sourceRect.bottom < sourceRect.top) {
+		return;
+	}
+
+	const int decompWidth = sourceRect.right - sourceRect.left + 1;
+	const int decompHeight = sourceRect.bottom - sourceRect.top + 1;
+	const byte *srcPixels = decoded->pixels + sourceRect.top * decoded->width + sourceRect.left;
+	const byte *srcMask = decoded->mask + sourceRect.top * decoded->width + sourceRect.left;
+
+	if (!_uses16BitColor && !remapTable) {
+		// Plain 8-bit copy: conversion is the identity, so this is a masked blit...
+		void (*copyRow)(byte *, const byte *, const byte *, int) = copyMaskedRow;
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+			copyRow = copyMaskedRowSSE2;
+#endif
+		WizRawPixel8 *dst8 = (WizRawPixel8 *)bufferPtr + destRect.top * bufferWidth + destRect.left;
+
+		for (int i = 0; i < decompHeight; i++) {
+			copyRow(dst8, srcPixels, srcMask, decompWidth);
+			dst8 += bufferWidth;
+			srcPixels += decoded->width;
+			srcMask += decoded->width;
+		}
+
+		return;
+	}
+
+	WizRawPixel8 *dst8 = (WizRawPixel8 *)bufferPtr + destRect.top * bufferWidth + destRect.left;
+	WizRawPixel16 *dst16 = (WizRawPixel16 *)bufferPtr + destRect.top * bufferWidth + destRect.left;
+
+	for (int i = 0; i < decompHeight; i++) {
+		for (int j = 0; j < decompWidth; j++) {
+			if (!srcMask[j])
+				continue;
+
+			const byte index = remapTable ? remapTable[srcPixels[j]] : srcPixels[j];
+			if (_uses16BitColor) {
+				dst16[j] = (WizRawPixel16)convert8BppToRawPixel(index, conversionTable);
+			} else {
+				dst8[j] = (WizRawPixel8)convert8BppToRawPixel(index, conversionTable);
+			}
+		}
+
+		dst8 += bufferWidth;
+		dst16 += bufferWidth;
+		srcPixels += decoded->width;
+		srcMask += decoded->width;
+	}
+}
+
+void Wiz::invalidateDecodedStates(int globNum) {
+	Common::HashMap<uint32, WizDecodedState>::iterator it = _decodedCache.begin();
+
+	while (it != _decodedCache.end()) {
+		if ((int)(it->_key >> 16) == (globNum & 0xFFFF)) {
+			_decodedCacheSize -= (uint32)it->_value.width * it->_value.height * 2;
+			free(it->_value.pixels);
+			_decodedCache.erase(it++);
+			_decodedCacheStats.invalidations++;
+		} else {
+			++it;
+		}
+	}
+}
+
+void Wiz::clearDecodedStateCache() {
+	for (Common::HashMap<uint32, WizDecodedState>::iterator it = _decodedCache.begin(); it != _decodedCache.end(); ++it)
+		free(it->_value.pixels);
+
+	_decodedCache.clear();
+	_decodedCacheSize = 0;
+}
+
+} // End of namespace Scumm
+
+#endif // ENABLE_HE
@@ -377,7 +377,18 @@ WizPxShrdBuffer Wiz::drawAWizPrimEx(int globNum, int state, int x, int y, int z,
 
 			auxDrawZplaneFromTRLEImage(_vm->getMaskBuffer(0, 0, 1), srcData + _vm->_resourceHeaderSize, destWidth, destHeight, x, y, srcWidth, srcHeight, &clipRect, kWZOIgnore, kWZOClear);
 		} else if (_vm->_game.heversion <= 98 && !(flags & (kWRFHFlip | kWRFVFlip))) {
-			if (flags & kWRFRemap) {
+			const WizDecodedState *decoded = nullptr;
+
+			// Plain and remapped images are drawn from the decoded state cache...
+			if ((flags & kWRFRemap) || !shadowPtr)
+				decoded = getDecodedState(globNum, state, srcData + _vm->_resourceHeaderSize, srcWidth, srcHeight);
+
+			if (decoded) {
+				drawDecodedState(
+					decoded, destPtr(), destWidth, destHeight, x, y, &clipRect,
+					(flags & kWRFRemap) ? remapPtr + _vm->_resourceHeaderSize + 4 : nullptr,
+					optionalColorConversionTable);
+			} else if (flags & kWRFRemap) {
 				auxDecompRemappedTRLEImage(
 					destPtr(), srcData + _vm->_resourceHeaderSize, destWidth, destHeight,
 					x, y, srcWidth, srcHeight, &clipRect, remapPtr + _vm->_resourceHeaderSize + 4,
@@ -402,11 +413,33 @@ WizPxShrdBuffer Wiz::drawAWizPrimEx(int globNum, int state, int x, int y, int z,
 			if (flags & kWRFRemap)
 				dataPtr = remapPtr + _vm->_resourceHeaderSize + 4;
 
-			trleFLIPDecompressImage(
-				destPtr(), srcData + _vm->_resourceHeaderSize, destWidth, destHeight,
-				x, y, srcWidth, srcHeight, &clipRect, flags, dataPtr,
-				optionalColorConversionTable,
-				optionalICmdPtr);
+			// Check if trleFLIPDecompressImage() would end up doing a plain
+			// forward decompression, which can be served from the cache...
+			const WizDecodedState *decoded = nullptr;
+			if (!(flags & (kWRFHFlip | kWRFVFlip))) {
+				bool plainDecomp;
+				if (_uses16BitColor) {
+					plainDecomp = !(flags & kWRFSpecialRenderBitMask) && ((flags & kWRFRemap) || !shadowPtr);
+				} else {
+					plainDecomp = !dataPtr && (!optionalColorConversionTable ||
+						optionalColorConversionTable == (WizRawPixel *)_vm->getHEPaletteSlot(1));
+				}
+
+				if (plainDecomp)
+					decoded = getDecodedState(globNum, state, srcData + _vm->_resourceHeaderSize, srcWidth, srcHeight);
+			}
+
+			if (decoded) {
+				drawDecodedState(
+					decoded, destPtr(), destWidth, destHeight, x, y, &clipRect,
+					nullptr, optionalColorConversionTable);
+			} else {
+				trleFLIPDecompressImage(
+					destPtr(), srcData + _vm->_resourceHeaderSize, destWidth, destHeight,
+					x, y, srcWidth, srcHeight, &clipRect, flags, dataPtr,
+					optionalColorConversionTable,
+					optionalICmdPtr);
+			}
 		}
 
 	} else {
@@ -488,6 +521,8 @@ void Wiz::buildAWiz(const WizPxShrdBuffer &bufPtr, int bufWidth, int bufHeight,
 	Common::Rect compRect;
 	byte *ptr;
 
+	invalidateDecodedStates(globNum);
+
 	compRect.left = 0;
 	compRect.top = 0;
 	compRect.right = bufWidth - 1;
@@ -1360,6 +1395,8 @@ void Wiz::processWizImageDrawCmd(const WizImageCommand *params) {
 void Wiz::dwCreateRawWiz(int imageNum, int w, int h, int flags, int bitsPerPixel, int optionalSpotX, int optionalSpotY) {
 	int compressionType, wizdSize;
 
+	invalidateDecodedStates(imageNum);
+
 	int globSize = _vm->_resourceHeaderSize; // AWIZ header size
 	globSize += WIZBLOCK_WIZH_SIZE;
 
@@ -2619,6 +2656,10 @@ void Wiz::processWizImageSaveCmd(const WizImageCommand *params) {
 }
 
 void Wiz::processWizImageCmd(const WizImageCommand *params) {
+	// Anything but drawing or saving may rewrite the image...
+	if (params->actionType != kWADraw && params->actionType != kWASave)
+		invalidateDecodedStates(params->image);
+
 	if (((ScummEngine_v90he *)_vm)->_logicHE && ((ScummEngine_v90he *)_vm)->_logicHE->userCodeProcessWizImageCmd(params)) {
 		return;
 	}
@@ -24,6 +24,7 @@
 
 //#define WIZ_DEBUG_BUFFERS
 
+#include "common/hashmap.h"
 #include "common/rect.h"
 
 namespace Scumm {
@@ -622,6 +623,26 @@ enum DstSurface {
 	kDstCursor   = 3
 };
 
+/**
+ * A TRLE image state decoded to palette indices and a transparency mask,
+ * so that it can be drawn again without parsing the RLE stream.
+ */
+struct WizDecodedState {
+	const byte *compData; // Compressed data this state was decoded from
+	int width;
+	int height;
+	uint32 lastUse;
+	byte *pixels;         // width * height palette indices
+	byte *mask;           // 0xFF for opaque pixels, 0x00 for transparent ones
+};
+
+struct WizDecodedCacheStats {
+	uint32 hits;
+	uint32 misses;
+	uint32 evictions;
+	uint32 invalidations;
+};
+
 class ScummEngine_v71he;
 
 class Wiz {
@@ -641,6 +662,7 @@ public:
 
 	Wiz(ScummEngine_v71he *vm);
 	~Wiz() {
+		clearDecodedStateCache();
 #ifdef WIZ_DEBUG_BUFFERS
 		WizPxShrdBuffer::dbgLeakRpt();
 #endif
@@ -652,6 +674,19 @@ public:
 	bool _uses16BitColor = false;
 	int _wizActiveShadow = 0;
 
+	// Decoded TRLE state cache (see wiz_cache_he.cpp)
+	bool _decodedCacheEnabled = true;
+	uint32 _decodedCacheBudget = 8 * 1024 * 1024;
+	uint32 _decodedCacheSize = 0;
+	uint32 _decodedCacheClock = 0;
+	WizDecodedCacheStats _decodedCacheStats = {};
+	Common::HashMap<uint32, WizDecodedState> _decodedCache;
+
+	const WizDecodedState *getDecodedState(int globNum, int state, const byte *compData, int width, int height);
+	void drawDecodedState(const WizDecodedState *decoded, WizRawPixel *bufferPtr, int bufferWidth, int bufferHeight, int x, int y, Common::Rect *clipRectPtr, const byte *remapTable, const WizRawPixel *conversionTable);
+	void invalidateDecodedStates(int globNum);
+	void clearDecodedStateCache();
+
 	void deleteLocalPolygons();
 	void polygonLoad(const uint8 *polData);
 	void set4Polygon(int id, bool flag, int vert1x, int vert1y, int vert2x, int vert2y, int vert3x, int vert3y, int vert4x, int vert4y);
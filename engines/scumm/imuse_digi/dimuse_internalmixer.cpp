@@ -49,6 +49,7 @@ IMuseDigiInternalMixer::IMuseDigiInternalMixer(Audio::Mixer *mixer, int sampleRa
 
 	_radioChatter = 0;
 	_amp8Table = nullptr;
+	_useSIMD = false;
 }
 
 IMuseDigiInternalMixer::~IMuseDigiInternalMixer() {
@@ -56,6 +57,21 @@ IMuseDigiInternalMixer::~IMuseDigiInternalMixer() {
 	_amp8Table = nullptr;
 }
 
+void IMuseDigiInternalMixer::setSIMDEnabled(bool enable) {
+#ifdef SCUMMVM_SSE2
+	_useSIMD = enable;
+#else
+	_useSIMD = false;
+#endif
+}
+
+// Recovers the gain an amplitude table row has been built with (see init()),
+// so that the vectorized kernels can compute the amplitudes on their own.
+static inline int getAmpTableGain(const int32 *ampTable, const int32 *tableBase, int rowSize) {
+	int volume = (ampTable - tableBase) / rowSize;
+	return volume ? 8 * volume - 1 : 0;
+}
+
 // Lookup table for a linear volume ramp (0 to 16) accounting for panning (-8 to 8)
 static const int8 _stereoVolumeTable[284] = {
 	0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
@@ -394,6 +410,12 @@ void IMuseDigiInternalMixer::mixBits8Mono(uint8 *srcBuf, int32 inFrameCount, int
 			mixBufCurCell[0] += *((uint16 *)ampTable + srcBuf_ptr[0]);
 			mixBufCurCell[1] += *((uint16 *)ampTable + srcBuf_ptr[0]);
 		} else {
+#ifdef SCUMMVM_SSE2
+			if (_useSIMD) {
+				mixBits8SSE2(mixBufCurCell, srcBuf, inFrameCount, getAmpTableGain(ampTable, _amp8Table, 128));
+				return;
+			}
+#endif
 			if (inFrameCount) {
 				for (int i = 0; i < inFrameCount; i++) {
 					mixBufCurCell[i] += *((int16 *)ampTable + srcBuf_ptr[i]);
@@ -412,6 +434,12 @@ void IMuseDigiInternalMixer::mixBits8Mono(uint8 *srcBuf, int32 inFrameCount, int
 					}
 				}
 			} else {
+#ifdef SCUMMVM_SSE2
+				if (_useSIMD) {
+					mixBits8SSE2(mixBufCurCell, srcBuf, feedSize, getAmpTableGain(ampTable, _amp8Table, 128));
+					return;
+				}
+#endif
 				if (feedSize) {
 					for (int i = 0; i < feedSize; i++) {
 						mixBufCurCell[i] += *((uint16 *)ampTable + srcBuf_ptr[i]);
@@ -539,6 +567,12 @@ void IMuseDigiInternalMixer::mixBits16Mono(uint8 *srcBuf, int32 inFrameCount, in
 
 	mixBufCurCell = (uint16 *)(&_mixBuf[2 * mixBufStartIndex]);
 	if (feedSize == inFrameCount) {
+#ifdef SCUMMVM_SSE2
+		if (_useSIMD) {
+			mixBits16SSE2(mixBufCurCell, (uint16 *)srcBuf, feedSize, getAmpTableGain(ampTable, _amp12Table, 2048));
+			return;
+		}
+#endif
 		if (feedSize) {
 			srcBuf_ptr = (uint16 *)srcBuf;
 			for (int i = 0; i < feedSize; i++) {
@@ -591,6 +625,12 @@ void IMuseDigiInternalMixer::mixBits8ConvertToMono(uint8 *srcBuf, int32 inFrameC
 	mixBufCurCell = (uint16 *)(&_mixBuf[2 * mixBufStartIndex]);
 	srcBuf_ptr = srcBuf;
 	if (inFrameCount == feedSize) {
+#ifdef SCUMMVM_SSE2
+		if (_useSIMD) {
+			mixBits8ConvertToMonoSSE2(mixBufCurCell, srcBuf, feedSize, getAmpTableGain(ampTable, _amp8Table, 128));
+			return;
+		}
+#endif
 		if (feedSize) {
 			for (int i = 0, j = 0; i < feedSize; i++, j += 2) {
 				mixBufCurCell[i] += (2 * *((int16 *)ampTable + srcBuf_ptr[j])) >> 1;
@@ -703,6 +743,12 @@ void IMuseDigiInternalMixer::mixBits16ConvertToMono(uint8 *srcBuf, int32 inFrame
 
 	mixBufCurCell = (uint16 *)(&_mixBuf[2 * mixBufStartIndex]);
 	if (feedSize == inFrameCount) {
+#ifdef SCUMMVM_SSE2
+		if (_useSIMD) {
+			mixBits16ConvertToMonoSSE2(mixBufCurCell, (uint16 *)srcBuf, feedSize, getAmpTableGain(ampTable, _amp12Table, 2048));
+			return;
+		}
+#endif
 		if (feedSize) {
 			srcBuf_ptr = (uint16 *)srcBuf;
 			for (int i = 0; i < feedSize; i++) {
@@ -783,6 +829,12 @@ void IMuseDigiInternalMixer::mixBits8ConvertToStereo(uint8 *srcBuf, int32 inFram
 			mixBufCurCell[3] += *((uint16 *)rightAmpTable + srcBuf_ptr[i]);
 		} else {
 			srcBuf_ptr = srcBuf;
+#ifdef SCUMMVM_SSE2
+			if (_useSIMD) {
+				mixBits8ConvertToStereoSSE2(mixBufCurCell, srcBuf, inFrameCount, getAmpTableGain(leftAmpTable, _amp8Table, 128), getAmpTableGain(rightAmpTable, _amp8Table, 128));
+				return;
+			}
+#endif
 			if (inFrameCount) {
 				for (int i = 0; i < inFrameCount; i++) {
 					mixBufCurCell[0] += *((int16 *)leftAmpTable  + srcBuf_ptr[i]);
@@ -806,6 +858,12 @@ void IMuseDigiInternalMixer::mixBits8ConvertToStereo(uint8 *srcBuf, int32 inFram
 					}
 				}
 			} else {
+#ifdef SCUMMVM_SSE2
+				if (_useSIMD) {
+					mixBits8ConvertToStereoSSE2(mixBufCurCell, srcBuf, feedSize, getAmpTableGain(leftAmpTable, _amp8Table, 128), getAmpTableGain(rightAmpTable, _amp8Table, 128));
+					return;
+				}
+#endif
 				if (feedSize) {
 					srcBuf_ptr = srcBuf;
 					for (int i = 0; i < feedSize; i++) {
@@ -1040,6 +1098,12 @@ void IMuseDigiInternalMixer::mixBits16ConvertToStereo(uint8 *srcBuf, int32 inFra
 	mixBufCurCell = (uint16 *)(&_mixBuf[2 * mixBufStartIndex]);
 
 	if (feedSize == inFrameCount) {
+#ifdef SCUMMVM_SSE2
+		if (_useSIMD) {
+			mixBits16ConvertToStereoSSE2(mixBufCurCell, (uint16 *)srcBuf, feedSize, getAmpTableGain(leftAmpTable, _amp12Table, 2048), getAmpTableGain(rightAmpTable, _amp12Table, 2048));
+			return;
+		}
+#endif
 		if (feedSize) {
 			srcBuf_tmp = (uint16 *)srcBuf;
 			for (int i = 0; i < feedSize; i++) {
@@ -1128,6 +1192,12 @@ void IMuseDigiInternalMixer::mixBits8Stereo(uint8 *srcBuf, int32 inFrameCount, i
 
 	mixBufCurCell = (uint16 *)(&_mixBuf[4 * mixBufStartIndex]);
 	if (feedSize == inFrameCount) {
+#ifdef SCUMMVM_SSE2
+		if (_useSIMD) {
+			mixBits8SSE2(mixBufCurCell, srcBuf, 2 * feedSize, getAmpTableGain(ampTable, _amp8Table, 128));
+			return;
+		}
+#endif
 		if (feedSize) {
 			srcBuf_ptr = srcBuf;
 			for (int i = 0; i < feedSize; i++) {
@@ -1305,6 +1375,12 @@ void IMuseDigiInternalMixer::mixBits16Stereo(uint8 *srcBuf, int32 inFrameCount,
 
 	mixBufCurCell = (uint16 *)(&_mixBuf[4 * mixBufStartIndex]);
 	if (feedSize == inFrameCount) {
+#ifdef SCUMMVM_SSE2
+		if (_useSIMD) {
+			mixBits16SSE2(mixBufCurCell, (uint16 *)srcBuf, 2 * feedSize, getAmpTableGain(ampTable, _amp12Table, 2048));
+			return;
+		}
+#endif
 		if (feedSize) {
 			srcBuf_ptr = (uint16 *)srcBuf;
 
@@ -42,6 +42,16 @@ class QueuingAudioStream;
 
 namespace Scumm {
 
+#ifdef SCUMMVM_SSE2
+// Vectorized kernels for the non-resampling cases, see dimuse_internalmixer_sse2.cpp
+void mixBits16SSE2(uint16 *mixBuf, const uint16 *src, int count, int gain);
+void mixBits16ConvertToStereoSSE2(uint16 *mixBuf, const uint16 *src, int count, int leftGain, int rightGain);
+void mixBits16ConvertToMonoSSE2(uint16 *mixBuf, const uint16 *src, int count, int gain);
+void mixBits8SSE2(uint16 *mixBuf, const uint8 *src, int count, int gain);
+void mixBits8ConvertToStereoSSE2(uint16 *mixBuf, const uint8 *src, int count, int leftGain, int rightGain);
+void mixBits8ConvertToMonoSSE2(uint16 *mixBuf, const uint8 *src, int count, int gain);
+#endif
+
 class IMuseDigiInternalMixer {
 
 private:
@@ -62,6 +72,7 @@ private:
 	int _stereoReverseFlag;
 	bool _isEarlyDiMUSE;
 	bool _lowLatencyMode;
+	bool _useSIMD;
 
 	void mixBits8Mono(uint8 *srcBuf, int32 inFrameCount, int feedSize, int32 mixBufStartIndex, int32 *ampTable, bool ftIs11025Hz);
 	void mixBits12Mono(uint8 *srcBuf, int32 inFrameCount, int feedSize, int32 mixBufStartIndex, int32 *ampTable);
@@ -89,6 +100,12 @@ public:
 
 	void mix(uint8 *srcBuf, int32 inFrameCount, int wordSize, int channelCount, int feedSize, int32 mixBufStartIndex, int volume, int pan, bool ftIs11025Hz);
 	int  loop(uint8 **destBuffer, int len);
+
+	// Enables the vectorized kernels for the non-resampling cases; the
+	// caller is responsible for checking that the CPU supports them.
+	void setSIMDEnabled(bool enable);
+	bool isSIMDEnabled() const { return _useSIMD; }
+
 	Audio::QueuingAudioStream *_stream;
 
 	// For low latency audio
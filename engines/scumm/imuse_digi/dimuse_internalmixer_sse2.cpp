@@ -0,0 +1,169 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <emmintrin.h>
+
+#include "scumm/imuse_digi/dimuse_engine.h"
+#include "scumm/imuse_digi/dimuse_internalmixer.h"
+
+namespace Scumm {
+
+// The amplitude tables built in IMuseDigiInternalMixer::init() are linear:
+// every entry is (int16)(x * gain / 127), with x being the sample centered
+// around zero and scaled to 12 bits. Instead of gathering from the tables,
+// the kernels below compute the very same values arithmetically. The products
+// fit in 18 bits, so the single precision division is exact up to truncation.
+
+static inline int16 scaleAmp(int x, int gain) {
+	return (int16)((x * gain) / 127);
+}
+
+static inline __m128i scaleAmpSSE2(__m128i x, __m128i gain, __m128 divisor) {
+	__m128i lo = _mm_mullo_epi16(x, gain);
+	__m128i hi = _mm_mulhi_epi16(x, gain);
+	__m128i q0 = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, hi)), divisor));
+	__m128i q1 = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, hi)), divisor));
+	return _mm_packs_epi32(q0, q1);
+}
+
+// 16-bit samples index the 12-bit table with their upper 12 bits
+static inline __m128i load16SSE2(const uint16 *src) {
+	return _mm_srai_epi16(_mm_loadu_si128((const __m128i *)src), 4);
+}
+
+// 8-bit samples are unsigned, and their table rows step by 16 * gain
+static inline __m128i unpack8SSE2(__m128i bytes, __m128i zero, __m128i center) {
+	return _mm_slli_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(bytes, zero), center), 4);
+}
+
+static inline void addToMixBuf(uint16 *mixBuf, __m128i amp) {
+	_mm_storeu_si128((__m128i *)mixBuf, _mm_add_epi16(_mm_loadu_si128((const __m128i *)mixBuf), amp));
+}
+
+void mixBits16SSE2(uint16 *mixBuf, const uint16 *src, int count, int gain) {
+	const __m128i gainVec = _mm_set1_epi16(gain);
+	const __m128 divisor = _mm_set1_ps(127.0f);
+	int i = 0;
+
+	for (; i + 8 <= count; i += 8)
+		addToMixBuf(mixBuf + i, scaleAmpSSE2(load16SSE2(src + i), gainVec, divisor));
+
+	for (; i < count; i++)
+		mixBuf[i] += scaleAmp((int16)src[i] >> 4, gain);
+}
+
+void mixBits16ConvertToStereoSSE2(uint16 *mixBuf, const uint16 *src, int count, int leftGain, int rightGain) {
+	const __m128i leftGainVec = _mm_set1_epi16(leftGain);
+	const __m128i rightGainVec = _mm_set1_epi16(rightGain);
+	const __m128 divisor = _mm_set1_ps(127.0f);
+	int i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m128i x = load16SSE2(src + i);
+		__m128i left = scaleAmpSSE2(x, leftGainVec, divisor);
+		__m128i right = scaleAmpSSE2(x, rightGainVec, divisor);
+		addToMixBuf(mixBuf + 2 * i, _mm_unpacklo_epi16(left, right));
+		addToMixBuf(mixBuf + 2 * i + 8, _mm_unpackhi_epi16(left, right));
+	}
+
+	for (; i < count; i++) {
+		int x = (int16)src[i] >> 4;
+		mixBuf[2 * i]     += scaleAmp(x, leftGain);
+		mixBuf[2 * i + 1] += scaleAmp(x, rightGain);
+	}
+}
+
+void mixBits16ConvertToMonoSSE2(uint16 *mixBuf, const uint16 *src, int count, int gain) {
+	const __m128i gainVec = _mm_set1_epi16(gain);
+	const __m128i ones = _mm_set1_epi16(1);
+	const __m128 divisor = _mm_set1_ps(127.0f);
+	int i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		// Sum each left/right pair in 32 bits before halving it
+		__m128i sum0 = _mm_madd_epi16(scaleAmpSSE2(load16SSE2(src + 2 * i), gainVec, divisor), ones);
+		__m128i sum1 = _mm_madd_epi16(scaleAmpSSE2(load16SSE2(src + 2 * i + 8), gainVec, divisor), ones);
+		addToMixBuf(mixBuf + i, _mm_packs_epi32(_mm_srai_epi32(sum0, 1), _mm_srai_epi32(sum1, 1)));
+	}
+
+	for (; i < count; i++)
+		mixBuf[i] += (scaleAmp((int16)src[2 * i] >> 4, gain) + scaleAmp((int16)src[2 * i + 1] >> 4, gain)) >> 1;
+}
+
+void mixBits8SSE2(uint16 *mixBuf, const uint8 *src, int count, int gain) {
+	const __m128i gainVec = _mm_set1_epi16(gain);
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i center = _mm_set1_epi16(128);
+	const __m128 divisor = _mm_set1_ps(127.0f);
+	int i = 0;
+
+	for (; i + 16 <= count; i += 16) {
+		__m128i bytes = _mm_loadu_si128((const __m128i *)(src + i));
+		addToMixBuf(mixBuf + i, scaleAmpSSE2(unpack8SSE2(bytes, zero, center), gainVec, divisor));
+		addToMixBuf(mixBuf + i + 8, scaleAmpSSE2(unpack8SSE2(_mm_srli_si128(bytes, 8), zero, center), gainVec, divisor));
+	}
+
+	for (; i < count; i++)
+		mixBuf[i] += scaleAmp((src[i] - 128) * 16, gain);
+}
+
+void mixBits8ConvertToStereoSSE2(uint16 *mixBuf, const uint8 *src, int count, int leftGain, int rightGain) {
+	const __m128i leftGainVec = _mm_set1_epi16(leftGain);
+	const __m128i rightGainVec = _mm_set1_epi16(rightGain);
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i center = _mm_set1_epi16(128);
+	const __m128 divisor = _mm_set1_ps(127.0f);
+	int i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m128i x = unpack8SSE2(_mm_loadl_epi64((const __m128i *)(src + i)), zero, center);
+		__m128i left = scaleAmpSSE2(x, leftGainVec, divisor);
+		__m128i right = scaleAmpSSE2(x, rightGainVec, divisor);
+		addToMixBuf(mixBuf + 2 * i, _mm_unpacklo_epi16(left, right));
+		addToMixBuf(mixBuf + 2 * i + 8, _mm_unpackhi_epi16(left, right));
+	}
+
+	for (; i < count; i++) {
+		int x = (src[i] - 128) * 16;
+		mixBuf[2 * i]     += scaleAmp(x, leftGain);
+		mixBuf[2 * i + 1] += scaleAmp(x, rightGain);
+	}
+}
+
+void mixBits8ConvertToMonoSSE2(uint16 *mixBuf, const uint8 *src, int count, int gain) {
+	// Like the original code, only the left channel is taken into account
+	const __m128i gainVec = _mm_set1_epi16(gain);
+	const __m128i evenBytes = _mm_set1_epi16(0x00FF);
+	const __m128i center = _mm_set1_epi16(128);
+	const __m128 divisor = _mm_set1_ps(127.0f);
+	int i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m128i left = _mm_and_si128(_mm_loadu_si128((const __m128i *)(src + 2 * i)), evenBytes);
+		__m128i x = _mm_slli_epi16(_mm_sub_epi16(left, center), 4);
+		addToMixBuf(mixBuf + i, scaleAmpSSE2(x, gainVec, divisor));
+	}
+
+	for (; i < count; i++)
+		mixBuf[i] += scaleAmp((src[2 * i] - 128) * 16, gain);
+}
+
+} // End of namespace Scumm
@@ -20,6 +20,7 @@ MODULE_OBJS := \
 	gfx_mac.o \
 	gfx_towns.o \
 	gfx.o \
+	gfx_composite.o \
 	he/mixer_he.o \
 	he/resource_he.o \
 	he/script_v60he.o \
@@ -132,6 +133,12 @@ MODULE_OBJS += \
 	smush/codec47ARM.o
 endif
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	imuse_digi/dimuse_internalmixer_sse2.o
+$(MODULE)/imuse_digi/dimuse_internalmixer_sse2.o: CXXFLAGS += -msse2
+endif
+
 endif
 
 ifdef USE_ARM_GFX_ASM
@@ -139,6 +146,12 @@ MODULE_OBJS += \
 	gfxARM.o
 endif
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	gfx_sse2.o
+$(MODULE)/gfx_sse2.o: CXXFLAGS += -msse2
+endif
+
 ifdef ENABLE_HE
 MODULE_OBJS += \
 	he/animation_he.o \
@@ -157,6 +170,7 @@ MODULE_OBJS += \
 	he/script_v90he.o \
 	he/script_v100he.o \
 	he/sprite_he.o \
+	he/wiz_cache_he.o \
 	he/wiz_he.o \
 	he/wizwarp_he.o \
 	he/localizer.o \
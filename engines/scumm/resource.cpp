@@ -938,6 +938,11 @@ void ResourceManager::nukeResource(ResType type, ResId idx) {
 		debugC(DEBUG_RESOURCE, "nukeResource(%s,%d)", nameOfResType(type), idx);
 		_allocatedSize -= _types[type][idx]._size;
 		_types[type][idx].nuke();
+#ifdef ENABLE_HE
+		// Drop any decoded copies of the image states
+		if (type == rtImage && _vm->_game.heversion >= 71 && ((ScummEngine_v71he *)_vm)->_wiz)
+			((ScummEngine_v71he *)_vm)->_wiz->invalidateDecodedStates(idx);
+#endif
 	}
 }
 
@@ -723,6 +723,7 @@ ScummEngine_v71he::ScummEngine_v71he(OSystem *syst, const DetectorResult &dr)
 
 ScummEngine_v71he::~ScummEngine_v71he() {
 	delete _wiz;
+	_wiz = nullptr;
 }
 
 ScummEngine_v72he::ScummEngine_v72he(OSystem *syst, const DetectorResult &dr)
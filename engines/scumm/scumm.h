@@ -917,6 +917,21 @@ protected:
 	bool _showStack = false;
 	bool _debugMode = false;
 
+	/**
+	 * Per-room strip composition statistics, collected by drawStripToScreen()
+	 * while enabled through the "strips" debugger command.
+	 */
+	struct StripCostStats {
+		uint32 frames = 0;
+		uint32 blits = 0;
+		uint64 pixels = 0;
+		uint64 maxFramePixels = 0;
+	};
+	bool _stripCostAccounting = false;
+	uint32 _frameStripBlits = 0;
+	uint64 _frameStripPixels = 0;
+	Common::HashMap<int, StripCostStats> _stripCostStats;
+
 	// Save/Load class - some of this may be GUI
 	byte _saveLoadFlag = 0, _saveLoadSlot = 0;
 	uint32 _lastSaveTime = 0;
@@ -1416,6 +1431,7 @@ protected:
 	virtual void drawDirtyScreenParts();
 	void updateDirtyScreen(VirtScreenNumber slot);
 	void drawStripToScreen(VirtScreen *vs, int x, int width, int top, int bottom);
+	void accountStripCost();
 
 	void mac_markScreenAsDirty(int x, int y, int w, int h);
 	void mac_drawStripToScreen(VirtScreen *vs, int top, int x, int y, int width, int height);
@@ -42,6 +42,8 @@ FMVScreen::FMVScreen(Gfx::Driver *gfx, Cursor *cursor) :
 
 	_decoder = new Video::BinkDecoder();
 	_decoder->setSoundType(Audio::Mixer::kSFXSoundType);
+	// Full screen videos are decoded ahead, so the game loop doesn't stall on them
+	_decoder->setDecodeAhead(4);
 
 	_surfaceRenderer = _gfx->createSurfaceRenderer();
 }
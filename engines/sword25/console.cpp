@@ -21,14 +21,33 @@
 
 #include "sword25/console.h"
 #include "sword25/sword25.h"
+#include "sword25/gfx/graphicengine.h"
+#include "sword25/kernel/kernel.h"
 
 namespace Sword25 {
 
 Sword25Console::Sword25Console(Sword25Engine *vm) : GUI::Debugger(), _vm(vm) {
 	assert(_vm);
+
+	registerCmd("render_stats", WRAP_METHOD(Sword25Console, Cmd_RenderStats));
 }
 
 Sword25Console::~Sword25Console() {
 }
 
+bool Sword25Console::Cmd_RenderStats(int argc, const char **argv) {
+	GraphicEngine *gfx = Kernel::getInstance()->getGfx();
+	if (!gfx) {
+		debugPrintf("The graphics engine is not initialized\n");
+		return true;
+	}
+
+	const GraphicEngine::RenderStats &stats = gfx->getLastFrameStats();
+	debugPrintf("Last frame:\n");
+	debugPrintf("  Dirty rectangles: %u (%u pixels)\n", stats.dirtyRects, stats.dirtyArea);
+	debugPrintf("  Objects drawn: %u, skipped as occluded: %u\n", stats.objectsDrawn, stats.objectsOccluded);
+	debugPrintf("  Pixels blended: %u\n", stats.pixelsBlended);
+	return true;
+}
+
 } // End of namespace Sword25
@@ -35,6 +35,8 @@ public:
 
 private:
 	Sword25Engine *_vm;
+
+	bool Cmd_RenderStats(int argc, const char **argv);
 };
 
 } // End of namespace Sword25
@@ -72,9 +72,14 @@ GraphicEngine::GraphicEngine(Kernel *pKernel) :
 	_timerActive(true),
 	_frameTimeSampleSlot(0),
 	_thumbnail(NULL),
+	_useSIMD(false),
 	ResourceService(pKernel) {
 	_frameTimeSamples.resize(FRAMETIME_SAMPLE_COUNT);
 
+#ifdef SCUMMVM_SSE2
+	_useSIMD = g_system->hasFeature(OSystem::kFeatureCpuSSE2);
+#endif
+
 	if (!registerScriptBindings())
 		error("Script bindings could not be registered.");
 	else
@@ -144,7 +149,9 @@ bool GraphicEngine::endFrame() {
 		return true;
 #endif
 
+	_renderStats = RenderStats();
 	_renderObjectManagerPtr->render();
+	_lastFrameStats = _renderStats;
 
 	g_system->updateScreen();
 
@@ -185,6 +192,14 @@ bool GraphicEngine::fill(const Common::Rect *fillRectPtr, uint color) {
 		if (ca == 0xff) {
 			_backSurface.fillRect(rect, _backSurface.format.ARGBToColor(ca, cr, cg, cb));
 		} else {
+			_renderStats.pixelsBlended += rect.width() * rect.height();
+#ifdef SCUMMVM_SSE2
+			if (_useSIMD) {
+				blendFillSSE2((byte *)_backSurface.getBasePtr(rect.left, rect.top), _backSurface.pitch,
+				              rect.width(), rect.height(), ca, cr, cg, cb);
+				return true;
+			}
+#endif
 			byte *outo = (byte *)_backSurface.getBasePtr(rect.left, rect.top);
 			byte *out;
 
@@ -75,6 +75,11 @@ class RenderObjectManager;
 #define BS_RGB(R,G,B)       (BS_AMASK | ((R) << BS_RSHIFT) | ((G) << BS_GSHIFT) | ((B) << BS_BSHIFT))
 #define BS_ARGB(A,R,G,B)    (((A) << BS_ASHIFT) | ((R) << BS_RSHIFT) | ((G) << BS_GSHIFT) | ((B) << BS_BSHIFT))
 
+#ifdef SCUMMVM_SSE2
+// Vectorized translucent fill, see graphicengine_sse2.cpp
+void blendFillSSE2(byte *dst, uint pitch, int width, int height, byte ca, byte cr, byte cg, byte cb);
+#endif
+
 /**
  * This is the graphics engine. Unlike the original code, this is not
  * an interface that needs to be subclassed, but rather already contains
@@ -217,6 +222,29 @@ public:
 	Graphics::ManagedSurface _backSurface;
 	Graphics::ManagedSurface *getSurface() { return &_backSurface; }
 
+	/**
+	 * Counters of the work done to render a frame
+	 */
+	struct RenderStats {
+		uint32 dirtyRects;
+		uint32 dirtyArea;
+		uint32 objectsDrawn;
+		uint32 objectsOccluded;
+		uint32 pixelsBlended;
+
+		RenderStats() : dirtyRects(0), dirtyArea(0), objectsDrawn(0), objectsOccluded(0), pixelsBlended(0) {}
+	};
+
+	/**
+	 * Returns the counters of the frame currently being rendered
+	 */
+	RenderStats &getRenderStats() { return _renderStats; }
+
+	/**
+	 * Returns the counters of the last rendered frame
+	 */
+	const RenderStats &getLastFrameStats() const { return _lastFrameStats; }
+
 	Common::SeekableReadStream *_thumbnail;
 	Common::SeekableReadStream *getThumbnail() { return _thumbnail; }
 
@@ -266,6 +294,10 @@ private:
 
 	Common::ScopedPtr<RenderObjectManager> _renderObjectManagerPtr;
 
+	RenderStats _renderStats;
+	RenderStats _lastFrameStats;
+	bool _useSIMD;
+
     bool _isRTL;
 
 	struct DebugLine {
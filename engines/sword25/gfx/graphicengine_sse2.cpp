@@ -0,0 +1,79 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * This code is based on Broken Sword 2.5 engine
+ *
+ * Copyright (c) Malte Thiesen, Daniel Queteschiner and Michael Elsdoerfer
+ *
+ * Licensed under GNU GPL v2
+ *
+ */
+
+#include <emmintrin.h>
+
+#include "sword25/gfx/graphicengine.h"
+
+namespace Sword25 {
+
+// Computes the same values as the scalar loop of GraphicEngine::fill():
+// only the low byte of ((c - out) * ca) >> 8 is kept there, and that byte
+// is completely contained in the low 16 bits of the product. The pixels
+// are in memory order A, B, G, R, as SSE2 is only available on little
+// endian targets.
+
+void blendFillSSE2(byte *dst, uint pitch, int width, int height, byte ca, byte cr, byte cg, byte cb) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i color = _mm_setr_epi16(0, cb, cg, cr, 0, cb, cg, cr);
+	const __m128i alpha = _mm_set1_epi16(ca);
+	const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+	const __m128i alphaMask = _mm_set1_epi32(0x000000FF);
+
+	for (int y = 0; y < height; y++) {
+		byte *out = dst;
+		int x = 0;
+
+		for (; x + 4 <= width; x += 4) {
+			const __m128i pixels = _mm_loadu_si128((const __m128i *)out);
+			__m128i lo = _mm_unpacklo_epi8(pixels, zero);
+			__m128i hi = _mm_unpackhi_epi8(pixels, zero);
+
+			lo = _mm_add_epi16(lo, _mm_srli_epi16(_mm_mullo_epi16(_mm_sub_epi16(color, lo), alpha), 8));
+			hi = _mm_add_epi16(hi, _mm_srli_epi16(_mm_mullo_epi16(_mm_sub_epi16(color, hi), alpha), 8));
+
+			const __m128i result = _mm_packus_epi16(_mm_and_si128(lo, lowBytes), _mm_and_si128(hi, lowBytes));
+			_mm_storeu_si128((__m128i *)out, _mm_or_si128(result, alphaMask));
+			out += 16;
+		}
+
+		for (; x < width; x++) {
+			out[0] = 255;
+			out[1] += (byte)(((cb - out[1]) * ca) >> 8);
+			out[2] += (byte)(((cg - out[2]) * ca) >> 8);
+			out[3] += (byte)(((cr - out[3]) * ca) >> 8);
+			out += 4;
+		}
+
+		dst += pitch;
+	}
+}
+
+} // End of namespace Sword25
@@ -229,9 +229,36 @@ bool RenderedImage::blit(int posX, int posY, int flipping, Common::Rect *pPartRe
 	int cg = (color >> BS_GSHIFT) & 0xff;
 	int cb = (color >> BS_BSHIFT) & 0xff;
 
-	if (width == -1) width = pPartRect ? pPartRect->width() : _surface.w;
-	if (height == -1) height = pPartRect ? pPartRect->height() : _surface.h;
-	_surface.blendBlitTo(*_backSurface, posX, posY, newFlipping, pPartRect, _surface.format.ARGBToColor(ca, cr, cg, cb), width, height, Graphics::BLEND_NORMAL, _alphaType);
+	const int srcWidth = pPartRect ? pPartRect->width() : _surface.w;
+	const int srcHeight = pPartRect ? pPartRect->height() : _surface.h;
+	if (width == -1) width = srcWidth;
+	if (height == -1) height = srcHeight;
+
+	const uint colorMod = _surface.format.ARGBToColor(ca, cr, cg, cb);
+	const Common::Rect dstRect(posX, posY, posX + width, posY + height);
+	GraphicEngine::RenderStats &stats = Kernel::getInstance()->getGfx()->getRenderStats();
+
+	// Only blend the pixels inside the update rectangles. These never overlap,
+	// so every pixel is still blended once. The source offsets of blits which
+	// are both scaled and flipped depend on the clipping, so these are drawn as
+	// a whole to keep them pixel exact.
+	const bool scaled = width != srcWidth || height != srcHeight;
+	if (updateRects && !(scaled && newFlipping != Graphics::FLIP_NONE)) {
+		for (RectangleList::iterator it = updateRects->begin(); it != updateRects->end(); ++it) {
+			Common::Rect clipRect = dstRect.findIntersectingRect(*it);
+			clipRect.clip(Common::Rect(_backSurface->w, _backSurface->h));
+			if (clipRect.isEmpty())
+				continue;
+
+			Graphics::Surface target = _backSurface->getSubArea(clipRect);
+			_surface.blendBlitTo(target, posX - clipRect.left, posY - clipRect.top, newFlipping, pPartRect, colorMod, width, height, Graphics::BLEND_NORMAL, _alphaType);
+			stats.pixelsBlended += clipRect.width() * clipRect.height();
+		}
+		return true;
+	}
+
+	Common::Rect rendered = _surface.blendBlitTo(*_backSurface, posX, posY, newFlipping, pPartRect, colorMod, width, height, Graphics::BLEND_NORMAL, _alphaType);
+	stats.pixelsBlended += rendered.width() * rendered.height();
 
 	return true;
 }
@@ -127,28 +127,44 @@ void RenderObject::preRender(RenderObjectQueue *renderQueue) {
 
 }
 
-bool RenderObject::render(RectangleList *updateRects, const Common::Array<int> &updateRectsMinZ) {
+bool RenderObject::render(RectangleList *updateRects, const Common::Array<RenderOccluder> &occluders, uint &renderIndex) {
 
 	// Falls das Objekt nicht sichtbar ist, muss gar nichts gezeichnet werden
 	if (!_visible)
 		return true;
 
-	// Objekt zeichnen.
-	bool needRender = false;
-	int index = 0;
+	const uint index = renderIndex++;
 
-	// Only draw if the bounding box intersects any update rectangle and
-	// the object is in front of the minimum Z value.
-	for (RectangleList::iterator rectIt = updateRects->begin(); !needRender && rectIt != updateRects->end(); ++rectIt, ++index)
-		needRender = (_bbox.contains(*rectIt) || _bbox.intersects(*rectIt)) && getAbsoluteZ() >= updateRectsMinZ[index];
+	// Only draw within the update rectangles the bounding box intersects,
+	// and skip those where a solid object rendered later covers the object.
+	RectangleList visibleRects;
+	bool intersects = false;
+	for (RectangleList::iterator rectIt = updateRects->begin(); rectIt != updateRects->end(); ++rectIt) {
+		if (!_bbox.intersects(*rectIt))
+			continue;
+		intersects = true;
 
-	if (needRender)
-		doRender(updateRects);
+		const Common::Rect area = _bbox.findIntersectingRect(*rectIt);
+		bool occluded = false;
+		for (uint i = 0; !occluded && i < occluders.size(); ++i)
+			occluded = occluders[i]._renderIndex > index && occluders[i]._bbox.contains(area);
+
+		if (!occluded)
+			visibleRects.push_back(*rectIt);
+	}
+
+	GraphicEngine::RenderStats &stats = Kernel::getInstance()->getGfx()->getRenderStats();
+	if (!visibleRects.empty()) {
+		doRender(&visibleRects);
+		++stats.objectsDrawn;
+	} else if (intersects) {
+		++stats.objectsOccluded;
+	}
 
 	// Draw all children
 	RENDEROBJECT_ITER it = _children.begin();
 	for (; it != _children.end(); ++it)
-		if (!(*it)->render(updateRects, updateRectsMinZ))
+		if (!(*it)->render(updateRects, occluders, renderIndex))
 			return false;
 
 	return true;
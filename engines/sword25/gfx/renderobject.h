@@ -61,6 +61,15 @@ class AnimationTemplate;
 class Panel;
 class Text;
 
+/**
+	@brief A solid object, which hides everything rendered before it within its bounding box.
+ */
+struct RenderOccluder {
+	Common::Rect _bbox;
+	uint _renderIndex;
+	RenderOccluder(const Common::Rect &bbox, uint renderIndex) : _bbox(bbox), _renderIndex(renderIndex) {}
+};
+
 // Klassendefinition
 /**
 	@brief  Dieses ist die Klasse die sämtliche sichtbaren Objekte beschreibt.
@@ -222,8 +231,11 @@ public:
 	    @remark Vor jedem Aufruf dieser Methode muss ein Aufruf von UpdateObjectState() erfolgt sein.
 	            Dieses kann entweder direkt geschehen oder durch den Aufruf von UpdateObjectState() an einem Vorfahren-Objekt.<br>
 	            Diese Methode darf nur von BS_RenderObjectManager aufgerufen werden.
+	    @param updateRects the rectangles which need to be redrawn
+	    @param occluders the solid objects of the frame, in render order
+	    @param renderIndex the position of this object in the render order, incremented for every visible object
 	*/
-	bool render(RectangleList *updateRects, const Common::Array<int> &updateRectsMinZ);
+	bool render(RectangleList *updateRects, const Common::Array<RenderOccluder> &occluders, uint &renderIndex);
 
 	/**
 	    @brief Bereitet das Objekt und alle seine Unterobjekte auf einen Rendervorgang vor.
@@ -115,26 +115,32 @@ bool RenderObjectManager::render() {
 	}
 
 	RectangleList *updateRects = _uta->getRectangles();
-	Common::Array<int> updateRectsMinZ;
 
-	updateRectsMinZ.reserve(updateRects->size());
-
-	// Calculate the minimum drawing Z value of each update rectangle
-	// Solid bitmaps with a Z order less than the value calculated here would be overdrawn again and
-	// so don't need to be drawn in the first place which speeds things up a bit.
+	GraphicEngine::RenderStats &stats = Kernel::getInstance()->getGfx()->getRenderStats();
 	for (RectangleList::iterator rectIt = updateRects->begin(); rectIt != updateRects->end(); ++rectIt) {
-		int minZ = 0;
-		for (RenderObjectQueue::iterator it = _currQueue->reverse_begin(); it != _currQueue->end(); --it) {
-			if ((*it)._renderObject->isVisible() && (*it)._renderObject->isSolid() &&
-				(*it)._renderObject->getBbox().contains(*rectIt)) {
-				minZ = (*it)._renderObject->getAbsoluteZ();
+		++stats.dirtyRects;
+		stats.dirtyArea += (*rectIt).width() * (*rectIt).height();
+	}
+
+	// Collect the solid objects touching any update rectangle. Everything rendered before them
+	// within their bounding box would be overdrawn again, and so doesn't need to be drawn in
+	// the first place. The render queue is in render order.
+	Common::Array<RenderOccluder> occluders;
+	uint renderIndex = 0;
+	for (RenderObjectQueue::iterator it = _currQueue->begin(); it != _currQueue->end(); ++it, ++renderIndex) {
+		if (!(*it)._renderObject->isVisible() || !(*it)._renderObject->isSolid())
+			continue;
+
+		for (RectangleList::iterator rectIt = updateRects->begin(); rectIt != updateRects->end(); ++rectIt) {
+			if ((*it)._bbox.intersects(*rectIt)) {
+				occluders.push_back(RenderOccluder((*it)._bbox, renderIndex));
 				break;
 			}
 		}
-		updateRectsMinZ.push_back(minZ);
 	}
 
-	if (_rootPtr->render(updateRects, updateRectsMinZ)) {
+	renderIndex = 0;
+	if (_rootPtr->render(updateRects, occluders, renderIndex)) {
 		// Copy updated rectangles to the video screen
 		Graphics::ManagedSurface *backSurface = Kernel::getInstance()->getGfx()->getSurface();
 		for (RectangleList::iterator rectIt = updateRects->begin(); rectIt != updateRects->end(); ++rectIt) {
@@ -35,14 +35,14 @@
 namespace Sword25 {
 
 InputPersistenceBlock::InputPersistenceBlock(const void *data, uint dataLength, int version) :
-	_data(static_cast<const byte *>(data), dataLength),
+	_dataEnd(static_cast<const byte *>(data) + dataLength),
+	_iter(static_cast<const byte *>(data)),
 	_errorState(NONE),
 	_version(version) {
-	_iter = _data.begin();
 }
 
 InputPersistenceBlock::~InputPersistenceBlock() {
-	if (_iter != _data.end())
+	if (_iter != _dataEnd)
 		warning("Persistence block was not read to the end.");
 }
 
@@ -117,8 +117,23 @@ void InputPersistenceBlock::readByteArray(Common::Array<byte> &value) {
 	}
 }
 
+Common::MemoryReadStream *InputPersistenceBlock::readByteArrayStream() {
+	uint32 size = 0;
+
+	if (checkMarker(BLOCK_MARKER)) {
+		read(size);
+
+		if (!checkBlockSize(size))
+			size = 0;
+	}
+
+	Common::MemoryReadStream *stream = new Common::MemoryReadStream(_iter, size, DisposeAfterUse::NO);
+	_iter += size;
+	return stream;
+}
+
 bool InputPersistenceBlock::checkBlockSize(int size) {
-	if (_data.end() - _iter >= size) {
+	if (_dataEnd - _iter >= size) {
 		return true;
 	} else {
 		_errorState = END_OF_DATA;
@@ -32,6 +32,7 @@
 #define SWORD25_INPUTPERSISTENCEBLOCK_H
 
 #include "common/array.h"
+#include "common/memstream.h"
 #include "sword25/kernel/common.h"
 #include "sword25/kernel/persistenceblock.h"
 
@@ -45,6 +46,9 @@ public:
 		OUT_OF_SYNC
 	};
 
+	/**
+	 * Constructor. The data isn't copied, and has to remain valid as long as the block is read
+	 */
 	InputPersistenceBlock(const void *data, uint dataLength, int version);
 	virtual ~InputPersistenceBlock();
 
@@ -56,6 +60,12 @@ public:
 	void readString(Common::String &value);
 	void readByteArray(Common::Array<byte> &value);
 
+	/**
+	 * Reads a data block without copying it. The returned stream refers to
+	 * the data of this block, and has to be deleted by the caller
+	 */
+	Common::MemoryReadStream *readByteArrayStream();
+
 	bool isGood() const {
 		return _errorState == NONE;
 	}
@@ -69,8 +79,8 @@ private:
 	bool checkMarker(byte marker);
 	bool checkBlockSize(int size);
 
-	Common::Array<byte> _data;
-	Common::Array<byte>::const_iterator _iter;
+	const byte *_dataEnd;
+	const byte *_iter;
 	ErrorState _errorState;
 
 	int _version;
@@ -28,6 +28,9 @@
  *
  */
 
+#include "common/algorithm.h"
+#include "common/endian.h"
+
 #include "sword25/kernel/outputpersistenceblock.h"
 
 namespace {
@@ -98,9 +101,34 @@ void OutputPersistenceBlock::writeMarker(byte marker) {
 void OutputPersistenceBlock::rawWrite(const void *dataPtr, size_t size) {
 	if (size > 0) {
 		uint oldSize = _data.size();
+		// Grow the buffer geometrically, resize() alone only allocates what's needed
+		_data.reserve(Common::nextHigher2(oldSize + size));
 		_data.resize(oldSize + size);
 		memcpy(&_data[oldSize], dataPtr, size);
 	}
 }
 
+OutputPersistenceBlock::BlockWriteStream::BlockWriteStream(OutputPersistenceBlock &block) : _block(block) {
+	// Same layout as write(const void *, uint32), with the size left blank for now
+	_block.writeMarker(BLOCK_MARKER);
+	_block.writeMarker(UINT_MARKER);
+	_sizeOffset = _block._data.size();
+
+	uint32 size = 0;
+	_block.rawWrite(&size, sizeof(size));
+}
+
+OutputPersistenceBlock::BlockWriteStream::~BlockWriteStream() {
+	WRITE_LE_UINT32(&_block._data[_sizeOffset], (uint32)pos());
+}
+
+uint32 OutputPersistenceBlock::BlockWriteStream::write(const void *dataPtr, uint32 dataSize) {
+	_block.rawWrite(dataPtr, dataSize);
+	return dataSize;
+}
+
+int64 OutputPersistenceBlock::BlockWriteStream::pos() const {
+	return _block._data.size() - _sizeOffset - sizeof(uint32);
+}
+
 } // End of namespace Sword25
@@ -31,6 +31,7 @@
 #ifndef SWORD25_OUTPUTPERSISTENCEBLOCK_H
 #define SWORD25_OUTPUTPERSISTENCEBLOCK_H
 
+#include "common/stream.h"
 #include "sword25/kernel/common.h"
 #include "sword25/kernel/persistenceblock.h"
 
@@ -38,6 +39,24 @@ namespace Sword25 {
 
 class OutputPersistenceBlock : public PersistenceBlock {
 public:
+	/**
+	 * Stream writing a data block straight into a persistence block, so that
+	 * large blocks don't have to be buffered separately first. The size of
+	 * the block is filled in once the stream is destroyed.
+	 */
+	class BlockWriteStream : public Common::WriteStream {
+	public:
+		BlockWriteStream(OutputPersistenceBlock &block);
+		~BlockWriteStream() override;
+
+		uint32 write(const void *dataPtr, uint32 dataSize) override;
+		int64 pos() const override;
+
+	private:
+		OutputPersistenceBlock &_block;
+		uint _sizeOffset;
+	};
+
 	OutputPersistenceBlock();
 
 	void write(const void *data, uint32 size);
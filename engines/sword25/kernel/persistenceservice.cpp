@@ -372,8 +372,13 @@ bool PersistenceService::loadGame(uint slotID) {
 	}
 #endif
 
-	byte *compressedDataBuffer = new byte[curSavegameInfo.gamedataLength];
-	byte *uncompressedDataBuffer = new byte[curSavegameInfo.gamedataUncompressedLength];
+	// Newer saved games have uncompressed game data, which is read as-is.
+	// The whole stored data is read, even if it is longer than needed.
+	unsigned long uncompressedBufferSize = curSavegameInfo.gamedataUncompressedLength;
+	bool compressed = uncompressedBufferSize > curSavegameInfo.gamedataLength;
+
+	byte *uncompressedDataBuffer = new byte[MAX(curSavegameInfo.gamedataUncompressedLength, curSavegameInfo.gamedataLength)];
+	byte *compressedDataBuffer = compressed ? new byte[curSavegameInfo.gamedataLength] : uncompressedDataBuffer;
 	Common::String filename = generateSavegameFilename(slotID);
 	file = sfm->openForLoading(filename);
 
@@ -381,15 +386,14 @@ bool PersistenceService::loadGame(uint slotID) {
 	file->read(reinterpret_cast<char *>(&compressedDataBuffer[0]), curSavegameInfo.gamedataLength);
 	if (file->err()) {
 		error("Unable to load the gamedata from the savegame file \"%s\".", filename.c_str());
-		delete[] compressedDataBuffer;
+		if (compressed)
+			delete[] compressedDataBuffer;
 		delete[] uncompressedDataBuffer;
 		return false;
 	}
 
 	// Uncompress game data, if needed.
-	unsigned long uncompressedBufferSize = curSavegameInfo.gamedataUncompressedLength;
-
-	if (uncompressedBufferSize > curSavegameInfo.gamedataLength) {
+	if (compressed) {
 		// Older saved game, where the game data was compressed again.
 		if (!Common::inflateZlib(reinterpret_cast<byte *>(&uncompressedDataBuffer[0]), &uncompressedBufferSize,
 					   reinterpret_cast<byte *>(&compressedDataBuffer[0]), curSavegameInfo.gamedataLength)) {
@@ -399,9 +403,8 @@ bool PersistenceService::loadGame(uint slotID) {
 			delete file;
 			return false;
 		}
-	} else {
-		// Newer saved game with uncompressed game data, copy it as-is.
-		memcpy(uncompressedDataBuffer, compressedDataBuffer, uncompressedBufferSize);
+
+		delete[] compressedDataBuffer;
 	}
 
 	InputPersistenceBlock reader(&uncompressedDataBuffer[0], curSavegameInfo.gamedataUncompressedLength, curSavegameInfo.version);
@@ -415,7 +418,6 @@ bool PersistenceService::loadGame(uint slotID) {
 	success &= Kernel::getInstance()->getSfx()->unpersist(reader);
 	success &= Kernel::getInstance()->getInput()->unpersist(reader);
 
-	delete[] compressedDataBuffer;
 	delete[] uncompressedDataBuffer;
 	delete file;
 
@@ -55,6 +55,12 @@ MODULE_OBJS := \
 	sfx/soundengine.o \
 	sfx/soundengine_script.o
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	gfx/graphicengine_sse2.o
+$(MODULE)/gfx/graphicengine_sse2.o: CXXFLAGS += -msse2
+endif
+
 # This module can be built as a plugin
 ifeq ($(ENABLE_SWORD25), DYNAMIC_PLUGIN)
 PLUGIN := 1
@@ -30,6 +30,7 @@
 
 #include "common/memstream.h"
 #include "common/debug-channels.h"
+#include "common/system.h"
 
 #include "sword25/sword25.h"
 #include "sword25/package/packagemanager.h"
@@ -388,21 +389,32 @@ bool LuaScriptEngine::persist(OutputPersistenceBlock &writer) {
 	// Garbage Collection erzwingen.
 	lua_gc(_state, LUA_GCCOLLECT, 0);
 
+	uint32 startTime = g_system->getMillis();
+
+	// Everything reachable gets persisted, so there's nothing for the
+	// collector to do until persisting is done
+	lua_gc(_state, LUA_GCSTOP, 0);
+
 	// Permanents-Table is set on the stack
 	// pluto_persist expects these two items on the Lua stack
 	pushPermanentsTable(_state, PTT_PERSIST);
 	lua_getglobal(_state, "_G");
 
-	// Lua persists and stores the data in a WriteStream
-	Common::MemoryWriteStreamDynamic writeStream(DisposeAfterUse::YES);
-	Lua::persistLua(_state, &writeStream);
-
-	// Persistenzdaten in den Writer schreiben.
-	writer.write(writeStream.getData(), writeStream.size());
+	// Lua persists the data straight into the writer
+	uint32 size;
+	{
+		OutputPersistenceBlock::BlockWriteStream writeStream(writer);
+		Lua::persistLua(_state, &writeStream);
+		size = writeStream.pos();
+	}
 
 	// Die beiden Tabellen vom Stack nehmen.
 	lua_pop(_state, 2);
 
+	lua_gc(_state, LUA_GCRESTART, 0);
+
+	debugC(kDebugScript, "Persisted %u bytes of Lua data in %u ms", size, g_system->getMillis() - startTime);
+
 	return true;
 }
 
@@ -476,12 +488,18 @@ bool LuaScriptEngine::unpersist(InputPersistenceBlock &reader) {
 	};
 	clearGlobalTable(_state, clearExceptionsSecondPass);
 
-	// Persisted Lua data
-	Common::Array<byte> chunkData;
-	reader.readByteArray(chunkData);
-	Common::MemoryReadStream readStream(&chunkData[0], chunkData.size(), DisposeAfterUse::NO);
+	uint32 startTime = g_system->getMillis();
+
+	// Don't let the collector traverse the objects while they're being
+	// created, they're all reachable anyway
+	lua_gc(_state, LUA_GCSTOP, 0);
+
+	// Persisted Lua data, read in place
+	Common::MemoryReadStream *readStream = reader.readByteArrayStream();
+	Lua::unpersistLua(_state, readStream);
 
-	Lua::unpersistLua(_state, &readStream);
+	debugC(kDebugScript, "Unpersisted %u bytes of Lua data in %u ms", (uint32)readStream->size(), g_system->getMillis() - startTime);
+	delete readStream;
 
 	// Permanents-Table is removed from stack
 	lua_remove(_state, -2);
@@ -506,6 +524,7 @@ bool LuaScriptEngine::unpersist(InputPersistenceBlock &reader) {
 	lua_pop(_state, 1);
 
 	// Force garbage collection
+	lua_gc(_state, LUA_GCRESTART, 0);
 	lua_gc(_state, LUA_GCCOLLECT, 0);
 
 	return true;
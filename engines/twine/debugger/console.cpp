@@ -21,13 +21,16 @@
 
 #include "twine/debugger/console.h"
 #include "common/scummsys.h"
+#include "common/system.h"
 #include "common/util.h"
 #include "twine/debugger/debug_grid.h"
 #include "twine/debugger/debug_scene.h"
 #include "twine/holomap.h"
+#include "twine/menu/interface.h"
 #include "twine/renderer/redraw.h"
 #include "twine/resources/hqr.h"
 #include "twine/scene/gamestate.h"
+#include "twine/scene/grid.h"
 #include "twine/scene/scene.h"
 #include "twine/renderer/screens.h"
 #include "twine/text.h"
@@ -74,6 +77,7 @@ TwinEConsole::TwinEConsole(TwinEEngine *engine) : _engine(engine), GUI::Debugger
 	registerCmd("set_holomap_trajectory", WRAP_METHOD(TwinEConsole, doSetHolomapTrajectory));
 	registerCmd("show_holomap_flag", WRAP_METHOD(TwinEConsole, doPrintGameFlag));
 	registerCmd("toggle_enhancements", WRAP_METHOD(TwinEConsole, doToggleEnhancements));
+	registerCmd("benchmark_grid", WRAP_METHOD(TwinEConsole, doBenchmarkGrid));
 }
 
 TwinEConsole::~TwinEConsole() {
@@ -521,6 +525,48 @@ bool TwinEConsole::doGiveAllItems(int argc, const char **argv) {
 	return true;
 }
 
+bool TwinEConsole::doBenchmarkGrid(int argc, const char **argv) {
+	const int frames = argc > 1 ? MAX(1, atoi(argv[1])) : 256;
+	// the camera stays on every position of the path for a few frames, like it does in the game
+	const int framesPerStep = 4;
+	const int pathLength = 16;
+
+	Grid *grid = _engine->_grid;
+	const IVec3 camera = grid->_newCamera;
+	const Common::Rect clip = _engine->_interface->_clip;
+	_engine->_interface->unsetClip();
+
+	uint32 times[2];
+	for (int cached = 0; cached < 2; cached++) {
+		grid->invalidateGridLayer();
+		const uint32 start = g_system->getMillis();
+		for (int frame = 0; frame < frames; frame++) {
+			// walk around a square centered on the current camera position
+			const int step = (frame / framesPerStep) % pathLength;
+			const int side = step / (pathLength / 4);
+			const int offset = step % (pathLength / 4);
+			static const int dirX[] = {1, 0, -1, 0};
+			static const int dirZ[] = {0, 1, 0, -1};
+			grid->_newCamera.x = camera.x + dirX[side] * offset + (side == 1 || side == 2 ? pathLength / 4 : 0);
+			grid->_newCamera.y = camera.y;
+			grid->_newCamera.z = camera.z + dirZ[side] * offset + (side >= 2 ? pathLength / 4 : 0);
+			if (!cached) {
+				grid->invalidateGridLayer();
+			}
+			_engine->_screens->clearScreen();
+			grid->redrawGrid();
+		}
+		times[cached] = g_system->getMillis() - start;
+	}
+
+	grid->_newCamera = camera;
+	_engine->_interface->_clip = clip;
+	_engine->_redraw->_firstTime = true;
+
+	debugPrintf("Grid redraw of %i frames: %u ms uncached, %u ms cached\n", frames, times[0], times[1]);
+	return true;
+}
+
 bool TwinEConsole::doSetLife(int argc, const char **argv) {
 	if (argc <= 1) {
 		debugPrintf("Expected to get the life points as parameter\n");
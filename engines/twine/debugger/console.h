@@ -71,6 +71,7 @@ private:
 	bool doAddMagicPoints(int argc, const char **argv);
 	bool doDumpFile(int argc, const char **argv);
 	bool doSetHolomapTrajectory(int argc, const char **argv);
+	bool doBenchmarkGrid(int argc, const char **argv);
 
 protected:
 	void preEnter() override;
@@ -59,6 +59,12 @@ MODULE_OBJS := \
 	text.o \
 	twine.o
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	renderer/renderer_sse2.o
+$(MODULE)/renderer/renderer_sse2.o: CXXFLAGS += -msse2
+endif
+
 # This module can be built as a plugin
 ifeq ($(ENABLE_TWINE), DYNAMIC_PLUGIN)
 PLUGIN := 1
@@ -20,6 +20,7 @@
  */
 
 #include "twine/renderer/renderer.h"
+#include "common/system.h"
 #include "common/util.h"
 #include "twine/menu/interface.h"
 #include "twine/renderer/redraw.h"
@@ -67,6 +68,10 @@ void Renderer::init(int32 w, int32 h) {
 
 	_tabx0 = _tabCoulG;
 	_tabx1 = _tabCoulD;
+
+#ifdef SCUMMVM_SSE2
+	_useSIMD = g_system->hasFeature(OSystem::kFeatureCpuSSE2);
+#endif
 }
 
 void Renderer::projIso(IVec3 &pos, int32 x, int32 y, int32 z) {
@@ -823,12 +828,37 @@ bool Renderer::computePoly(int16 polyRenderType, const ComputedVertex *vertices,
 	return true;
 }
 
+void Renderer::fillRamp(byte *dest, int32 count, uint16 start, uint16 step) const {
+#ifdef SCUMMVM_SSE2
+	if (_useSIMD) {
+		fillRampSSE2(dest, count, start, step);
+		return;
+	}
+#endif
+	for (int32 i = 0; i < count; i++) {
+		*dest++ = (byte)(start >> 8);
+		start += step;
+	}
+}
+
+void Renderer::fillTrans(byte *dest, int32 count, uint8 color) const {
+#ifdef SCUMMVM_SSE2
+	if (_useSIMD) {
+		fillTransSSE2(dest, count, color);
+		return;
+	}
+#endif
+	for (int32 i = 0; i < count; i++) {
+		*dest = color | (*dest & 0x0F);
+		dest++;
+	}
+}
+
 void Renderer::svgaPolyCopper(int16 vtop, int16 Ymax, uint16 color) const {
 	const int screenWidth = _engine->width();
 	int16 xMin, xMax;
 	int16 y = vtop;
 	byte *pDestLine = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, y);
-	byte *pDest;
 	int16 *pVerticG = &_tabVerticG[y];
 	int16 *pVerticD = &_tabVerticD[y];
 	int32 sens = 1;
@@ -836,10 +866,8 @@ void Renderer::svgaPolyCopper(int16 vtop, int16 Ymax, uint16 color) const {
 	for (; y <= Ymax; y++) {
 		xMin = *pVerticG++;
 		xMax = *pVerticD++;
-		pDest = pDestLine + xMin;
-
-		for (; xMin <= xMax; xMin++) {
-			*pDest++ = (byte)color;
+		if (xMin <= xMax) {
+			memset(pDestLine + xMin, (byte)color, xMax - xMin + 1);
 		}
 
 		color += sens;
@@ -859,7 +887,6 @@ void Renderer::svgaPolyBopper(int16 vtop, int16 Ymax, uint16 color) const {
 	int16 xMin, xMax;
 	int16 y = vtop;
 	byte *pDestLine = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, y);
-	byte *pDest;
 	int16 *pVerticG = &_tabVerticG[y];
 	int16 *pVerticD = &_tabVerticD[y];
 	int32 sens = 1;
@@ -868,10 +895,8 @@ void Renderer::svgaPolyBopper(int16 vtop, int16 Ymax, uint16 color) const {
 	for (; y <= Ymax; y++) {
 		xMin = *pVerticG++;
 		xMax = *pVerticD++;
-		pDest = pDestLine + xMin;
-
-		for (; xMin <= xMax; xMin++) {
-			*pDest++ = (byte)color;
+		if (xMin <= xMax) {
+			memset(pDestLine + xMin, (byte)color, xMax - xMin + 1);
 		}
 
 		line--;
@@ -895,17 +920,14 @@ void Renderer::svgaPolyTriste(int16 vtop, int16 Ymax, uint16 color) const {
 	int16 xMin, xMax;
 	int16 y = vtop;
 	byte *pDestLine = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	byte *pDest;
 	int16 *pVerticG = &_tabVerticG[y];
 	int16 *pVerticD = &_tabVerticD[y];
 
 	for (; y <= Ymax; y++) {
 		xMin = *pVerticG++;
 		xMax = *pVerticD++;
-		pDest = pDestLine + xMin;
-
-		for (; xMin <= xMax; xMin++) {
-			*pDest++ = (byte)color;
+		if (xMin <= xMax) {
+			memset(pDestLine + xMin, (byte)color, xMax - xMin + 1);
 		}
 
 		pDestLine += screenWidth;
@@ -950,7 +972,6 @@ void Renderer::svgaPolyTrans(int16 vtop, int16 Ymax, uint16 color) const {
 	int16 xMin, xMax;
 	int16 y = vtop;
 	byte *pDestLine = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	byte *pDest;
 	int16 *pVerticG = &_tabVerticG[y];
 	int16 *pVerticD = &_tabVerticD[y];
 
@@ -959,11 +980,8 @@ void Renderer::svgaPolyTrans(int16 vtop, int16 Ymax, uint16 color) const {
 	for (; y <= Ymax; y++) {
 		xMin = *pVerticG++;
 		xMax = *pVerticD++;
-		pDest = pDestLine + xMin;
-
-		for (; xMin <= xMax; xMin++) {
-			*pDest = (byte)color | (*pDest & 0x0F);
-			pDest++;
+		if (xMin <= xMax) {
+			fillTrans(pDestLine + xMin, xMax - xMin + 1, (uint8)color);
 		}
 
 		pDestLine += screenWidth;
@@ -1034,11 +1052,7 @@ void Renderer::svgaPolyGouraud(int16 vtop, int16 Ymax) const {
 			*pDest = (byte)(start >> 8);
 		} else {
 			step = (end - start) / xMax;
-
-			for (; xMax >= 0; xMax--) {
-				*pDest++ = (byte)(start >> 8);
-				start += step;
-			}
+			fillRamp(pDest, xMax + 1, start, step);
 		}
 
 		pDestLine += screenWidth;
@@ -1145,12 +1159,7 @@ void Renderer::svgaPolyMarbre(int16 vtop, int16 Ymax, uint16 color) const {
 			*pDest++ = (byte)(end >> 8);
 		} else if (dc > 0) {
 			step = delta / (dc + 1);
-			color = start;
-
-			for (; xMin <= xMax; xMin++) {
-				*pDest++ = (byte)(color >> 8);
-				color += step;
-			}
+			fillRamp(pDest, dc + 1, start, step);
 		}
 
 		pDestLine += screenWidth;
@@ -1162,7 +1171,6 @@ void Renderer::svgaPolyTriche(int16 vtop, int16 Ymax, uint16 color) const {
 	int16 xMin, xMax;
 	int16 y = vtop;
 	byte *pDestLine = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, y);
-	byte *pDest;
 	int16 *pVerticG = &_tabVerticG[y];
 	int16 *pVerticD = &_tabVerticD[y];
 	int16 *pCoulG = &_tabCoulG[y];
@@ -1170,11 +1178,9 @@ void Renderer::svgaPolyTriche(int16 vtop, int16 Ymax, uint16 color) const {
 	for (; y <= Ymax; y++) {
 		xMin = *pVerticG++;
 		xMax = *pVerticD++;
-		pDest = pDestLine + xMin;
-
 		color = (*pCoulG++) >> 8;
-		for (; xMin <= xMax; xMin++) {
-			*pDest++ = (byte)color;
+		if (xMin <= xMax) {
+			memset(pDestLine + xMin, (byte)color, xMax - xMin + 1);
 		}
 
 		pDestLine += screenWidth;
@@ -65,6 +65,12 @@ struct ComputedVertex {
 
 bool isPolygonVisible(const ComputedVertex *vertices);
 
+#ifdef SCUMMVM_SSE2
+// Vectorized span fillers, see renderer_sse2.cpp
+void fillRampSSE2(byte *dest, int32 count, uint16 start, uint16 step);
+void fillTransSSE2(byte *dest, int32 count, uint8 color);
+#endif
+
 struct CmdRenderPolygon {
 	uint8 renderType = 0;
 	uint8 numVertices = 0;
@@ -199,6 +205,18 @@ private:
 	int16* _tabx1 = nullptr; // also _tabCoulD
 
 	bool _isUsingIsoProjection = false;
+	bool _useSIMD = false;
+
+	/**
+	 * Fill a span with the high bytes of a 16 bit fixed point color ramp
+	 * @param dest first pixel of the span
+	 * @param count number of pixels
+	 * @param start fixed point color of the first pixel
+	 * @param step fixed point color increment per pixel, wrapping around like the original
+	 */
+	void fillRamp(byte *dest, int32 count, uint16 start, uint16 step) const;
+	/** Replace the upper nibble of every pixel of a span with the given color */
+	void fillTrans(byte *dest, int32 count, uint8 color) const;
 
 	void svgaPolyCopper(int16 vtop, int16 vbottom, uint16 color) const;
 	void svgaPolyBopper(int16 vtop, int16 vbottom, uint16 color) const;
@@ -0,0 +1,75 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <emmintrin.h>
+
+#include "twine/renderer/renderer.h"
+
+namespace TwinE {
+
+// The ramps are 16 bit fixed point colors wrapping around just like the
+// 16 bit registers of the original code, so every lane computes exactly
+// the same values the scalar loops do.
+
+void fillRampSSE2(byte *dest, int32 count, uint16 start, uint16 step) {
+	int32 i = 0;
+
+	if (count >= 16) {
+		const __m128i lanes = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+		const __m128i stepVec = _mm_set1_epi16((int16)step);
+		const __m128i step8 = _mm_set1_epi16((int16)(step * 8));
+		const __m128i step16 = _mm_set1_epi16((int16)(step * 16));
+		__m128i lo = _mm_add_epi16(_mm_set1_epi16((int16)start), _mm_mullo_epi16(lanes, stepVec));
+		__m128i hi = _mm_add_epi16(lo, step8);
+
+		for (; i + 16 <= count; i += 16) {
+			__m128i pixels = _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+			_mm_storeu_si128((__m128i *)(dest + i), pixels);
+			lo = _mm_add_epi16(lo, step16);
+			hi = _mm_add_epi16(hi, step16);
+		}
+
+		start += (uint16)(step * i);
+	}
+
+	for (; i < count; i++) {
+		dest[i] = (byte)(start >> 8);
+		start += step;
+	}
+}
+
+void fillTransSSE2(byte *dest, int32 count, uint8 color) {
+	const __m128i colorVec = _mm_set1_epi8((char)color);
+	const __m128i mask = _mm_set1_epi8(0x0F);
+	int32 i = 0;
+
+	for (; i + 16 <= count; i += 16) {
+		__m128i pixels = _mm_loadu_si128((const __m128i *)(dest + i));
+		pixels = _mm_or_si128(_mm_and_si128(pixels, mask), colorVec);
+		_mm_storeu_si128((__m128i *)(dest + i), pixels);
+	}
+
+	for (; i < count; i++) {
+		dest[i] = color | (dest[i] & 0x0F);
+	}
+}
+
+} // namespace TwinE
@@ -56,14 +56,21 @@ Grid::~Grid() {
 	free(_currentGrid);
 	free(_brickInfoBuffer);
 	free(_bricksDataBuffer);
+	free(_gridLayerBrickInfo);
+	free(_gridLayerBricks);
+	_gridLayer.free();
 }
 
 void Grid::init(int32 w, int32 h) {
 	const int32 numbrickentries = (1 + (w + 24) / 24);
-	const size_t brickDataBufferSize = numbrickentries * MAXBRICKS * sizeof(BrickEntry);
-	_bricksDataBuffer = (BrickEntry *)malloc(brickDataBufferSize);
+	_bricksDataBufferSize = numbrickentries * MAXBRICKS * sizeof(BrickEntry);
+	_bricksDataBuffer = (BrickEntry *)malloc(_bricksDataBufferSize);
 	_brickInfoBufferSize = numbrickentries * sizeof(int16);
 	_brickInfoBuffer = (int16 *)malloc(_brickInfoBufferSize);
+
+	_gridLayer.create(w, h, Graphics::PixelFormat::createFormatCLUT8());
+	_gridLayerBricks = (BrickEntry *)malloc(_bricksDataBufferSize);
+	_gridLayerBrickInfo = (int16 *)malloc(_brickInfoBufferSize);
 }
 
 void Grid::copyMask(int32 index, int32 x, int32 y, const Graphics::ManagedSurface &buffer) {
@@ -144,15 +151,15 @@ void Grid::copyMask(int32 index, int32 x, int32 y, const Graphics::ManagedSurfac
 
 			width = *(ptr++); // copy size
 
-			for (int32 j = 0; j < width; j++) {
-				if (absX >= _engine->_interface->_clip.left && absX <= _engine->_interface->_clip.right) {
-					*outPtr = *inPtr;
-				}
-
-				absX++;
-				outPtr++;
-				inPtr++;
+			const int32 start = MAX<int32>(absX, _engine->_interface->_clip.left);
+			const int32 end = MIN<int32>(absX + width, _engine->_interface->_clip.right + 1);
+			if (start < end) {
+				memcpy(outPtr + (start - absX), inPtr + (start - absX), end - start);
 			}
+
+			absX += width;
+			outPtr += width;
+			inPtr += width;
 		} while (--height);
 
 		absX = left;
@@ -405,6 +412,7 @@ void Grid::copyMapToCube() {
 			blockOffset += 2 * SIZE_CUBE_Y;
 		}
 	}
+	_gridRevision++;
 }
 
 void Grid::createCellingGridMap(const uint8 *gridPtr, int32 gridPtrSize) { // MixteMapToCube
@@ -422,6 +430,7 @@ void Grid::createCellingGridMap(const uint8 *gridPtr, int32 gridPtrSize) { // Mi
 		}
 		currGridOffset += SIZE_CUBE_X + SIZE_CUBE_Z;
 	}
+	_gridRevision++;
 }
 
 bool Grid::initGrid(int32 index) {
@@ -496,7 +505,6 @@ bool Grid::drawSprite(int32 posX, int32 posY, const SpriteData &ptr, int spriteI
 	return true;
 }
 
-// WARNING: Rewrite this function to have better performance
 bool Grid::drawBrickSprite(int32 posX, int32 posY, const uint8 *ptr, bool isSprite) {
 	if (_engine->_debugGrid->_disableGridRendering) {
 		return false;
@@ -522,6 +530,8 @@ bool Grid::drawBrickSprite(int32 posX, int32 posY, const uint8 *ptr, bool isSpri
 		return false;
 	}
 	const int32 maxY = MIN(bottom, (int32)_engine->_interface->_clip.bottom);
+	const int32 clipLeft = _engine->_interface->_clip.left;
+	const int32 clipRight = _engine->_interface->_clip.right;
 
 	ptr += 4;
 
@@ -539,38 +549,22 @@ bool Grid::drawBrickSprite(int32 posX, int32 posY, const uint8 *ptr, bool isSpri
 					x += iterations;
 					continue;
 				}
-				if (y < _engine->_interface->_clip.top || x >= _engine->_interface->_clip.right || x + iterations < _engine->_interface->_clip.left) {
-					if (type == 1) {
-						ptr += iterations;
-					} else {
-						++ptr;
-					}
-					x += iterations;
-					continue;
-				}
+				// clip the run once instead of every pixel of it
+				const int32 start = MAX(x, clipLeft);
+				const int32 end = MIN(x + iterations, clipRight);
+				const bool visible = y >= _engine->_interface->_clip.top && start < end;
 				if (type == 1) {
-					uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(x, y);
-					for (uint8 i = 0; i < iterations; i++) {
-						if (x >= _engine->_interface->_clip.left && x < _engine->_interface->_clip.right) {
-							*out = *ptr;
-						}
-
-						++out;
-						++x;
-						++ptr;
+					if (visible) {
+						memcpy(_engine->_frontVideoBuffer.getBasePtr(start, y), ptr + (start - x), end - start);
 					}
+					ptr += iterations;
 				} else {
 					const uint8 pixel = *ptr++;
-					uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(x, y);
-					for (uint8 i = 0; i < iterations; i++) {
-						if (x >= _engine->_interface->_clip.left && x < _engine->_interface->_clip.right) {
-							*out = pixel;
-						}
-
-						++out;
-						++x;
+					if (visible) {
+						memset(_engine->_frontVideoBuffer.getBasePtr(start, y), pixel, end - start);
 					}
 				}
+				x += iterations;
 			}
 			x = left;
 		}
@@ -618,14 +612,9 @@ void Grid::getBrickPos(int32 x, int32 y, int32 z, int32 &posx, int32 &posy) cons
 	posy = ((x + z) * 12) - (y * 15) + _engine->height() / 2 - SIZE_CUBE_Y;
 }
 
-void Grid::drawColumnGrid(int32 blockIdx, int32 brickBlockIdx, int32 x, int32 y, int32 z) { // AffBrickBlock
-	const BlockDataEntry *blockPtr = getAdrBlock(blockIdx, brickBlockIdx);
-	const uint8 brickShape = blockPtr->brickShape;
-	const uint8 brickSound = blockPtr->brickType;
-	const uint16 brickIdx = blockPtr->brickIdx;
-	if (!brickIdx) {
-		return;
-	}
+void Grid::drawColumnGrid(const ColumnBrick &brick, int32 x, int32 z) { // AffBrickBlock
+	const int32 y = brick.y;
+	const uint16 brickIdx = brick.brickIdx;
 
 	int32 brickPixelPosX = 0;
 	int32 brickPixelPosY = 0;
@@ -663,8 +652,8 @@ void Grid::drawColumnGrid(int32 blockIdx, int32 brickBlockIdx, int32 x, int32 y,
 	currBrickEntry->posX = brickPixelPosX;
 	currBrickEntry->posY = brickPixelPosY;
 	currBrickEntry->index = brickIdx - 1;
-	currBrickEntry->shape = brickShape;
-	currBrickEntry->sound = brickSound;
+	currBrickEntry->shape = brick.shape;
+	currBrickEntry->sound = brick.sound;
 
 	_brickInfoBuffer[brickBuffIdx]++;
 }
@@ -674,22 +663,79 @@ void Grid::redrawGrid() { // AffGrille
 	_worldCube.y = _newCamera.y * SIZE_BRICK_Y;
 	_worldCube.z = _newCamera.z * SIZE_BRICK_XZ;
 
+	if (!_engine->_scene->_enableGridTileRendering) {
+		memset(_brickInfoBuffer, 0, _brickInfoBufferSize);
+		return;
+	}
+
+	// the screen was cleared before, so the grid layer holds everything the grid draws
+	const Common::Rect &clip = _engine->_interface->_clip;
+	const bool renderGrid = !_engine->_debugGrid->_disableGridRendering;
+	if (renderGrid && _gridLayerRevision == _gridRevision && _gridLayerClip == clip &&
+		_gridLayerCamera.x == _newCamera.x && _gridLayerCamera.y == _newCamera.y && _gridLayerCamera.z == _newCamera.z) {
+		_engine->_frontVideoBuffer.blitFrom(_gridLayer);
+		memcpy(_bricksDataBuffer, _gridLayerBricks, _bricksDataBufferSize);
+		memcpy(_brickInfoBuffer, _gridLayerBrickInfo, _brickInfoBufferSize);
+		return;
+	}
+
 	memset(_brickInfoBuffer, 0, _brickInfoBufferSize);
+	updateColumnBricks();
 
-	if (!_engine->_scene->_enableGridTileRendering) {
+	for (int32 z = 0; z < SIZE_CUBE_Z; z++) {
+		for (int32 x = 0; x < SIZE_CUBE_X; x++) {
+			const int32 column = z * SIZE_CUBE_X + x;
+			for (uint32 i = _columnStart[column]; i < _columnStart[column + 1]; i++) {
+				drawColumnGrid(_columnBricks[i], x, z);
+			}
+		}
+	}
+
+	if (!renderGrid) {
+		invalidateGridLayer();
+		return;
+	}
+	_gridLayer.blitFrom(_engine->_frontVideoBuffer);
+	memcpy(_gridLayerBricks, _bricksDataBuffer, _bricksDataBufferSize);
+	memcpy(_gridLayerBrickInfo, _brickInfoBuffer, _brickInfoBufferSize);
+	_gridLayerRevision = _gridRevision;
+	_gridLayerCamera = _newCamera;
+	_gridLayerClip = clip;
+}
+
+void Grid::invalidateGridLayer() {
+	_gridLayerRevision = 0;
+}
+
+void Grid::updateColumnBricks() {
+	if (_columnRevision == _gridRevision) {
 		return;
 	}
 
+	_columnBricks.clear();
 	for (int32 z = 0; z < SIZE_CUBE_Z; z++) {
 		for (int32 x = 0; x < SIZE_CUBE_X; x++) {
+			_columnStart[z * SIZE_CUBE_X + x] = _columnBricks.size();
 			for (int32 y = 0; y < SIZE_CUBE_Y; y++) {
 				const BlockEntry entry = getBlockEntry(x, y, z);
-				if (entry.blockIdx) {
-					drawColumnGrid(entry.blockIdx, entry.brickBlockIdx, x, y, z);
+				if (!entry.blockIdx) {
+					continue;
+				}
+				const BlockDataEntry *blockPtr = getAdrBlock(entry.blockIdx, entry.brickBlockIdx);
+				if (!blockPtr->brickIdx) {
+					continue;
 				}
+				ColumnBrick brick;
+				brick.brickIdx = blockPtr->brickIdx;
+				brick.y = y;
+				brick.shape = blockPtr->brickShape;
+				brick.sound = blockPtr->brickType;
+				_columnBricks.push_back(brick);
 			}
 		}
 	}
+	_columnStart[SIZE_CUBE_X * SIZE_CUBE_Z] = _columnBricks.size();
+	_columnRevision = _gridRevision;
 }
 
 BlockEntry Grid::getBlockEntry(int32 xmap, int32 ymap, int32 zmap) const {
@@ -24,15 +24,14 @@
 
 #define WATER_BRICK (0xF1)
 
+#include "common/array.h"
+#include "common/rect.h"
 #include "common/scummsys.h"
+#include "graphics/managed_surface.h"
 #include "twine/parser/blocklibrary.h"
 #include "twine/parser/sprite.h"
 #include "twine/shared.h"
 
-namespace Graphics {
-class ManagedSurface;
-}
-
 namespace TwinE {
 
 class ActorStruct;
@@ -64,6 +63,18 @@ struct BrickEntry {
 	uint8 sound = 0;
 };
 
+/** Brick of a grid column, resolved from the block library */
+struct ColumnBrick {
+	/** Brick index, starting at 1 */
+	uint16 brickIdx = 0;
+	/** Column y position */
+	uint8 y = 0;
+	/** Brick shape type */
+	uint8 shape = 0;
+	/** Brick sound type */
+	uint8 sound = 0;
+};
+
 /** Total number of bricks allowed in the game */
 #define NUM_BRICKS 9000
 
@@ -97,14 +108,16 @@ private:
 	TwinEEngine *_engine;
 
 	/**
-	 * Draw a specific brick in the grid column according with the block index
-	 * @param blockIdx block library index
-	 * @param brickBlockIdx brick index inside the block
+	 * Draw a specific brick in the grid column
+	 * @param brick brick of the column
 	 * @param x column x position
-	 * @param y column y position
 	 * @param z column z position
 	 */
-	void drawColumnGrid(int32 blockIdx, int32 brickBlockIdx, int32 x, int32 y, int32 z);
+	void drawColumnGrid(const ColumnBrick &brick, int32 x, int32 z);
+	/**
+	 * Resolve the bricks of all grid columns, if the grid changed since they were last resolved
+	 */
+	void updateColumnBricks();
 	/**
 	 * Get brick position in the screen
 	 * @param x column x position in the current camera
@@ -167,10 +180,30 @@ private:
 
 	/** Brick data buffer */
 	BrickEntry *_bricksDataBuffer = nullptr;
+	int32 _bricksDataBufferSize = 0;
 	/** Brick info buffer */
 	int16 *_brickInfoBuffer = nullptr;
 	int32 _brickInfoBufferSize = 0;
 
+	/** Incremented whenever the bricks of the grid change */
+	uint32 _gridRevision = 1;
+
+	/** Non-empty bricks of every grid column, in drawing order */
+	Common::Array<ColumnBrick> _columnBricks;
+	/** Index of the first brick of every grid column in _columnBricks */
+	uint32 _columnStart[SIZE_CUBE_X * SIZE_CUBE_Z + 1]{0};
+	/** Grid revision the column bricks were resolved for */
+	uint32 _columnRevision = 0;
+
+	/** Grid as last drawn by redrawGrid(), with its brick buffers */
+	Graphics::ManagedSurface _gridLayer;
+	BrickEntry *_gridLayerBricks = nullptr;
+	int16 *_gridLayerBrickInfo = nullptr;
+	/** Grid revision, camera and clipping the grid layer was drawn with */
+	uint32 _gridLayerRevision = 0;
+	IVec3 _gridLayerCamera;
+	Common::Rect _gridLayerClip;
+
 	/** Celling grid brick block buffer */
 	int32 _blockBufferSize = 0;
 	uint8 *_bufCube = nullptr;
@@ -283,8 +316,13 @@ public:
 	 */
 	bool initCellingGrid(int32 index);
 
-	/** Redraw grid background */
+	/**
+	 * Redraw grid background. The result is cached, and reused as long as
+	 * neither the camera nor the bricks change
+	 */
 	void redrawGrid();
+	/** Force the next redrawGrid() to draw all bricks again */
+	void invalidateGridLayer();
 
 	ShapeType worldColBrick(int32 x, int32 y, int32 z);
 
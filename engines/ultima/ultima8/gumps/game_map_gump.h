@@ -76,6 +76,10 @@ public:
 
 	void IncSortOrder(int count);
 
+	ItemSorter *GetDisplayList() {
+		return _displayList;
+	}
+
 	bool loadData(Common::ReadStream *rs, uint32 version);
 	void saveData(Common::WriteStream *ws) override;
 
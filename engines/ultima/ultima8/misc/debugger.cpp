@@ -50,6 +50,7 @@
 #include "ultima/ultima8/world/camera_process.h"
 #include "ultima/ultima8/world/get_object.h"
 #include "ultima/ultima8/world/item_factory.h"
+#include "ultima/ultima8/world/item_sorter.h"
 #include "ultima/ultima8/world/actors/quick_avatar_mover_process.h"
 #include "ultima/ultima8/world/actors/avatar_mover_process.h"
 #include "ultima/ultima8/world/actors/pathfinder.h"
@@ -128,6 +129,8 @@ Debugger::Debugger() : GUI::Debugger() {
 	registerCmd("Cheat::items", WRAP_METHOD(Debugger, cmdCheatItems));
 	registerCmd("Cheat::equip", WRAP_METHOD(Debugger, cmdCheatEquip));
 
+	registerCmd("CurrentMap::queryStats", WRAP_METHOD(Debugger, cmdQueryStats));
+
 	registerCmd("GameMapGump::startHighlightItems", WRAP_METHOD(Debugger, cmdStartHighlightItems));
 	registerCmd("GameMapGump::stopHighlightItems", WRAP_METHOD(Debugger, cmdStopHighlightItems));
 	registerCmd("GameMapGump::toggleHighlightItems", WRAP_METHOD(Debugger, cmdToggleHighlightItems));
@@ -136,6 +139,7 @@ Debugger::Debugger() : GUI::Debugger() {
 	registerCmd("GameMapGump::dumpAllMaps", WRAP_METHOD(Debugger, cmdDumpAllMaps));
 	registerCmd("GameMapGump::incrementSortOrder", WRAP_METHOD(Debugger, cmdIncrementSortOrder));
 	registerCmd("GameMapGump::decrementSortOrder", WRAP_METHOD(Debugger, cmdDecrementSortOrder));
+	registerCmd("GameMapGump::benchmarkPainter", WRAP_METHOD(Debugger, cmdBenchmarkPainter));
 
 	registerCmd("Kernel::processTypes", WRAP_METHOD(Debugger, cmdProcessTypes));
 	registerCmd("Kernel::processInfo", WRAP_METHOD(Debugger, cmdProcessInfo));
@@ -840,6 +844,34 @@ bool Debugger::cmdDumpAllMaps(int argc, const char **argv) {
 }
 
 
+bool Debugger::cmdQueryStats(int argc, const char **argv) {
+	World *world = World::get_instance();
+	CurrentMap *map = world ? world->getCurrentMap() : nullptr;
+	if (!map) {
+		debugPrintf("No map loaded\n");
+		return true;
+	}
+
+	if (argc > 1 && !scumm_stricmp(argv[1], "reset")) {
+		map->resetQueryStats();
+		debugPrintf("Query counters reset\n");
+		return true;
+	}
+
+	const CurrentMap::QueryStats &stats = map->getQueryStats();
+	uint32 ticks = Kernel::get_instance()->getFrameNum() - stats._startFrame;
+	if (ticks == 0)
+		ticks = 1;
+
+	debugPrintf("Map queries over %u ticks (total / per tick):\n", ticks);
+	debugPrintf("Queries        : %u / %u\n", stats._queries, stats._queries / ticks);
+	debugPrintf("Cache hits     : %u / %u\n", stats._cacheHits, stats._cacheHits / ticks);
+	debugPrintf("Chunks scanned : %u / %u\n", stats._chunksScanned, stats._chunksScanned / ticks);
+	debugPrintf("Chunks skipped : %u / %u\n", stats._chunksSkipped, stats._chunksSkipped / ticks);
+	debugPrintf("Item tests     : %u / %u\n", stats._itemTests, stats._itemTests / ticks);
+	return true;
+}
+
 bool Debugger::cmdIncrementSortOrder(int argc, const char **argv) {
 	int32 count = argc > 1 ? strtol(argv[1], 0, 0) : 1;
 	GameMapGump *gump = Ultima8Engine::get_instance()->getGameMapGump();
@@ -856,6 +888,54 @@ bool Debugger::cmdDecrementSortOrder(int argc, const char **argv) {
 	return false;
 }
 
+bool Debugger::cmdBenchmarkPainter(int argc, const char **argv) {
+	int count = argc > 1 ? atoi(argv[1]) : 100;
+	GameMapGump *gump = Ultima8Engine::get_instance()->getGameMapGump();
+	if (!gump || count <= 0) {
+		debugPrintf("usage: GameMapGump::benchmarkPainter [iterations]\n");
+		debugPrintf("Paints the current view of the game map, e.g. after loading a saved game\n");
+		return true;
+	}
+
+	Graphics::Screen *screen = Ultima8Engine::get_instance()->getScreen();
+	RenderSurface *surface = new RenderSurface(screen->w, screen->h, screen->format);
+	surface->BeginPainting();
+
+	ItemSorter *sorter = gump->GetDisplayList();
+	uint64 sorted = 0;
+	uint64 comparisons = 0;
+	uint64 fullScan = 0;
+	uint32 start, end;
+
+	// Sort every frame from scratch
+	start = g_system->getMillis();
+	for (int i = 0; i < count; i++) {
+		sorter->InvalidateDisplayList();
+		gump->Paint(surface, 256, false);
+
+		uint64 items = sorter->getItemsSorted();
+		sorted += items;
+		comparisons += sorter->getComparisons();
+		fullScan += items * (items - 1) / 2;
+	}
+	end = g_system->getMillis();
+	debugPrintf("Sorted: %d ms, %d items and %d comparisons per frame (at most %d for a full scan)\n",
+				end - start, (int)(sorted / count), (int)(comparisons / count), (int)(fullScan / count));
+
+	// Unchanged frames reuse the previous ordering
+	start = g_system->getMillis();
+	for (int i = 0; i < count; i++)
+		gump->Paint(surface, 256, false);
+	end = g_system->getMillis();
+	debugPrintf("Reused: %d ms, display list %s\n", end - start,
+				sorter->isDisplayListReused() ? "reused" : "sorted");
+
+	surface->EndPainting();
+	delete surface;
+
+	return true;
+}
+
 
 bool Debugger::cmdProcessTypes(int argc, const char **argv) {
 	Kernel::get_instance()->processTypes();
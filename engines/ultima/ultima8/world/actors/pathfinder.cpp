@@ -24,6 +24,8 @@
 #include "ultima/ultima8/misc/direction_util.h"
 #include "ultima/ultima8/world/actors/actor.h"
 #include "ultima/ultima8/world/actors/animation_tracker.h"
+#include "ultima/ultima8/world/current_map.h"
+#include "ultima/ultima8/world/world.h"
 
 #ifdef DEBUG_PATHFINDER
 #include "graphics/screen.h"
@@ -517,6 +519,10 @@ bool Pathfinder::pathfind(Std::vector<PathfindingAction> &path) {
 
 	path.clear();
 
+	// Nothing else moves while searching, so let the collision
+	// queries of the node expansion share their work
+	CurrentMap::QueryCacheScope queryCache(World::get_instance()->getCurrentMap());
+
 	PathNode *startnode = new PathNode();
 	startnode->state = _start;
 	startnode->cost = 0;
@@ -52,10 +52,12 @@ const int INT_MAX_VALUE = 0x7fffffff;
 const int INT_MIN_VALUE = -INT_MAX_VALUE - 1;
 
 CurrentMap::CurrentMap() : _currentMap(0), _eggHatcher(0),
-	  _fastXMin(-1), _fastYMin(-1), _fastXMax(-1), _fastYMax(-1) {
+	  _fastXMin(-1), _fastYMin(-1), _fastXMax(-1), _fastYMax(-1),
+	  _queryRevision(1), _queryCacheDepth(0) {
 	for (unsigned int i = 0; i < MAP_NUM_CHUNKS; i++) {
 		memset(_fast[i], false, sizeof(uint32)*MAP_NUM_CHUNKS / 32);
 	}
+	memset(_chunkFootpad, 0, sizeof(_chunkFootpad));
 
 	if (GAME_IS_U8) {
 		_mapChunkSize = 512;
@@ -85,6 +87,8 @@ void CurrentMap::clear() {
 		}
 		memset(_fast[i], false, sizeof(uint32)*MAP_NUM_CHUNKS / 32);
 	}
+	memset(_chunkFootpad, 0, sizeof(_chunkFootpad));
+	invalidateQueryCache();
 
 	_fastXMin =  _fastYMin = _fastXMax = _fastYMax = -1;
 	_currentMap = nullptr;
@@ -258,6 +262,8 @@ void CurrentMap::addItem(Item *item) {
 
 	_items[cx][cy].push_front(item);
 	item->setExtFlag(Item::EXT_INCURMAP);
+	updateChunkFootpad(item);
+	invalidateQueryCache();
 
 	Egg *egg = dynamic_cast<Egg *>(item);
 	if (egg) {
@@ -295,6 +301,8 @@ void CurrentMap::addItemToEnd(Item *item) {
 
 	_items[cx][cy].push_back(item);
 	item->setExtFlag(Item::EXT_INCURMAP);
+	updateChunkFootpad(item);
+	invalidateQueryCache();
 
 	Egg *egg = dynamic_cast<Egg *>(item);
 	if (egg) {
@@ -406,6 +414,89 @@ void CurrentMap::removeItemFromList(Item *item, int32 oldx, int32 oldy) {
 
 	_items[cx][cy].remove(item);
 	item->clearExtFlag(Item::EXT_INCURMAP);
+	if (_items[cx][cy].empty())
+		_chunkFootpad[cx][cy] = 0;
+	invalidateQueryCache();
+}
+
+void CurrentMap::updateChunkFootpad(const Item *item) {
+	Point3 pt = item->getLocation();
+	if (pt.x < 0 || pt.x >= _mapChunkSize * MAP_NUM_CHUNKS ||
+	        pt.y < 0 || pt.y >= _mapChunkSize * MAP_NUM_CHUNKS)
+		return;
+
+	int32 cx = pt.x / _mapChunkSize;
+	int32 cy = pt.y / _mapChunkSize;
+
+	// Flipping swaps x and y, so keep the largest of both
+	int32 xd, yd, zd;
+	item->getFootpadWorld(xd, yd, zd);
+	int32 footpad = MAX(xd, yd);
+	if (footpad > _chunkFootpad[cx][cy])
+		_chunkFootpad[cx][cy] = footpad;
+
+	invalidateQueryCache();
+}
+
+void CurrentMap::resetQueryStats() {
+	_stats = QueryStats();
+	_stats._startFrame = Kernel::get_instance()->getFrameNum();
+}
+
+void CurrentMap::beginQueryCache() {
+	// Anything cached by an earlier scope may be stale by now
+	if (_queryCacheDepth++ == 0)
+		invalidateQueryCache();
+}
+
+void CurrentMap::endQueryCache() {
+	assert(_queryCacheDepth > 0);
+	_queryCacheDepth--;
+}
+
+const Common::Array<CurrentMap::ChunkEntry> &CurrentMap::getChunkEntries(int cx, int cy, Common::Array<ChunkEntry> &scratch,
+                                                                          ObjId id, uint32 flagmask) const {
+	Common::Array<ChunkEntry> *entries = &scratch;
+	bool filter = true;
+	if (_queryCacheDepth) {
+		ChunkCache &cache = _chunkCache[cx][cy];
+		if (cache._revision == _queryRevision)
+			return cache._entries;
+
+		// The cached entries are shared by all queries, so keep every item
+		cache._revision = _queryRevision;
+		entries = &cache._entries;
+		filter = false;
+	}
+
+	entries->resize(0);
+	item_list::const_iterator iter;
+	for (iter = _items[cx][cy].begin(); iter != _items[cx][cy].end(); ++iter) {
+		const Item *item = *iter;
+		ChunkEntry entry;
+		entry._id = item->getObjId();
+		entry._sprite = item->hasExtFlags(Item::EXT_SPRITE);
+		if (filter && (entry._id == id || entry._sprite))
+			continue;
+
+		entry._shapeFlags = item->getShapeInfo()->_flags;
+		if (filter && flagmask && !(entry._shapeFlags & flagmask))
+			continue;
+
+		entry._item = item;
+		entry._box = item->getWorldBox();
+		entries->push_back(entry);
+	}
+	return *entries;
+}
+
+bool CurrentMap::chunkMayOverlap(int cx, int cy, int32 minx, int32 miny, int32 maxx, int32 maxy) const {
+	if (_items[cx][cy].empty())
+		return false;
+
+	const int32 footpad = _chunkFootpad[cx][cy];
+	return cx * _mapChunkSize - footpad <= maxx && (cx + 1) * _mapChunkSize - 1 >= minx &&
+	       cy * _mapChunkSize - footpad <= maxy && (cy + 1) * _mapChunkSize - 1 >= miny;
 }
 
 // Check to see if the chunk is on the screen
@@ -581,6 +672,8 @@ void CurrentMap::areaSearch(UCList *itemlist, const uint8 *loopscript,
 	int maxy = ((y + range) / _mapChunkSize) + 1;
 	clipMapChunks(minx, maxx, miny, maxy);
 
+	_stats._queries++;
+
 	//
 	// NOTE: Iteration order of chunks here is important for
 	// usecode compatibility!
@@ -592,11 +685,20 @@ void CurrentMap::areaSearch(UCList *itemlist, const uint8 *loopscript,
 	//
 	for (int cy = miny; cy <= maxy; cy++) {
 		for (int cx = minx; cx <= maxx; cx++) {
+			// Skipping chunks without any item in range keeps the order
+			if (!chunkMayOverlap(cx, cy, searchrange._x - searchrange._xd, searchrange._y - searchrange._yd,
+			                     searchrange._x, searchrange._y)) {
+				_stats._chunksSkipped++;
+				continue;
+			}
+			_stats._chunksScanned++;
+
 			item_list::const_iterator iter;
 			for (iter = _items[cx][cy].begin();
 			        iter != _items[cx][cy].end(); ++iter) {
 
 				const Item *item = *iter;
+				_stats._itemTests++;
 
 				if (item->hasExtFlags(Item::EXT_SPRITE))
 					continue;
@@ -637,13 +739,22 @@ void CurrentMap::surfaceSearch(UCList *itemlist, const uint8 *loopscript,
 	int maxy = (pt.y / _mapChunkSize) + 1;
 	clipMapChunks(minx, maxx, miny, maxy);
 
+	_stats._queries++;
+
 	for (int cy = miny; cy <= maxy; cy++) {
 		for (int cx = minx; cx <= maxx; cx++) {
+			if (!chunkMayOverlap(cx, cy, pt.x - xd, pt.y - yd, pt.x, pt.y)) {
+				_stats._chunksSkipped++;
+				continue;
+			}
+			_stats._chunksScanned++;
+
 			item_list::const_iterator iter;
 			for (iter = _items[cx][cy].begin();
 			        iter != _items[cx][cy].end(); ++iter) {
 
 				const Item *item = *iter;
+				_stats._itemTests++;
 
 				if (item->getObjId() == check->getObjId())
 					continue;
@@ -717,6 +828,31 @@ PositionInfo CurrentMap::getPositionInfo(int32 x, int32 y, int32 z, uint32 shape
 }
 
 PositionInfo CurrentMap::getPositionInfo(const Box &target, const Box &start, uint32 shapeflags, ObjId id) const {
+	if (!_queryCacheDepth)
+		return getPositionInfoUncached(target, start, shapeflags, id);
+
+	// Nothing moves while the cache is enabled, so the same query always
+	// gives the same result
+	uint32 hash = (uint32)target._x * 31 + (uint32)target._y * 17 + (uint32)target._z * 7 +
+	              (uint32)start._x * 5 + (uint32)start._y * 3 + start._z + shapeflags + id;
+	PositionCacheEntry &entry = _positionCache[hash % ARRAYSIZE(_positionCache)];
+	if (entry._revision == _queryRevision && entry._target == target && entry._start == start &&
+	        entry._shapeFlags == shapeflags && entry._id == id) {
+		_stats._queries++;
+		_stats._cacheHits++;
+		return entry._info;
+	}
+
+	entry._info = getPositionInfoUncached(target, start, shapeflags, id);
+	entry._target = target;
+	entry._start = start;
+	entry._shapeFlags = shapeflags;
+	entry._id = id;
+	entry._revision = _queryRevision;
+	return entry._info;
+}
+
+PositionInfo CurrentMap::getPositionInfoUncached(const Box &target, const Box &start, uint32 shapeflags, ObjId id) const {
 	PositionInfo info;
 	static const uint32 flagmask = (ShapeInfo::SI_SOLID | ShapeInfo::SI_DAMAGING | ShapeInfo::SI_LAND | ShapeInfo::SI_ROOF);
 	static const uint32 supportmask = (ShapeInfo::SI_SOLID | ShapeInfo::SI_LAND | ShapeInfo::SI_ROOF);
@@ -736,25 +872,43 @@ PositionInfo CurrentMap::getPositionInfo(const Box &target, const Box &start, ui
 	int maxy = (target._y / _mapChunkSize) + 1;
 	clipMapChunks(minx, maxx, miny, maxy);
 
+	_stats._queries++;
+
+	// Only items overlapping the target or below its center matter
+	const int32 areaminx = MIN(target._x - target._xd, midx);
+	const int32 areamaxx = MAX(target._x, midx);
+	const int32 areaminy = MIN(target._y - target._yd, midy);
+	const int32 areamaxy = MAX(target._y, midy);
+
+	Common::Array<ChunkEntry> scratch;
+
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			item_list::const_iterator iter;
-			for (iter = _items[cx][cy].begin();
-				 iter != _items[cx][cy].end(); ++iter) {
-				const Item *item = *iter;
-				if (item->getObjId() == id)
+			if (!chunkMayOverlap(cx, cy, areaminx, areaminy, areamaxx, areamaxy)) {
+				_stats._chunksSkipped++;
+				continue;
+			}
+			_stats._chunksScanned++;
+
+			const Common::Array<ChunkEntry> &entries = getChunkEntries(cx, cy, scratch, id, flagmask);
+			for (uint i = 0; i < entries.size(); i++) {
+				const ChunkEntry &entry = entries[i];
+				_stats._itemTests++;
+
+				if (entry._id == id)
 					continue;
-				if (item->hasExtFlags(Item::EXT_SPRITE))
+				if (entry._sprite)
 					continue;
 
-				const ShapeInfo *si = item->getShapeInfo();
-				if (!(si->_flags & flagmask))
+				const uint32 itemflags = entry._shapeFlags;
+				if (!(itemflags & flagmask))
 					continue; // not an interesting item
 
-				Box ib = item->getWorldBox();
+				const Item *item = entry._item;
+				const Box &ib = entry._box;
 
 				// check overlap
-				if ((si->_flags & shapeflags & blockmask) &&
+				if ((itemflags & shapeflags & blockmask) &&
 					target.overlaps(ib) && !start.overlaps(ib)) {
 					// overlapping an item. Invalid position
 #if 0
@@ -767,12 +921,12 @@ PositionInfo CurrentMap::getPositionInfo(const Box &target, const Box &start, ui
 
 				if (target.overlapsXY(ib)) {
 					// check support
-					if (si->_flags & supportmask && ib._z + ib._zd > supportz && ib._z + ib._zd <= target._z) {
+					if (itemflags & supportmask && ib._z + ib._zd > supportz && ib._z + ib._zd <= target._z) {
 						supportz = ib._z + ib._zd;
 					}
 
 					// check roof
-					if (si->is_roof() && ib._z < roofz && ib._z >= target._z + target._zd) {
+					if ((itemflags & ShapeInfo::SI_ROOF) && ib._z < roofz && ib._z >= target._z + target._zd) {
 						info.roof = item;
 						roofz = ib._z;
 					}
@@ -781,7 +935,7 @@ PositionInfo CurrentMap::getPositionInfo(const Box &target, const Box &start, ui
 				// check bottom center
 				if (ib.isBelow(midx, midy, target._z)) {
 					// check land
-					if (si->_flags & landmask && ib._z + ib._zd > landz) {
+					if (itemflags & landmask && ib._z + ib._zd > landz) {
 						info.land = item;
 						landz = ib._z + ib._zd;
 					}
@@ -850,24 +1004,39 @@ bool CurrentMap::scanForValidPosition(int32 x, int32 y, int32 z, const Item *ite
 	int maxy = (y / _mapChunkSize) + 1;
 	clipMapChunks(minx, maxx, miny, maxy);
 
+	_stats._queries++;
+
+	const ObjId itemid = item->getObjId();
+	Common::Array<ChunkEntry> scratch;
+
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			for (item_list::const_iterator iter = _items[cx][cy].begin();
-			        iter != _items[cx][cy].end(); ++iter) {
-				const Item *citem = *iter;
-				if (citem->getObjId() == item->getObjId())
+			// Items further than scansize from the footpad never touch the masks
+			if (!chunkMayOverlap(cx, cy, x - xd - scansize - 1, y - yd - scansize - 1,
+			                     x + scansize + 1, y + scansize + 1)) {
+				_stats._chunksSkipped++;
+				continue;
+			}
+			_stats._chunksScanned++;
+
+			const Common::Array<ChunkEntry> &entries = getChunkEntries(cx, cy, scratch, itemid, blockflagmask);
+			for (uint e = 0; e < entries.size(); e++) {
+				const ChunkEntry &entry = entries[e];
+				_stats._itemTests++;
+
+				if (entry._id == itemid)
 					continue;
-				if (citem->hasExtFlags(Item::EXT_SPRITE))
+				if (entry._sprite)
 					continue;
 
-				const ShapeInfo *si = citem->getShapeInfo();
 				//!! need to check is_sea() and is_land() maybe?
-				if (!(si->_flags & blockflagmask))
+				if (!(entry._shapeFlags & blockflagmask))
 					continue; // not an interesting item
 
-				int32 ixd, iyd, izd;
-				Point3 pt = citem->getLocation();
-				citem->getFootpadWorld(ixd, iyd, izd);
+				int32 ixd = entry._box._xd;
+				int32 iyd = entry._box._yd;
+				int32 izd = entry._box._zd;
+				Point3 pt(entry._box._x, entry._box._y, entry._box._z);
 
 				int minv = pt.z - z - zd + 1;
 				int maxv = pt.z + izd - z - 1;
@@ -906,7 +1075,7 @@ bool CurrentMap::scanForValidPosition(int32 x, int32 y, int32 z, const Item *ite
 					for (int i = minh; i <= maxh; ++i)
 						validmask[j + scansize] &= ~(1 << (i + scansize));
 
-				if (wantsupport && si->is_solid() &&
+				if (wantsupport && (entry._shapeFlags & ShapeInfo::SI_SOLID) &&
 				        pt.z + izd >= z - scansize && pt.z + izd <= z + scansize) {
 					for (int i = minh; i <= maxh; ++i)
 						supportmask[pt.z + izd - z + scansize] |= (1 << (i + scansize));
@@ -1034,18 +1203,39 @@ bool CurrentMap::sweepTest(const Point3 &start, const Point3 &end,
 	Std::list<SweepItem>::iterator sw_it;
 	if (hit) sw_it = hit->end();
 
+	_stats._queries++;
+
+	// Items outside of the swept area cannot be hit. Allow for the rounding
+	// of the hit times below, which grows with the velocity.
+	const int32 marginx = 2 + (ABS(vel[0]) >> 14);
+	const int32 marginy = 2 + (ABS(vel[1]) >> 14);
+	const int32 areaminx = MIN(start.x, end.x) - dims[0] - marginx;
+	const int32 areamaxx = MAX(start.x, end.x) + marginx;
+	const int32 areaminy = MIN(start.y, end.y) - dims[1] - marginy;
+	const int32 areamaxy = MAX(start.y, end.y) + marginy;
+
+	Common::Array<ChunkEntry> scratch;
+
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			item_list::const_iterator iter;
-			for (iter = _items[cx][cy].begin();
-			        iter != _items[cx][cy].end(); ++iter) {
-				const Item *other_item = *iter;
-				if (other_item->getObjId() == item)
+			if (!chunkMayOverlap(cx, cy, areaminx, areaminy, areamaxx, areamaxy)) {
+				_stats._chunksSkipped++;
+				continue;
+			}
+			_stats._chunksScanned++;
+
+			const Common::Array<ChunkEntry> &entries = getChunkEntries(cx, cy, scratch, item,
+			                                                           blocking_only ? shapeflags & blockflagmask : 0);
+			for (uint e = 0; e < entries.size(); e++) {
+				const ChunkEntry &entry = entries[e];
+				_stats._itemTests++;
+
+				if (entry._id == item)
 					continue;
-				if (other_item->hasExtFlags(Item::EXT_SPRITE))
+				if (entry._sprite)
 					continue;
 
-				uint32 othershapeflags = other_item->getShapeInfo()->_flags;
+				uint32 othershapeflags = entry._shapeFlags;
 				bool blocking = (othershapeflags & shapeflags &
 				                 blockflagmask) != 0;
 
@@ -1055,11 +1245,12 @@ bool CurrentMap::sweepTest(const Point3 &start, const Point3 &end,
 					continue;
 
 				int32 other[3], oext[3];
-				Point3 opt = other_item->getLocation();
-				other[0] = opt.x;
-				other[1] = opt.y;
-				other[2] = opt.z;
-				other_item->getFootpadWorld(oext[0], oext[1], oext[2]);
+				other[0] = entry._box._x;
+				other[1] = entry._box._y;
+				other[2] = entry._box._z;
+				oext[0] = entry._box._xd;
+				oext[1] = entry._box._yd;
+				oext[2] = entry._box._zd;
 
 				// If the objects overlapped at the start, ignore collision.
 				// The -1 and +1 portions are to still consider collisions
@@ -1200,10 +1391,10 @@ bool CurrentMap::sweepTest(const Point3 &start, const Point3 &end,
 					}
 
 					// Now add it
-					sw_it = hit->insert(sw_it, SweepItem(other_item->getObjId(), first, last, touch, touch_floor, blocking, dirs));
+					sw_it = hit->insert(sw_it, SweepItem(entry._id, first, last, touch, touch_floor, blocking, dirs));
 
 					//debugC(kDebugCollision, "Hit item %u (%d, %d, %d) at first: %d, last: %d",
-					//	   other_item->getObjId(), other[0], other[1], other[2], first, last);
+					//	   entry._id, other[0], other[1], other[2], first, last);
 					//debugC(kDebugCollision, "hit item time (%d-%d) (%d-%d) (%d-%d)",
 					//	u_0[0], u_1[0], u_0[1], u_1[1], u_0[2], u_1[2]);
 					//debugC(kDebugCollision, "touch: %d, floor: %d, block: %d", touch, touch_floor, blocking);
@@ -22,7 +22,9 @@
 #ifndef ULTIMA8_WORLD_CURRENTMAP_H
 #define ULTIMA8_WORLD_CURRENTMAP_H
 
+#include "common/array.h"
 #include "ultima/shared/std/containers.h"
+#include "ultima/ultima8/misc/box.h"
 #include "ultima/ultima8/usecode/intrinsics.h"
 #include "ultima/ultima8/world/position_info.h"
 #include "ultima/ultima8/misc/direction.h"
@@ -31,7 +33,6 @@
 namespace Ultima {
 namespace Ultima8 {
 
-struct Box;
 class Map;
 class Item;
 class UCList;
@@ -73,6 +74,9 @@ public:
 	void removeItemFromList(Item *item, int32 oldx, int32 oldy);
 	void removeItem(Item *item);
 
+	//! Notify the map that the footpad of an item in it may have grown
+	void updateChunkFootpad(const Item *item);
+
 	//! Add an item to the list of possible targets (in Crusader)
 	void addTargetItem(const Item *item);
 	//! Remove an item from the list of possible targets (in Crusader)
@@ -192,7 +196,94 @@ public:
 	INTRINSIC(I_canExistAt);
 	INTRINSIC(I_canExistAtPoint);
 
+	//! Counters of the collision and search queries
+	struct QueryStats {
+		uint32 _queries;        // Number of queries
+		uint32 _chunksScanned;  // Chunks whose items were tested
+		uint32 _chunksSkipped;  // Chunks skipped as too far from the query
+		uint32 _itemTests;      // Items tested against a query
+		uint32 _cacheHits;      // Queries answered from the result cache
+		uint32 _startFrame;     // Kernel frame number at the last reset
+
+		QueryStats() : _queries(0), _chunksScanned(0), _chunksSkipped(0),
+			_itemTests(0), _cacheHits(0), _startFrame(0) { }
+	};
+
+	const QueryStats &getQueryStats() const {
+		return _stats;
+	}
+	void resetQueryStats();
+
+	//! While a QueryCacheScope is alive, getPositionInfo, sweepTest and
+	//! scanForValidPosition work on compact per-chunk copies of the item
+	//! boxes and shape flags, and getPositionInfo results are cached.
+	//! The copies are only invalidated by CurrentMap::addItem,
+	//! removeItemFromList and Item::move, so no item may change otherwise
+	//! (e.g. with setLocation or setShape) while the scope is alive.
+	class QueryCacheScope {
+	public:
+		QueryCacheScope(CurrentMap *map) : _map(map) {
+			if (_map)
+				_map->beginQueryCache();
+		}
+		~QueryCacheScope() {
+			if (_map)
+				_map->endQueryCache();
+		}
+	private:
+		CurrentMap *_map;
+	};
+
+	//! Invalidate the data cached for the current QueryCacheScope
+	void invalidateQueryCache() {
+		_queryRevision++;
+	}
+
 private:
+	//! Item data needed by the collision queries
+	struct ChunkEntry {
+		const Item *_item;
+		Box _box;
+		uint32 _shapeFlags;
+		ObjId _id;
+		bool _sprite;
+	};
+
+	struct ChunkCache {
+		Common::Array<ChunkEntry> _entries;
+		uint32 _revision;
+
+		ChunkCache() : _revision(0) { }
+	};
+
+	struct PositionCacheEntry {
+		Box _target;
+		Box _start;
+		uint32 _shapeFlags;
+		ObjId _id;
+		uint32 _revision;
+		PositionInfo _info;
+
+		PositionCacheEntry() : _shapeFlags(0), _id(0), _revision(0) { }
+	};
+
+	void beginQueryCache();
+	void endQueryCache();
+
+	//! Get the items of a chunk, from the query cache if enabled, or
+	//! otherwise copied into scratch. Only the copies skip the item id,
+	//! sprites and, if flagmask is not 0, items without any of its shape
+	//! flags, so callers still have to check these on cached entries.
+	const Common::Array<ChunkEntry> &getChunkEntries(int cx, int cy, Common::Array<ChunkEntry> &scratch,
+	                                                 ObjId id, uint32 flagmask) const;
+
+	//! Check if any item of the chunk may extend into the given world area
+	//! (inclusive). Items lie in their chunk and extend towards negative x
+	//! and y by their footpad.
+	bool chunkMayOverlap(int cx, int cy, int32 minx, int32 miny, int32 maxx, int32 maxy) const;
+
+	PositionInfo getPositionInfoUncached(const Box &target, const Box &start, uint32 shapeflags, ObjId id) const;
+
 	void loadItems(const Std::list<Item *> &itemlist, bool callCacheIn);
 	void createEggHatcher();
 
@@ -219,6 +310,16 @@ private:
 
 	void setChunkFast(int32 cx, int32 cy);
 	void unsetChunkFast(int32 cx, int32 cy);
+
+	//! Largest x or y footpad of the items added to each chunk
+	int32 _chunkFootpad[MAP_NUM_CHUNKS][MAP_NUM_CHUNKS];
+
+	mutable ChunkCache _chunkCache[MAP_NUM_CHUNKS][MAP_NUM_CHUNKS];
+	mutable PositionCacheEntry _positionCache[64];
+	uint32 _queryRevision;
+	int _queryCacheDepth;
+
+	mutable QueryStats _stats;
 };
 
 } // End of namespace Ultima8
@@ -215,6 +215,8 @@ void Item::move(int32 X, int32 Y, int32 Z) {
 	_y = Y;
 	_z = Z;
 
+	map->invalidateQueryCache();
+
 	// Add it back to the map if needed
 	if (!(_extendedFlags & EXT_INCURMAP)) {
 		// Disposable fast only items get put at the end
@@ -502,6 +504,10 @@ void Item::setShape(uint32 shape) {
 		_shape = shape;
 		_cachedShapeInfo = nullptr;
 	}
+
+	// The chunk may now hold a larger item
+	if (_extendedFlags & EXT_INCURMAP)
+		World::get_instance()->getCurrentMap()->updateChunkFootpad(this);
 }
 
 bool Item::overlaps(const Item &item2) const {
@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "ultima/ultima.h"
 #include "ultima/ultima8/misc/common_types.h"
 #include "ultima/ultima8/world/item_sorter.h"
@@ -45,16 +46,24 @@ namespace Ultima8 {
 static const uint32 TRANSPARENT_COLOR = TEX32_PACK_RGBA(0x7F, 0x00, 0x00, 0x7F);
 static const uint32 HIGHLIGHT_COLOR = TEX32_PACK_RGBA(0xFF, 0xFF, 0x00, 0x1F);
 
+// Size in pixels of the screenspace buckets used to find overlapping items
+static const int32 CELL_SIZE = 64;
+
 ItemSorter::ItemSorter(int capacity) :
 	_shapes(nullptr), _clipWindow(0, 0, 0, 0), _items(nullptr), _itemsTail(nullptr),
 	_itemsUnused(nullptr), _painted(nullptr), _camSx(0), _camSy(0),
-	_sortLimit(0), _sortLimitChanged(false) {
+	_sortLimit(0), _sortLimitChanged(false), _sorted(true), _listValid(false),
+	_viewChanged(true), _cellCols(0), _cellRows(0), _visitStamp(0), _sequence(0),
+	_itemsSorted(0), _comparisons(0), _reused(false) {
 	int i = capacity;
 	while (i--) {
 		SortItem *next = _itemsUnused;
 		_itemsUnused = new SortItem();
 		_itemsUnused->_next = next;
 	}
+
+	_entries.reserve(capacity);
+	_prevEntries.reserve(capacity);
 }
 
 ItemSorter::~ItemSorter() {
@@ -76,16 +85,14 @@ void ItemSorter::BeginDisplayList(const Rect &clipWindow, const Point3 &cam) {
 	// Get the _shapes, if required
 	if (!_shapes) _shapes = GameData::get_instance()->getMainShapes();
 
-	// Set the clip window, and reset the item list
+	// Set the clip window, and reset the entries. The item list itself is
+	// kept until we know whether it can be reused.
+	if (!_clipWindow.equals(clipWindow))
+		_viewChanged = true;
 	_clipWindow = clipWindow;
 
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
-	}
-
-	_items = nullptr;
-	_itemsTail = nullptr;
+	_entries.resize(0);
+	_sorted = false;
 	_painted = nullptr;
 
 	// Screenspace bounding box bottom x coord (RNB x coord)
@@ -96,6 +103,7 @@ void ItemSorter::BeginDisplayList(const Rect &clipWindow, const Point3 &cam) {
 	if (camSx != _camSx || camSy != _camSy) {
 		_camSx = camSx;
 		_camSy = camSy;
+		_viewChanged = true;
 
 		// Reset sort limit debugging on camera move
 		_sortLimit = 0;
@@ -103,16 +111,165 @@ void ItemSorter::BeginDisplayList(const Rect &clipWindow, const Point3 &cam) {
 }
 
 void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, uint32 flags, uint32 ext_flags, uint16 itemNum) {
+	DisplayEntry entry;
+	entry._pt = pt;
+	entry._shapeNum = shapeNum;
+	entry._frame = frame_num;
+	entry._flags = flags;
+	entry._extFlags = ext_flags;
+	entry._itemNum = itemNum;
+	_entries.push_back(entry);
+}
+
+void ItemSorter::FinishDisplayList() {
+	if (_sorted)
+		return;
+	_sorted = true;
+
+	// Nothing moved, changed shape or frame since the last frame. The
+	// list, the dependencies and the occlusion are all still valid.
+	if (_listValid && !_viewChanged && _entries == _prevEntries) {
+		for (SortItem *si = _items; si != nullptr; si = si->_next)
+			si->_order = -1;
+
+		_itemsSorted = 0;
+		_comparisons = 0;
+		_reused = true;
+		return;
+	}
+
+	if (_itemsTail) {
+		_itemsTail->_next = _itemsUnused;
+		_itemsUnused = _items;
+	}
+
+	_items = nullptr;
+	_itemsTail = nullptr;
+
+	ResetCells();
+	_keyTails.resize(0);
+	_sequence = 0;
+	_itemsSorted = 0;
+	_comparisons = 0;
+	_reused = false;
+
+	for (uint i = 0; i < _entries.size(); i++)
+		SortEntry(_entries[i]);
+
+	_prevEntries.swap(_entries);
+	_listValid = true;
+	_viewChanged = false;
+}
+
+void ItemSorter::ResetCells() {
+	int32 w = MAX<int32>(_clipWindow.right - _clipWindow.left, 1);
+	int32 h = MAX<int32>(_clipWindow.bottom - _clipWindow.top, 1);
+	_cellCols = (w + CELL_SIZE - 1) / CELL_SIZE;
+	_cellRows = (h + CELL_SIZE - 1) / CELL_SIZE;
+
+	_cells.resize(_cellCols * _cellRows);
+	for (uint i = 0; i < _cells.size(); i++)
+		_cells[i].resize(0);
+}
+
+void ItemSorter::GetCellRange(const Rect &r, int32 &cx0, int32 &cy0, int32 &cx1, int32 &cy1) const {
+	// Parts outside the clip window are clamped to the border cells. As
+	// the mapping is monotonic, two intersecting rects always share a cell.
+	// Empty rects still intersect others in this sense, so they get a cell.
+	int32 w = MAX<int32>(_clipWindow.right - _clipWindow.left, 1);
+	int32 h = MAX<int32>(_clipWindow.bottom - _clipWindow.top, 1);
+	cx0 = CLIP<int32>(r.left - _clipWindow.left, 0, w - 1) / CELL_SIZE;
+	cy0 = CLIP<int32>(r.top - _clipWindow.top, 0, h - 1) / CELL_SIZE;
+	cx1 = CLIP<int32>(MAX(r.left, r.right - 1) - _clipWindow.left, 0, w - 1) / CELL_SIZE;
+	cy1 = CLIP<int32>(MAX(r.top, r.bottom - 1) - _clipWindow.top, 0, h - 1) / CELL_SIZE;
+}
+
+// Order of the items in the display list: by listLessThan, and in
+// insertion order between items with the same key
+static bool listOrderLess(const SortItem *si1, const SortItem *si2) {
+	if (si1->listLessThan(*si2))
+		return true;
+	if (si2->listLessThan(*si1))
+		return false;
+	return si1->_sequence < si2->_sequence;
+}
+
+void ItemSorter::GatherCandidates(const SortItem *si) {
+	_candidates.resize(0);
+
+#ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
+	// Adjoining items need not overlap, so every item is a candidate
+	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next)
+		_candidates.push_back(si2);
+#else
+	int32 cx0, cy0, cx1, cy1;
+	GetCellRange(si->_sr, cx0, cy0, cx1, cy1);
+
+	_visitStamp++;
+	for (int32 cy = cy0; cy <= cy1; cy++) {
+		for (int32 cx = cx0; cx <= cx1; cx++) {
+			const Common::Array<SortItem *> &cell = _cells[cy * _cellCols + cx];
+			for (uint i = 0; i < cell.size(); i++) {
+				SortItem *si2 = cell[i];
+				if (si2->_visit != _visitStamp) {
+					si2->_visit = _visitStamp;
+					_candidates.push_back(si2);
+				}
+			}
+		}
+	}
+
+	// Dependencies and occlusion must be resolved in list order, exactly
+	// as if the whole list was scanned
+	Common::sort(_candidates.begin(), _candidates.end(), listOrderLess);
+#endif
+}
+
+void ItemSorter::InsertIntoList(SortItem *si) {
+	// Insert before the first item that has higher z than us, which is
+	// right after the last item of the same or the closest lower key
+	uint lo = 0;
+	uint hi = _keyTails.size();
+	while (lo < hi) {
+		uint mid = (lo + hi) / 2;
+		if (si->listLessThan(*_keyTails[mid]))
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+
+	SortItem *prev = lo > 0 ? _keyTails[lo - 1] : nullptr;
+	if (prev && !prev->listLessThan(*si))
+		_keyTails[lo - 1] = si;
+	else
+		_keyTails.insert_at(lo, si);
+
+	si->_prev = prev;
+	si->_next = prev ? prev->_next : _items;
+	if (si->_next)
+		si->_next->_prev = si;
+	else
+		_itemsTail = si;
+	if (prev)
+		prev->_next = si;
+	else
+		_items = si;
+}
+
+void ItemSorter::SortEntry(const DisplayEntry &entry) {
+	const Point3 &pt = entry._pt;
+	uint32 shapeNum = entry._shapeNum;
+	uint32 flags = entry._flags;
 
 	// First thing, get a SortItem to use (first of unused)
 	if (!_itemsUnused)
 		_itemsUnused = new SortItem();
 	SortItem *si = _itemsUnused;
 
-	si->_itemNum = itemNum;
+	si->_itemNum = entry._itemNum;
 	si->_shape = _shapes->getShape(shapeNum);
 	si->_shapeNum = shapeNum;
-	si->_frame = frame_num;
+	si->_frame = entry._frame;
 	const ShapeFrame *frame = si->_shape ? si->_shape->getFrame(si->_frame) : nullptr;
 	if (!frame) {
 		// Keep the last shape we skipped so we don't spam the warnings too much
@@ -127,7 +284,7 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 	}
 
 	si->_flags = flags;
-	si->_extFlags = ext_flags;
+	si->_extFlags = entry._extFlags;
 
 	const ShapeInfo *info = _shapes->getShapeInfo(shapeNum);
 	// Dimensions
@@ -187,14 +344,10 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 	// are never deleted
 	si->_depends.clear();
 
-	// Iterate the list and compare _shapes
-
-	// Ok,
-	SortItem *addpoint = nullptr;
-	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
-		// Get the insert point... which is before the first item that has higher z than us
-		if (!addpoint && si->listLessThan(*si2))
-			addpoint = si2;
+	// Compare against the items whose screenspace rect may overlap ours
+	GatherCandidates(si);
+	for (uint i = 0; i < _candidates.size(); i++) {
+		SortItem *si2 = _candidates[i];
 
 		if (si2->_occluded)
 			continue;
@@ -221,6 +374,7 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 #endif // SORTITEM_OCCLUSION_EXPERIMENTAL
 
 		// Attempt to find paint dependency order
+		_comparisons++;
 		if (si->overlap(*si2)) {
 			if (si->below(*si2)) {
 				if (si2->_occl && si2->occludes(*si)) {
@@ -245,27 +399,18 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 
 	// Add it to the list
 	_itemsUnused = _itemsUnused->_next;
-
-	// have a position
-	//addpoint = 0;
-	if (addpoint) {
-		si->_next = addpoint;
-		si->_prev = addpoint->_prev;
-		addpoint->_prev = si;
-		if (si->_prev)
-			si->_prev->_next = si;
-		else
-			_items = si;
-	}
-	// Add it to the end of the list
-	else {
-		if (_itemsTail)
-			_itemsTail->_next = si;
-		if (!_items)
-			_items = si;
-		si->_next = nullptr;
-		si->_prev = _itemsTail;
-		_itemsTail = si;
+	si->_sequence = _sequence++;
+	InsertIntoList(si);
+	_itemsSorted++;
+
+	// Occluded items are skipped by later comparisons anyway
+	if (!si->_occluded) {
+		int32 cx0, cy0, cx1, cy1;
+		GetCellRange(si->_sr, cx0, cy0, cx1, cy1);
+		for (int32 cy = cy0; cy <= cy1; cy++) {
+			for (int32 cx = cx0; cx <= cx1; cx++)
+				_cells[cy * _cellCols + cx].push_back(si);
+		}
 	}
 }
 
@@ -275,6 +420,8 @@ void ItemSorter::AddItem(const Item *add) {
 }
 
 void ItemSorter::PaintDisplayList(RenderSurface *surf, bool item_highlight, bool showFootpads) {
+	FinishDisplayList();
+
 	if (_sortLimit) {
 		// Clear the surface when debugging the sorter
 		uint32 color = TEX32_PACK_RGB(0, 0, 0);
@@ -507,6 +654,8 @@ uint16 ItemSorter::Trace(int32 x, int32 y, HitFace *face, bool item_highlight) {
 	SortItem *it;
 	SortItem *selected;
 
+	FinishDisplayList();
+
 	if (!_painted) { // If no painted item found, we need to sort the items
 		it = _items;
 		_painted = nullptr;
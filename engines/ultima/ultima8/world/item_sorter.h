@@ -22,7 +22,10 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "common/array.h"
+#include "common/stream.h"
 #include "ultima/ultima8/misc/rect.h"
+#include "ultima/ultima8/misc/point3.h"
 
 namespace Ultima {
 namespace Ultima8 {
@@ -31,7 +34,6 @@ class MainShapeArchive;
 class Item;
 class RenderSurface;
 struct SortItem;
-struct Point3;
 
 class ItemSorter {
 	MainShapeArchive    *_shapes;
@@ -46,6 +48,48 @@ class ItemSorter {
 	int32       _sortLimit;
 	bool        _sortLimitChanged;
 
+	// Items added since BeginDisplayList, in the order they were added.
+	// The list is only sorted once it is needed, so that an unchanged
+	// frame can reuse the ordering of the previous one.
+	struct DisplayEntry {
+		Point3 _pt;
+		uint32 _shapeNum;
+		uint32 _frame;
+		uint32 _flags;
+		uint32 _extFlags;
+		uint16 _itemNum;
+
+		bool operator==(const DisplayEntry &o) const {
+			return _pt == o._pt && _shapeNum == o._shapeNum && _frame == o._frame &&
+				_flags == o._flags && _extFlags == o._extFlags && _itemNum == o._itemNum;
+		}
+		bool operator!=(const DisplayEntry &o) const {
+			return !(*this == o);
+		}
+	};
+
+	Common::Array<DisplayEntry> _entries;
+	Common::Array<DisplayEntry> _prevEntries;
+	bool        _sorted;        // Display list has been built for this frame
+	bool        _listValid;     // Display list matches _prevEntries
+	bool        _viewChanged;   // Clip window or camera moved since last frame
+
+	// Screenspace buckets of the items in the list, used to find the items
+	// that may overlap a new one without testing the whole list
+	Common::Array<Common::Array<SortItem *> > _cells;
+	int32       _cellCols, _cellRows;
+	Common::Array<SortItem *> _candidates;
+	uint32      _visitStamp;
+	uint32      _sequence;
+
+	// Last list item of each distinct listLessThan key, in list order
+	Common::Array<SortItem *> _keyTails;
+
+	// Statistics of the last built frame
+	uint32      _itemsSorted;
+	uint32      _comparisons;
+	bool        _reused;
+
 public:
 	ItemSorter(int capacity);
 	~ItemSorter();
@@ -69,7 +113,32 @@ public:
 
 	void IncSortLimit(int count);
 
+	// Force the next frame to be sorted from scratch
+	void InvalidateDisplayList() {
+		_listValid = false;
+	}
+
+	// Sorting statistics for the last painted frame
+	uint32 getItemsSorted() const {
+		return _itemsSorted;
+	}
+	uint32 getComparisons() const {
+		return _comparisons;
+	}
+	bool isDisplayListReused() const {
+		return _reused;
+	}
+
 private:
+	// Sort the items added since BeginDisplayList, unless already done
+	void FinishDisplayList();
+
+	void SortEntry(const DisplayEntry &entry);
+	void ResetCells();
+	void GetCellRange(const Rect &r, int32 &cx0, int32 &cy0, int32 &cx1, int32 &cy1) const;
+	void GatherCandidates(const SortItem *si);
+	void InsertIntoList(SortItem *si);
+
 	bool PaintSortItem(RenderSurface *surf, SortItem *si, bool showFootpad);
 };
 
@@ -49,6 +49,8 @@ Console::Console(ZVision *engine) : GUI::Debugger(), _engine(engine) {
 	registerCmd("generaterendertable", WRAP_METHOD(Console, cmdGenerateRenderTable));
 	registerCmd("setpanoramafov", WRAP_METHOD(Console, cmdSetPanoramaFoV));
 	registerCmd("setpanoramascale", WRAP_METHOD(Console, cmdSetPanoramaScale));
+	registerCmd("warpfilter", WRAP_METHOD(Console, cmdWarpFilter));
+	registerCmd("benchmarkwarp", WRAP_METHOD(Console, cmdBenchmarkWarp));
 	registerCmd("location", WRAP_METHOD(Console, cmdLocation));
 	registerCmd("dumpfile", WRAP_METHOD(Console, cmdDumpFile));
 	registerCmd("dumpfiles", WRAP_METHOD(Console, cmdDumpFiles));
@@ -200,6 +202,54 @@ bool Console::cmdSetPanoramaScale(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdWarpFilter(int argc, const char **argv) {
+	RenderTable *renderTable = _engine->getRenderManager()->getRenderTable();
+
+	if (argc == 2 && (!strcmp(argv[1], "on") || !strcmp(argv[1], "off"))) {
+		renderTable->setBilinearFilter(!strcmp(argv[1], "on"));
+		_engine->getRenderManager()->markDirty();
+	} else if (argc != 1) {
+		debugPrintf("Use %s [on|off] to toggle the bilinear filtering of panoramas and tilts\n", argv[0]);
+		return true;
+	}
+
+	debugPrintf("Bilinear filtering is %s\n", renderTable->getBilinearFilter() ? "on" : "off");
+	return true;
+}
+
+bool Console::cmdBenchmarkWarp(int argc, const char **argv) {
+	RenderManager *renderManager = _engine->getRenderManager();
+	int steps = (argc == 2) ? atoi(argv[1]) : 360;
+
+	if (argc > 2 || steps <= 0) {
+		debugPrintf("Use %s [steps] to time a full turn around the current panorama\n", argv[0]);
+		return true;
+	}
+
+	if (renderManager->getRenderTable()->getRenderState() != RenderTable::PANORAMA) {
+		debugPrintf("The current location is not a panorama\n");
+		return true;
+	}
+
+	int16 width = renderManager->getBkgSize().x;
+	int startPosition = renderManager->getCurrentBackgroundOffset();
+
+	uint32 start = g_system->getMillis();
+	for (int i = 0; i < steps; i++) {
+		renderManager->setBackgroundPosition((startPosition + width * i / steps) % width);
+		renderManager->prepareBackground();
+		renderManager->renderSceneToScreen();
+	}
+	uint32 time = MAX<uint32>(g_system->getMillis() - start, 1);
+
+	renderManager->setBackgroundPosition(startPosition);
+	renderManager->prepareBackground();
+	renderManager->renderSceneToScreen();
+
+	debugPrintf("%d steps in %d ms, %.1f steps/s\n", steps, time, steps * 1000.0 / time);
+	return true;
+}
+
 bool Console::cmdLocation(int argc, const char **argv) {
 	Location curLocation = _engine->getScriptManager()->getCurrentLocation();
 	Common::String scrFile = Common::String::format("%c%c%c%c.scr", curLocation.world, curLocation.room, curLocation.node, curLocation.view);
@@ -115,9 +115,8 @@ void RenderManager::renderSceneToScreen() {
 	RenderTable::RenderState state = _renderTable.getRenderState();
 	if (state == RenderTable::PANORAMA || state == RenderTable::TILT) {
 		if (!_backgroundSurfaceDirtyRect.isEmpty()) {
-			_renderTable.mutateImage(&_warpedSceneSurface, in);
+			outWndDirtyRect = _renderTable.mutateImage(&_warpedSceneSurface, in, _backgroundSurfaceDirtyRect);
 			out = &_warpedSceneSurface;
-			outWndDirtyRect = Common::Rect(_workingWindow.width(), _workingWindow.height());
 		}
 	} else {
 		out = in;
@@ -30,21 +30,40 @@ namespace ZVision {
 RenderTable::RenderTable(uint numColumns, uint numRows)
 	: _numRows(numRows),
 	  _numColumns(numColumns),
-	  _renderState(FLAT) {
+	  _renderState(FLAT),
+	  _useSpans(false),
+	  _bilinearFilter(false),
+	  _fullWarpNeeded(true) {
 	assert(numRows != 0 && numColumns != 0);
 
 	_internalBuffer = new Common::Point[numRows * numColumns];
+	_sourceOffsets = new uint32[numRows * numColumns];
+	_filterWeights = new uint16[numRows * numColumns];
 
 	memset(&_panoramaOptions, 0, sizeof(_panoramaOptions));
 	memset(&_tiltOptions, 0, sizeof(_tiltOptions));
+
+	// Until a table is generated, the pixels are not moved
+	for (uint y = 0; y < numRows; ++y) {
+		for (uint x = 0; x < numColumns; ++x)
+			setSourcePixel(x, y, x, y);
+	}
+	generateWarpData();
+
+	_generated.state = FLAT;
+	_generated.fieldOfView = 0.0f;
+	_generated.linearScale = 0.0f;
 }
 
 RenderTable::~RenderTable() {
 	delete[] _internalBuffer;
+	delete[] _sourceOffsets;
+	delete[] _filterWeights;
 }
 
 void RenderTable::setRenderState(RenderState newState) {
 	_renderState = newState;
+	_fullWarpNeeded = true;
 
 	switch (newState) {
 	case PANORAMA:
@@ -105,52 +124,196 @@ void RenderTable::mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 d
 }
 
 void RenderTable::mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf) {
-	uint32 destOffset = 0;
+	uint16 *sourceBuffer = (uint16 *)srcBuf->getPixels();
+	uint16 *destBuffer = (uint16 *)dstBuf->getPixels();
+
+	if (_bilinearFilter)
+		warpRowsBilinear(destBuffer, sourceBuffer, 0, srcBuf->h);
+	else
+		warpRows(destBuffer, sourceBuffer, 0, srcBuf->h);
+}
 
+Common::Rect RenderTable::mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf, const Common::Rect &srcDirtyRect) {
 	uint16 *sourceBuffer = (uint16 *)srcBuf->getPixels();
 	uint16 *destBuffer = (uint16 *)dstBuf->getPixels();
+	Common::Rect dstDirtyRect;
+
+	for (uint strip = 0; strip < _stripSources.size(); ++strip) {
+		if (!_fullWarpNeeded && !_stripSources[strip].intersects(srcDirtyRect))
+			continue;
+
+		uint firstRow = strip * kStripHeight;
+		uint lastRow = MIN<uint>(firstRow + kStripHeight, _numRows);
+		if (_bilinearFilter)
+			warpRowsBilinear(destBuffer, sourceBuffer, firstRow, lastRow);
+		else
+			warpRows(destBuffer, sourceBuffer, firstRow, lastRow);
+
+		Common::Rect stripRect(0, firstRow, _numColumns, lastRow);
+		if (dstDirtyRect.isEmpty())
+			dstDirtyRect = stripRect;
+		else
+			dstDirtyRect.extend(stripRect);
+	}
 
-	for (int16 y = 0; y < srcBuf->h; ++y) {
-		uint32 sourceOffset = y * _numColumns;
+	_fullWarpNeeded = false;
+	return dstDirtyRect;
+}
 
-		for (int16 x = 0; x < srcBuf->w; ++x) {
-			uint32 index = sourceOffset + x;
+void RenderTable::warpRows(uint16 *dst, const uint16 *src, uint firstRow, uint lastRow) {
+	if (_useSpans) {
+		// Copy the runs of consecutive source pixels as a whole
+		for (uint y = firstRow; y < lastRow; ++y) {
+			uint16 *dstRow = dst + y * _numColumns;
+			for (uint i = _rowSpans[y]; i < _rowSpans[y + 1]; ++i) {
+				const Span &span = _spans[i];
+				memcpy(dstRow + span.dstX, src + span.srcOffset, span.length * sizeof(uint16));
+			}
+		}
+		return;
+	}
 
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
+	const uint32 *offsets = _sourceOffsets + firstRow * _numColumns;
+	uint16 *dstEnd = dst + lastRow * _numColumns;
+	for (dst += firstRow * _numColumns; dst != dstEnd; ++dst, ++offsets)
+		*dst = src[*offsets];
+}
+
+// ZVision backgrounds are always RGB555. Spreading the channels apart leaves
+// room for interpolating all three of them with a single multiplication.
+static inline uint32 spreadRGB555(uint16 color) {
+	return (color | ((uint32)color << 16)) & 0x03E07C1F;
+}
+
+static inline uint32 lerpSpreadRGB555(uint32 a, uint32 b, uint weight) {
+	return ((a * (32 - weight) + b * weight) >> 5) & 0x03E07C1F;
+}
 
-			destBuffer[destOffset] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-			destOffset++;
+void RenderTable::warpRowsBilinear(uint16 *dst, const uint16 *src, uint firstRow, uint lastRow) {
+	for (uint y = firstRow; y < lastRow; ++y) {
+		uint index = y * _numColumns;
+		for (uint x = 0; x < _numColumns; ++x, ++index) {
+			uint32 offset = _sourceOffsets[index];
+			uint16 weights = _filterWeights[index];
+			// The neighbours with a weight of zero are not read, which also keeps the edges in bounds
+			uint32 nextX = (weights >> 8) ? 1 : 0;
+			uint32 nextY = (weights & 0xFF) ? _numColumns : 0;
+
+			uint32 top = lerpSpreadRGB555(spreadRGB555(src[offset]), spreadRGB555(src[offset + nextX]), weights >> 8);
+			uint32 bottom = lerpSpreadRGB555(spreadRGB555(src[offset + nextY]), spreadRGB555(src[offset + nextY + nextX]), weights >> 8);
+			uint32 color = lerpSpreadRGB555(top, bottom, weights & 0xFF);
+			dst[index] = (uint16)(color | (color >> 16));
 		}
 	}
 }
 
+void RenderTable::setBilinearFilter(bool enable) {
+	if (_bilinearFilter != enable)
+		_fullWarpNeeded = true;
+	_bilinearFilter = enable;
+}
+
 void RenderTable::generateRenderTable() {
+	float fieldOfView, linearScale;
+
 	switch (_renderState) {
 	case ZVision::RenderTable::PANORAMA:
-		generatePanoramaLookupTable();
+		fieldOfView = _panoramaOptions.fieldOfView;
+		linearScale = _panoramaOptions.linearScale;
 		break;
 	case ZVision::RenderTable::TILT:
-		generateTiltLookupTable();
+		fieldOfView = _tiltOptions.fieldOfView;
+		linearScale = _tiltOptions.linearScale;
 		break;
 	case ZVision::RenderTable::FLAT:
-		// Intentionally left empty
-		break;
 	default:
-		break;
+		// Intentionally left empty
+		return;
 	}
+
+	// The tables only depend on the viewport size, which never changes, and
+	// on the view parameters. Most locations use the same ones.
+	if (_generated.state == _renderState && _generated.fieldOfView == fieldOfView && _generated.linearScale == linearScale)
+		return;
+
+	if (_renderState == PANORAMA)
+		generatePanoramaLookupTable();
+	else
+		generateTiltLookupTable();
+
+	generateWarpData();
+
+	_generated.state = _renderState;
+	_generated.fieldOfView = fieldOfView;
+	_generated.linearScale = linearScale;
+	_fullWarpNeeded = true;
 }
 
-void RenderTable::generatePanoramaLookupTable() {
-	for (uint y = 0; y < _numRows; y++) {
-		for (uint x = 0; x < _numColumns; x++) {
-			uint32 index = y * _numColumns + x;
-			_internalBuffer[index].x = 0;
-			_internalBuffer[index].y = 0;
+void RenderTable::setSourcePixel(uint x, uint y, float sourceX, float sourceY) {
+	int32 xInCylinderCoords = int32(floor(sourceX));
+	int32 yInCylinderCoords = int32(floor(sourceY));
+
+	uint32 index = y * _numColumns + x;
+
+	// Only store the (x,y) offsets instead of the absolute positions
+	_internalBuffer[index].x = xInCylinderCoords - x;
+	_internalBuffer[index].y = yInCylinderCoords - y;
+
+	_sourceOffsets[index] = yInCylinderCoords * _numColumns + xInCylinderCoords;
+
+	// Repeat the last column and row at the edges
+	int weightX = (xInCylinderCoords + 1 < (int32)_numColumns) ? int((sourceX - xInCylinderCoords) * 32.0f) : 0;
+	int weightY = (yInCylinderCoords + 1 < (int32)_numRows) ? int((sourceY - yInCylinderCoords) * 32.0f) : 0;
+	_filterWeights[index] = (uint16)((weightX << 8) | weightY);
+}
+
+void RenderTable::generateWarpData() {
+	// Split every row into runs of consecutive source pixels
+	_spans.clear();
+	_rowSpans.resize(_numRows + 1);
+
+	for (uint y = 0; y < _numRows; ++y) {
+		_rowSpans[y] = _spans.size();
+		const uint32 *offsets = _sourceOffsets + y * _numColumns;
+
+		for (uint x = 0; x < _numColumns; ++x) {
+			if (x > 0 && offsets[x] == offsets[x - 1] + 1 && _spans.back().length < 0xFFFF) {
+				++_spans.back().length;
+			} else {
+				Span span;
+				span.dstX = x;
+				span.length = 1;
+				span.srcOffset = offsets[x];
+				_spans.push_back(span);
+			}
 		}
 	}
+	_rowSpans[_numRows] = _spans.size();
 
+	_useSpans = _spans.size() * kMinAverageSpanLength <= _numRows * _numColumns;
+
+	// Find the source pixels of every strip, including the neighbours read by the filter
+	_stripSources.resize((_numRows + kStripHeight - 1) / kStripHeight);
+
+	for (uint strip = 0; strip < _stripSources.size(); ++strip) {
+		uint firstRow = strip * kStripHeight;
+		uint lastRow = MIN<uint>(firstRow + kStripHeight, _numRows);
+		int16 left = 0x7FFF, top = 0x7FFF, right = 0, bottom = 0;
+
+		for (uint index = firstRow * _numColumns; index < lastRow * _numColumns; ++index) {
+			int16 sourceX = _sourceOffsets[index] % _numColumns;
+			int16 sourceY = _sourceOffsets[index] / _numColumns;
+			left = MIN(left, sourceX);
+			top = MIN(top, sourceY);
+			right = MAX<int16>(right, sourceX + 2);
+			bottom = MAX<int16>(bottom, sourceY + 2);
+		}
+
+		_stripSources[strip] = Common::Rect(left, top, right, bottom);
+	}
+}
+
+void RenderTable::generatePanoramaLookupTable() {
 	float halfWidth = (float)_numColumns / 2.0f;
 	float halfHeight = (float)_numRows / 2.0f;
 
@@ -164,20 +327,16 @@ void RenderTable::generatePanoramaLookupTable() {
 
 		// To get x in cylinder coordinates, we just need to calculate the arc length
 		// We also scale it by _panoramaOptions.linearScale
-		int32 xInCylinderCoords = int32(floor((cylinderRadius * _panoramaOptions.linearScale * alpha) + halfWidth));
+		float xInCylinderCoords = (cylinderRadius * _panoramaOptions.linearScale * alpha) + halfWidth;
 
 		float cosAlpha = cos(alpha);
 
 		for (uint y = 0; y < _numRows; ++y) {
 			// To calculate y in cylinder coordinates, we can do similar triangles comparison,
 			// comparing the triangle from the center to the screen and from the center to the edge of the cylinder
-			int32 yInCylinderCoords = int32(floor(halfHeight + ((float)y - halfHeight) * cosAlpha));
-
-			uint32 index = y * _numColumns + x;
+			float yInCylinderCoords = halfHeight + ((float)y - halfHeight) * cosAlpha;
 
-			// Only store the (x,y) offsets instead of the absolute positions
-			_internalBuffer[index].x = xInCylinderCoords - x;
-			_internalBuffer[index].y = yInCylinderCoords - y;
+			setSourcePixel(x, y, xInCylinderCoords, yInCylinderCoords);
 		}
 	}
 }
@@ -198,21 +357,16 @@ void RenderTable::generateTiltLookupTable() {
 
 		// To get y in cylinder coordinates, we just need to calculate the arc length
 		// We also scale it by _tiltOptions.linearScale
-		int32 yInCylinderCoords = int32(floor((cylinderRadius * _tiltOptions.linearScale * alpha) + halfHeight));
+		float yInCylinderCoords = (cylinderRadius * _tiltOptions.linearScale * alpha) + halfHeight;
 
 		float cosAlpha = cos(alpha);
-		uint32 columnIndex = y * _numColumns;
 
 		for (uint x = 0; x < _numColumns; ++x) {
 			// To calculate x in cylinder coordinates, we can do similar triangles comparison,
 			// comparing the triangle from the center to the screen and from the center to the edge of the cylinder
-			int32 xInCylinderCoords = int32(floor(halfWidth + ((float)x - halfWidth) * cosAlpha));
-
-			uint32 index = columnIndex + x;
+			float xInCylinderCoords = halfWidth + ((float)x - halfWidth) * cosAlpha;
 
-			// Only store the (x,y) offsets instead of the absolute positions
-			_internalBuffer[index].x = xInCylinderCoords - x;
-			_internalBuffer[index].y = yInCylinderCoords - y;
+			setSourcePixel(x, y, xInCylinderCoords, yInCylinderCoords);
 		}
 	}
 }
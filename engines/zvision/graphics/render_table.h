@@ -22,6 +22,7 @@
 #ifndef ZVISION_RENDER_TABLE_H
 #define ZVISION_RENDER_TABLE_H
 
+#include "common/array.h"
 #include "common/rect.h"
 #include "graphics/surface.h"
 
@@ -40,10 +41,43 @@ public:
 	};
 
 private:
+	// The warp is done in strips of rows, so the strips whose source did not change can be skipped
+	static const uint kStripHeight = 16;
+	// Below this average length, copying the spans is slower than looking up every pixel
+	static const uint kMinAverageSpanLength = 4;
+
+	// A run of destination pixels which are copied from consecutive source pixels
+	struct Span {
+		uint16 dstX;
+		uint16 length;
+		uint32 srcOffset;
+	};
+
 	uint _numColumns, _numRows;
 	Common::Point *_internalBuffer;
 	RenderState _renderState;
 
+	// Absolute source pixel of every destination pixel
+	uint32 *_sourceOffsets;
+	// Bilinear filter weights of every destination pixel, in 1/32 steps: (x << 8) | y
+	uint16 *_filterWeights;
+	Common::Array<Span> _spans;
+	// Index of the first span of every row, plus the end of the last row
+	Common::Array<uint32> _rowSpans;
+	bool _useSpans;
+	// The source pixels read by each strip
+	Common::Array<Common::Rect> _stripSources;
+
+	bool _bilinearFilter;
+	bool _fullWarpNeeded;
+
+	// The parameters the current lookup tables were generated with
+	struct {
+		RenderState state;
+		float fieldOfView;
+		float linearScale;
+	} _generated;
+
 	struct {
 		float fieldOfView;
 		float linearScale;
@@ -69,8 +103,18 @@ public:
 
 	void mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 destWidth, const Common::Rect &subRect);
 	void mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf);
+	/**
+	 * Warps only the strips of dstBuf whose source pixels intersect srcDirtyRect,
+	 * or all of them, if the lookup tables changed since the last warp.
+	 *
+	 * @return The part of dstBuf that was updated
+	 */
+	Common::Rect mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf, const Common::Rect &srcDirtyRect);
 	void generateRenderTable();
 
+	void setBilinearFilter(bool enable);
+	bool getBilinearFilter() const { return _bilinearFilter; }
+
 	void setPanoramaFoV(float fov);
 	void setPanoramaScale(float scale);
 	void setPanoramaReverse(bool reverse);
@@ -89,6 +133,10 @@ public:
 private:
 	void generatePanoramaLookupTable();
 	void generateTiltLookupTable();
+	void setSourcePixel(uint x, uint y, float sourceX, float sourceY);
+	void generateWarpData();
+	void warpRows(uint16 *dst, const uint16 *src, uint firstRow, uint lastRow);
+	void warpRowsBilinear(uint16 *dst, const uint16 *src, uint firstRow, uint lastRow);
 };
 
 } // End of namespace ZVision
@@ -0,0 +1,167 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+#include "common/util.h"
+
+#include "graphics/pixelformat.h"
+#include "graphics/yuv_to_rgb.h"
+
+#include <emmintrin.h>
+
+#ifdef __GNUC__
+#pragma GCC push_options
+
+#ifndef __x86_64__
+#pragma GCC target("sse2")
+#endif
+
+#endif
+
+namespace Graphics {
+
+// The clip tables of YUVToRGBLookup are computed arithmetically here, so the
+// output is the same as the one of the table based converters. In ITU scale,
+// (x * 255 / 219) is exactly ((x * 255 * 19153) >> 22) for x in [0, 219].
+
+static inline uint clipChannel(int value, bool itu, byte loss) {
+	if (itu)
+		value = (CLIP(value, 16, 235) - 16) * 255 / 219;
+	else
+		value = CLIP(value, 0, 255);
+
+	return value >> loss;
+}
+
+template<bool itu>
+static inline __m128i clipChannelSSE2(__m128i value, __m128i loss) {
+	if (itu) {
+		value = _mm_min_epi16(_mm_max_epi16(value, _mm_set1_epi16(16)), _mm_set1_epi16(235));
+		value = _mm_mullo_epi16(_mm_sub_epi16(value, _mm_set1_epi16(16)), _mm_set1_epi16(255));
+		value = _mm_srli_epi16(_mm_mulhi_epu16(value, _mm_set1_epi16(19153)), 6);
+	} else {
+		value = _mm_min_epi16(_mm_max_epi16(value, _mm_setzero_si128()), _mm_set1_epi16(255));
+	}
+
+	return _mm_srl_epi16(value, loss);
+}
+
+template<bool halfChroma>
+static inline __m128i loadChromaSSE2(const int16 *src, int x) {
+	if (halfChroma) {
+		// Every chroma sample covers two pixels
+		__m128i chroma = _mm_loadl_epi64((const __m128i *)(src + (x >> 1)));
+		return _mm_unpacklo_epi16(chroma, chroma);
+	}
+
+	return _mm_loadu_si128((const __m128i *)(src + x));
+}
+
+template<typename PixelInt, bool halfChroma, bool itu>
+static void convertRowT(byte *dst, const Graphics::PixelFormat &format, const byte *ySrc, const byte *aSrc, const int16 *crR, const int16 *crbG, const int16 *cbB, int width) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i rLoss = _mm_cvtsi32_si128(format.rLoss);
+	const __m128i gLoss = _mm_cvtsi32_si128(format.gLoss);
+	const __m128i bLoss = _mm_cvtsi32_si128(format.bLoss);
+	const __m128i aLoss = _mm_cvtsi32_si128(format.aLoss);
+	const __m128i rShift = _mm_cvtsi32_si128(format.rShift);
+	const __m128i gShift = _mm_cvtsi32_si128(format.gShift);
+	const __m128i bShift = _mm_cvtsi32_si128(format.bShift);
+	const __m128i aShift = _mm_cvtsi32_si128(format.aShift);
+	const uint32 aMask = (0xFF >> format.aLoss) << format.aShift;
+
+	int x = 0;
+
+	for (; x + 8 <= width; x += 8) {
+		__m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(ySrc + x)), zero);
+		__m128i r = clipChannelSSE2<itu>(_mm_add_epi16(y, loadChromaSSE2<halfChroma>(crR, x)), rLoss);
+		__m128i g = clipChannelSSE2<itu>(_mm_add_epi16(y, loadChromaSSE2<halfChroma>(crbG, x)), gLoss);
+		__m128i b = clipChannelSSE2<itu>(_mm_add_epi16(y, loadChromaSSE2<halfChroma>(cbB, x)), bLoss);
+		__m128i a = zero;
+
+		if (aSrc)
+			a = _mm_srl_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(aSrc + x)), zero), aLoss);
+
+		if (sizeof(PixelInt) == 2) {
+			__m128i pixels = _mm_or_si128(_mm_or_si128(_mm_sll_epi16(r, rShift), _mm_sll_epi16(g, gShift)), _mm_sll_epi16(b, bShift));
+			pixels = _mm_or_si128(pixels, aSrc ? _mm_sll_epi16(a, aShift) : _mm_set1_epi16((int16)aMask));
+			_mm_storeu_si128((__m128i *)(dst + x * 2), pixels);
+		} else {
+			__m128i lo = _mm_or_si128(_mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(r, zero), rShift), _mm_sll_epi32(_mm_unpacklo_epi16(g, zero), gShift)), _mm_sll_epi32(_mm_unpacklo_epi16(b, zero), bShift));
+			__m128i hi = _mm_or_si128(_mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(r, zero), rShift), _mm_sll_epi32(_mm_unpackhi_epi16(g, zero), gShift)), _mm_sll_epi32(_mm_unpackhi_epi16(b, zero), bShift));
+
+			if (aSrc) {
+				lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(a, zero), aShift));
+				hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(a, zero), aShift));
+			} else {
+				lo = _mm_or_si128(lo, _mm_set1_epi32(aMask));
+				hi = _mm_or_si128(hi, _mm_set1_epi32(aMask));
+			}
+
+			_mm_storeu_si128((__m128i *)(dst + x * 4), lo);
+			_mm_storeu_si128((__m128i *)(dst + x * 4 + 16), hi);
+		}
+	}
+
+	for (; x < width; x++) {
+		int c = halfChroma ? (x >> 1) : x;
+		int y = ySrc[x];
+
+		uint32 pixel = (clipChannel(y + crR[c], itu, format.rLoss) << format.rShift) |
+		               (clipChannel(y + crbG[c], itu, format.gLoss) << format.gShift) |
+		               (clipChannel(y + cbB[c], itu, format.bLoss) << format.bShift);
+
+		if (aSrc)
+			pixel |= (aSrc[x] >> format.aLoss) << format.aShift;
+		else
+			pixel |= aMask;
+
+		*((PixelInt *)(dst + x * sizeof(PixelInt))) = pixel;
+	}
+}
+
+template<typename PixelInt>
+static void convertRowFormat(byte *dst, const Graphics::PixelFormat &format, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *aSrc, const int16 *crR, const int16 *crbG, const int16 *cbB, int width, bool halfChroma) {
+	if (scale == YUVToRGBManager::kScaleITU) {
+		if (halfChroma)
+			convertRowT<PixelInt, true, true>(dst, format, ySrc, aSrc, crR, crbG, cbB, width);
+		else
+			convertRowT<PixelInt, false, true>(dst, format, ySrc, aSrc, crR, crbG, cbB, width);
+	} else {
+		if (halfChroma)
+			convertRowT<PixelInt, true, false>(dst, format, ySrc, aSrc, crR, crbG, cbB, width);
+		else
+			convertRowT<PixelInt, false, false>(dst, format, ySrc, aSrc, crR, crbG, cbB, width);
+	}
+}
+
+void YUVToRGBManager::convertRowSSE2(byte *dst, const Graphics::PixelFormat &format, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *aSrc, const int16 *crR, const int16 *crbG, const int16 *cbB, int width, bool halfChroma) {
+	if (format.bytesPerPixel == 2)
+		convertRowFormat<uint16>(dst, format, scale, ySrc, aSrc, crR, crbG, cbB, width, halfChroma);
+	else
+		convertRowFormat<uint32>(dst, format, scale, ySrc, aSrc, crR, crbG, cbB, width, halfChroma);
+}
+
+} // End of namespace Graphics
+
+#ifdef __GNUC__
+#pragma GCC pop_options
+#endif
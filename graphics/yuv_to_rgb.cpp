@@ -82,6 +82,8 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/system.h"
+
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
 
@@ -183,6 +185,8 @@ YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::Lu
 
 YUVToRGBManager::YUVToRGBManager() {
 	_lookup = 0;
+	_rowConverter = nullptr;
+	_rowConverterChecked = false;
 }
 
 YUVToRGBManager::~YUVToRGBManager() {
@@ -198,6 +202,69 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	return _lookup;
 }
 
+void YUVToRGBManager::setSIMDEnabled(bool enable) {
+	Common::StackLock lock(_mutex);
+
+	_rowConverter = nullptr;
+#ifdef SCUMMVM_SSE2
+	if (enable)
+		_rowConverter = convertRowSSE2;
+#endif
+	_rowConverterChecked = true;
+}
+
+YUVToRGBManager::RowConverter YUVToRGBManager::getRowConverter() {
+	if (!_rowConverterChecked) {
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+			_rowConverter = convertRowSSE2;
+#endif
+		_rowConverterChecked = true;
+	}
+
+	return _rowConverter;
+}
+
+void YUVToRGBManager::convertRows(YUVToRGBManager::RowConverter convertRow, Graphics::Surface *dst, const YUVToRGBLookup *lookup, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch, int xShift, int yShift) {
+	int chromaWidth = yWidth >> xShift;
+
+	_chromaRow.resize(chromaWidth * 3);
+	int16 *crR  = _chromaRow.data();
+	int16 *crbG = crR + chromaWidth;
+	int16 *cbB  = crbG + chromaWidth;
+
+	const int16 *Cr_r_tab = lookup->getColorTable();
+	const int16 *Cr_g_tab = Cr_r_tab + 256;
+	const int16 *Cb_g_tab = Cr_g_tab + 256;
+	const int16 *Cb_b_tab = Cb_g_tab + 256;
+
+	// The entries for a zero chroma are the offsets into the clip table,
+	// which the row converters don't use
+	const int16 r_offset = Cr_r_tab[128];
+	const int16 g_offset = Cr_g_tab[128];
+	const int16 b_offset = Cb_b_tab[128];
+
+	for (int h = 0; h < yHeight; h++) {
+		// Chroma rows are shared by 1 << yShift luma rows
+		if ((h & ((1 << yShift) - 1)) == 0) {
+			const byte *uRow = uSrc + (h >> yShift) * uvPitch;
+			const byte *vRow = vSrc + (h >> yShift) * uvPitch;
+
+			for (int w = 0; w < chromaWidth; w++) {
+				crR[w]  = Cr_r_tab[vRow[w]] - r_offset;
+				crbG[w] = Cr_g_tab[vRow[w]] - g_offset + Cb_g_tab[uRow[w]];
+				cbB[w]  = Cb_b_tab[uRow[w]] - b_offset;
+			}
+		}
+
+		byte *dstRow = (byte *)dst->getBasePtr(0, h);
+		const byte *yRow = ySrc + h * yPitch;
+		const byte *aRow = aSrc ? aSrc + h * yPitch : nullptr;
+
+		convertRow(dstRow, dst->format, scale, yRow, aRow, crR, crbG, cbB, yWidth, xShift != 0);
+	}
+}
+
 #define PUT_PIXEL(s, d) \
 	L = &clipTable[(s)]; \
 	*((PixelInt *)(d)) = ((L[cr_r] << r_shift) | (L[crb_g] << g_shift) | (L[cb_b] << b_shift) | a_mask)
@@ -244,8 +311,15 @@ void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
 	assert(ySrc && uSrc && vSrc);
 
+	Common::StackLock lock(_mutex);
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	RowConverter convertRow = getRowConverter();
+	if (convertRow) {
+		convertRows(convertRow, dst, lookup, scale, ySrc, uSrc, vSrc, nullptr, yWidth, yHeight, yPitch, uvPitch, 0, 0);
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
@@ -301,8 +375,15 @@ void YUVToRGBManager::convert422(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert(ySrc && uSrc && vSrc);
 	assert((yWidth & 1) == 0);
 
+	Common::StackLock lock(_mutex);
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	RowConverter convertRow = getRowConverter();
+	if (convertRow) {
+		convertRows(convertRow, dst, lookup, scale, ySrc, uSrc, vSrc, nullptr, yWidth, yHeight, yPitch, uvPitch, 1, 0);
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV422ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
@@ -362,8 +443,15 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert((yWidth & 1) == 0);
 	assert((yHeight & 1) == 0);
 
+	Common::StackLock lock(_mutex);
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	RowConverter convertRow = getRowConverter();
+	if (convertRow) {
+		convertRows(convertRow, dst, lookup, scale, ySrc, uSrc, vSrc, nullptr, yWidth, yHeight, yPitch, uvPitch, 1, 1);
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
@@ -431,8 +519,15 @@ void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::L
 	assert((yWidth & 1) == 0);
 	assert((yHeight & 1) == 0);
 
+	Common::StackLock lock(_mutex);
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	RowConverter convertRow = getRowConverter();
+	if (convertRow) {
+		convertRows(convertRow, dst, lookup, scale, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch, 1, 1);
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUVA420ToRGBA<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
@@ -513,6 +608,47 @@ void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 #undef DO_INTERPOLATION
 #undef DO_YUV410_PIXEL
 
+void YUVToRGBManager::convertRows410(YUVToRGBManager::RowConverter convertRow, Graphics::Surface *dst, const YUVToRGBLookup *lookup, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	_chromaRow.resize(yWidth * 3);
+	int16 *crR  = _chromaRow.data();
+	int16 *crbG = crR + yWidth;
+	int16 *cbB  = crbG + yWidth;
+
+	const int16 *Cr_r_tab = lookup->getColorTable();
+	const int16 *Cr_g_tab = Cr_r_tab + 256;
+	const int16 *Cb_g_tab = Cr_g_tab + 256;
+	const int16 *Cb_b_tab = Cb_g_tab + 256;
+
+	const int16 r_offset = Cr_r_tab[128];
+	const int16 g_offset = Cr_g_tab[128];
+	const int16 b_offset = Cb_b_tab[128];
+
+	for (int y = 0; y < yHeight; y++) {
+		int yDiff = y & 3;
+		const byte *uRow = uSrc + (y >> 2) * uvPitch;
+		const byte *vRow = vSrc + (y >> 2) * uvPitch;
+
+		// Same bilinear interpolation as convertYUV410ToRGB()
+		for (int x = 0; x < yWidth; x++) {
+			int index = x >> 2;
+			int xDiff = x & 3;
+			int wA = (4 - xDiff) * (4 - yDiff);
+			int wB = xDiff * (4 - yDiff);
+			int wC = yDiff * (4 - xDiff);
+			int wD = xDiff * yDiff;
+
+			byte u = (uRow[index] * wA + uRow[index + 1] * wB + uRow[index + uvPitch] * wC + uRow[index + uvPitch + 1] * wD) >> 4;
+			byte v = (vRow[index] * wA + vRow[index + 1] * wB + vRow[index + uvPitch] * wC + vRow[index + uvPitch + 1] * wD) >> 4;
+
+			crR[x]  = Cr_r_tab[v] - r_offset;
+			crbG[x] = Cr_g_tab[v] - g_offset + Cb_g_tab[u];
+			cbB[x]  = Cb_b_tab[u] - b_offset;
+		}
+
+		convertRow((byte *)dst->getBasePtr(0, y), dst->format, scale, ySrc + y * yPitch, nullptr, crR, crbG, cbB, yWidth, false);
+	}
+}
+
 void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
@@ -521,8 +657,15 @@ void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert((yWidth & 3) == 0);
 	assert((yHeight & 3) == 0);
 
+	Common::StackLock lock(_mutex);
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	RowConverter convertRow = getRowConverter();
+	if (convertRow) {
+		convertRows410(convertRow, dst, lookup, scale, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV410ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
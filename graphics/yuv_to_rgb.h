@@ -38,6 +38,8 @@
 #define GRAPHICS_YUV_TO_RGB_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
+#include "common/mutex.h"
 #include "common/singleton.h"
 #include "graphics/surface.h"
 
@@ -135,6 +137,15 @@ public:
 	 */
 	void convert410(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
 
+	/**
+	 * Enable or disable the vectorized converters. By default, they are
+	 * used when the CPU supports them. Disabling them is only useful for
+	 * testing and benchmarking.
+	 *
+	 * @param enable  whether the vectorized converters should be used
+	 */
+	void setSIMDEnabled(bool enable);
+
 private:
 	friend class Common::Singleton<SingletonBaseType>;
 	YUVToRGBManager();
@@ -142,7 +153,36 @@ private:
 
 	const YUVToRGBLookup *getLookup(Graphics::PixelFormat format, LuminanceScale scale);
 
+	/**
+	 * A vectorized converter for a single row. crR, crbG and cbB hold the
+	 * chroma contributions to the red, green and blue channels of each chroma
+	 * sample of the row, without the clip table offsets. aSrc may be null for
+	 * images without alpha.
+	 */
+	typedef void (*RowConverter)(byte *dst, const Graphics::PixelFormat &format, LuminanceScale scale, const byte *ySrc, const byte *aSrc, const int16 *crR, const int16 *crbG, const int16 *cbB, int width, bool halfChroma);
+
+#ifdef SCUMMVM_SSE2
+	static void convertRowSSE2(byte *dst, const Graphics::PixelFormat &format, LuminanceScale scale, const byte *ySrc, const byte *aSrc, const int16 *crR, const int16 *crbG, const int16 *cbB, int width, bool halfChroma);
+#endif
+
+	/** Return the row converter supported by the CPU, or null if there is none. */
+	RowConverter getRowConverter();
+
+	/**
+	 * Convert an image row by row with a vectorized row converter.
+	 * The chroma planes are subsampled by 1 << xShift horizontally and
+	 * 1 << yShift vertically, with xShift being 0 or 1.
+	 */
+	void convertRows(RowConverter convertRow, Graphics::Surface *dst, const YUVToRGBLookup *lookup, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch, int xShift, int yShift);
+
+	/** Convert a YUV410 image row by row, interpolating the chroma like convert410(). */
+	void convertRows410(RowConverter convertRow, Graphics::Surface *dst, const YUVToRGBLookup *lookup, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
+
 	YUVToRGBLookup *_lookup;
+	RowConverter _rowConverter;
+	bool _rowConverterChecked;
+	Common::Array<int16> _chromaRow; ///< Chroma contributions of the current row, for the row converters
+	Common::Mutex _mutex; ///< Guards the lookup, for videos decoded on the timer thread
 };
  /** @} */
 } // End of namespace Graphics
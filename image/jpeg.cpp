@@ -47,7 +47,8 @@ namespace Image {
 JPEGDecoder::JPEGDecoder() :
 		_surface(),
 		_colorSpace(kColorSpaceRGB),
-		_requestedPixelFormat(getByteOrderRgbPixelFormat()) {
+		_requestedPixelFormat(getByteOrderRgbPixelFormat()),
+		_scaleDenominator(1) {
 }
 
 JPEGDecoder::~JPEGDecoder() {
@@ -227,14 +228,10 @@ J_COLOR_SPACE fromScummvmPixelFormat(const Graphics::PixelFormat &format) {
 } // End of anonymous namespace
 #endif
 
-bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 #ifdef USE_JPEG
-	// Reset member variables from previous decodings
-	destroy();
-
-	jpeg_decompress_struct cinfo;
-	jpeg_error_mgr jerr;
+namespace {
 
+void createDecompress(jpeg_decompress_struct &cinfo, jpeg_error_mgr &jerr) {
 	// Initialize error handling callbacks
 	cinfo.err = jpeg_std_error(&jerr);
 	cinfo.err->error_exit = &errorExit;
@@ -242,7 +239,11 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 
 	// Initialize the decompression structure
 	jpeg_create_decompress(&cinfo);
+}
 
+} // End of anonymous namespace
+
+void JPEGDecoder::decodeImage(jpeg_decompress_struct &cinfo, Common::SeekableReadStream &stream, Graphics::Surface &surface) const {
 	// Initialize our buffer handling
 	jpeg_scummvm_src(&cinfo, &stream);
 
@@ -279,6 +280,10 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 		cinfo.out_color_space = JCS_CMYK;
 	}
 
+	// The reduced size IDCT is selected when the output is smaller
+	cinfo.scale_num = 1;
+	cinfo.scale_denom = _scaleDenominator;
+
 	// Actually start decompressing the image
 	jpeg_start_decompress(&cinfo);
 
@@ -291,48 +296,91 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 		} else {
 			outputPixelFormat = _requestedPixelFormat;
 		}
-		_surface.create(cinfo.output_width, cinfo.output_height, outputPixelFormat);
+		surface.create(cinfo.output_width, cinfo.output_height, outputPixelFormat);
 		break;
 	}
 	case kColorSpaceYUV:
 		// We use YUV with 3 bytes per pixel otherwise.
 		// This is pretty ugly since our PixelFormat cannot express YUV...
-		_surface.create(cinfo.output_width, cinfo.output_height, Graphics::PixelFormat(3, 0, 0, 0, 0, 0, 0, 0, 0));
+		surface.create(cinfo.output_width, cinfo.output_height, Graphics::PixelFormat(3, 0, 0, 0, 0, 0, 0, 0, 0));
 		break;
 	default:
 		break;
 	}
 	// Size of output pixel must match 4 bytes.
 	if (cinfo.out_color_space == JCS_CMYK) {
-		assert(_surface.format.bytesPerPixel == 4);
+		assert(surface.format.bytesPerPixel == 4);
 	}
+	assert(surface.format.bytesPerPixel == cinfo.output_components);
 
-	// Allocate buffer for one scanline
-	JDIMENSION pitch = cinfo.output_width * _surface.format.bytesPerPixel;
-	assert(_surface.pitch >= (int)pitch);
-	JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, pitch, 1);
+	// Decode the scanlines straight into the surface, as many as libjpeg
+	// can output at once
+	const int maxRows = 16;
+	JSAMPROW rows[maxRows];
 
-	// Go through the image data scanline by scanline
 	while (cinfo.output_scanline < cinfo.output_height) {
-		byte *dst = (byte *)_surface.getBasePtr(0, cinfo.output_scanline);
-
-		jpeg_read_scanlines(&cinfo, buffer, 1);
+		int rowCount = MIN<int>(cinfo.output_height - cinfo.output_scanline, maxRows);
+		for (int i = 0; i < rowCount; i++) {
+			rows[i] = (JSAMPROW)surface.getBasePtr(0, cinfo.output_scanline + i);
+		}
 
-		memcpy(dst, buffer[0], pitch);
+		jpeg_read_scanlines(&cinfo, rows, rowCount);
 	}
 
-	// We are done with decompressing, thus free all the data
+	// We are done with decompressing this image, this only frees its data
 	jpeg_finish_decompress(&cinfo);
+
+	if (_colorSpace == kColorSpaceRGB && surface.format != _requestedPixelFormat) {
+		surface.convertToInPlace(_requestedPixelFormat); // Slow path
+	}
+}
+#endif
+
+bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
+#ifdef USE_JPEG
+	// Reset member variables from previous decodings
+	destroy();
+
+	jpeg_decompress_struct cinfo;
+	jpeg_error_mgr jerr;
+
+	createDecompress(cinfo, jerr);
+	decodeImage(cinfo, stream, _surface);
 	jpeg_destroy_decompress(&cinfo);
 
-	if (_colorSpace == kColorSpaceRGB && _surface.format != _requestedPixelFormat) {
-		_surface.convertToInPlace(_requestedPixelFormat); // Slow path
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool JPEGDecoder::loadStreams(const Common::Array<Common::SeekableReadStream *> &streams, Common::Array<Graphics::Surface *> &surfaces) {
+#ifdef USE_JPEG
+	jpeg_decompress_struct cinfo;
+	jpeg_error_mgr jerr;
+
+	// The source manager and the permanent allocations are kept between
+	// the images, only their own data is freed after each of them
+	createDecompress(cinfo, jerr);
+
+	surfaces.reserve(surfaces.size() + streams.size());
+	for (uint i = 0; i < streams.size(); i++) {
+		Graphics::Surface *surface = new Graphics::Surface();
+		decodeImage(cinfo, *streams[i], *surface);
+		surfaces.push_back(surface);
 	}
 
+	jpeg_destroy_decompress(&cinfo);
+
 	return true;
 #else
 	return false;
 #endif
 }
 
+void JPEGDecoder::setScaleDenominator(uint denominator) {
+	assert(denominator == 1 || denominator == 2 || denominator == 4 || denominator == 8);
+	_scaleDenominator = denominator;
+}
+
 } // End of Graphics namespace
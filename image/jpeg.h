@@ -22,10 +22,13 @@
 #ifndef IMAGE_JPEG_H
 #define IMAGE_JPEG_H
 
+#include "common/array.h"
 #include "graphics/surface.h"
 #include "image/image_decoder.h"
 #include "image/codecs/codec.h"
 
+struct jpeg_decompress_struct;
+
 namespace Common {
 class SeekableReadStream;
 }
@@ -96,12 +99,37 @@ public:
 	 */
 	void setOutputColorSpace(ColorSpace outSpace) { _colorSpace = outSpace; }
 
+	/**
+	 * Request the image to be scaled down while it is decoded. Only the
+	 * DCT coefficients needed for the output size are used, which is much
+	 * faster than decoding the whole image and scaling it afterwards.
+	 *
+	 * The decoder itself defaults to the full size.
+	 *
+	 * @param denominator The output size is the image size divided by
+	 *                    this value. Must be 1, 2, 4 or 8.
+	 */
+	void setScaleDenominator(uint denominator);
+
+	/**
+	 * Decode several images in a row with the current settings. The
+	 * decompressor is set up once and reused for all of them.
+	 *
+	 * @param streams  The streams to decode.
+	 * @param surfaces Receives one surface per stream, in the same order.
+	 *                 The caller must free and delete them.
+	 * @return Whether the images were decoded.
+	 */
+	bool loadStreams(const Common::Array<Common::SeekableReadStream *> &streams, Common::Array<Graphics::Surface *> &surfaces);
+
 private:
 	Graphics::Surface _surface;
 	ColorSpace _colorSpace;
 	Graphics::PixelFormat _requestedPixelFormat;
+	uint _scaleDenominator;
 
 	Graphics::PixelFormat getByteOrderRgbPixelFormat() const;
+	void decodeImage(jpeg_decompress_struct &cinfo, Common::SeekableReadStream &stream, Graphics::Surface &surface) const;
 };
 /** @} */
 } // End of namespace Image
@@ -30,6 +30,7 @@
 
 #include "image/png.h"
 
+#include "graphics/blit.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
@@ -72,6 +73,14 @@ Graphics::PixelFormat PNGDecoder::getByteOrderRgbaPixelFormat(bool isAlpha) cons
 #endif
 }
 
+Graphics::PixelFormat PNGDecoder::getByteOrderBgraPixelFormat() const {
+#ifdef SCUMM_BIG_ENDIAN
+	return Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0);
+#else
+	return Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24);
+#endif
+}
+
 #ifdef USE_PNG
 // libpng-error-handling:
 void pngError(png_structp pngptr, png_const_charp errorMsg) {
@@ -115,6 +124,45 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 #ifdef USE_PNG
 	destroy();
 
+	// Allocate memory for the final image data.
+	// To keep memory framentation low this happens before allocating memory for temporary image data.
+	_outputSurface = new Graphics::Surface();
+
+	return decodeImage(stream, *_outputSurface, nullptr);
+#else
+	return false;
+#endif
+}
+
+bool PNGDecoder::loadStreamInto(Common::SeekableReadStream &stream, Graphics::Surface &surface, const Graphics::PixelFormat &format) {
+#ifdef USE_PNG
+	destroy();
+
+	return decodeImage(stream, surface, &format);
+#else
+	return false;
+#endif
+}
+
+bool PNGDecoder::loadStreams(const Common::Array<Common::SeekableReadStream *> &streams, Common::Array<Graphics::Surface *> &surfaces, const Graphics::PixelFormat &format) {
+	// The palettes of the images would be lost
+	assert(format.bytesPerPixel != 1);
+
+	bool success = true;
+
+	surfaces.reserve(surfaces.size() + streams.size());
+	for (uint i = 0; i < streams.size(); i++) {
+		Graphics::Surface *surface = new Graphics::Surface();
+		if (!loadStreamInto(*streams[i], *surface, format))
+			success = false;
+		surfaces.push_back(surface);
+	}
+
+	return success;
+}
+
+#ifdef USE_PNG
+bool PNGDecoder::decodeImage(Common::SeekableReadStream &stream, Graphics::Surface &surface, const Graphics::PixelFormat *format) {
 	// First, check the PNG signature (if not set to skip it)
 	if (!_skipSignature) {
 		if (stream.readUint32BE() != MKTAG(0x89, 'P', 'N', 'G')) {
@@ -153,17 +201,15 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	// No handling for unknown chunks yet.
 	int bitDepth, colorType, width, height, interlaceType;
 	png_uint_32 w, h;
-	uint32 rgbaPalette[256];
-	bool hasRgbaPalette = false;
+	uint32 paletteMap[256];
+	bool expandPalette = false;
+	bool convertRows = false;
+	Graphics::PixelFormat decodedFormat;
 
 	png_get_IHDR(pngPtr, infoPtr, &w, &h, &bitDepth, &colorType, &interlaceType, NULL, NULL);
 	width = w;
 	height = h;
 
-	// Allocate memory for the final image data.
-	// To keep memory framentation low this happens before allocating memory for temporary image data.
-	_outputSurface = new Graphics::Surface();
-
 	// Images of all color formats except PNG_COLOR_TYPE_PALETTE
 	// will be transformed into ARGB images
 	if (colorType == PNG_COLOR_TYPE_PALETTE && (_keepTransparencyPaletted || !png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS))) {
@@ -171,6 +217,7 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 		png_colorp palette = NULL;
 		png_bytep trans = nullptr;
 		int numTrans = 0;
+		bool hasRgbaPalette = false;
 
 		uint32 success = png_get_PLTE(pngPtr, infoPtr, &palette, &numPalette);
 		if (success != PNG_INFO_PLTE) {
@@ -202,23 +249,26 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			}
 		}
 
-		_outputSurface->create(width, height,
-			hasRgbaPalette ? getByteOrderRgbaPixelFormat(true) : Graphics::PixelFormat::createFormatCLUT8());
+		decodedFormat = Graphics::PixelFormat::createFormatCLUT8();
+		surface.create(width, height,
+			format ? *format : (hasRgbaPalette ? getByteOrderRgbaPixelFormat(true) : decodedFormat));
 		png_set_packing(pngPtr);
 
-		if (hasRgbaPalette) {
-			// Build up the RGBA palette using the transparency alphas
-			Common::fill(&rgbaPalette[0], &rgbaPalette[256], 0);
+		if (surface.format.bytesPerPixel != 1) {
+			// Build up the palette in the output format, using the transparency alphas
+			Common::fill(&paletteMap[0], &paletteMap[256], 0);
 			for (int i = 0; i < _paletteColorCount; ++i) {
 				byte a = (i < numTrans) ? trans[i] : 0xff;
-				rgbaPalette[i] = _outputSurface->format.ARGBToColor(
+				paletteMap[i] = surface.format.ARGBToColor(
 					a, palette[i].red, palette[i].green, palette[i].blue);
 			}
+			expandPalette = true;
 
 			// We won't be needing a separate palette
 			_paletteColorCount = 0;
 			delete[] _palette;
 			_palette = nullptr;
+			_hasTransparentColor = false;
 		}
 	} else {
  		bool isAlpha = (colorType & PNG_COLOR_MASK_ALPHA);
@@ -227,8 +277,15 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			png_set_expand(pngPtr);
 		}
 
-		_outputSurface->create(width, height, getByteOrderRgbaPixelFormat(isAlpha));
-		if (!_outputSurface->getPixels()) {
+		decodedFormat = getByteOrderRgbaPixelFormat(isAlpha);
+		if (format && format->bytesPerPixel == 1) {
+			// True color images cannot be output paletted
+			png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
+			return false;
+		}
+
+		surface.create(width, height, format ? *format : decodedFormat);
+		if (!surface.getPixels()) {
 			error("Could not allocate memory for output image.");
 		}
 		if (bitDepth == 16)
@@ -241,34 +298,54 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 
 		if (colorType != PNG_COLOR_TYPE_RGB_ALPHA)
 			png_set_filler(pngPtr, 0xff, PNG_FILLER_AFTER);
+
+		// libpng can output the two byte orders of RGBA directly. The filler
+		// makes images without alpha fully opaque.
+		if (surface.format == getByteOrderBgraPixelFormat()) {
+			png_set_bgr(pngPtr);
+		} else if (surface.format != decodedFormat && surface.format != getByteOrderRgbaPixelFormat(true)) {
+			convertRows = true;
+		}
 	}
 
 	// After the transformations have been registered, the image data is read again.
-	png_set_interlace_handling(pngPtr);
+	int passes = png_set_interlace_handling(pngPtr);
 	png_read_update_info(pngPtr, infoPtr);
 	png_get_IHDR(pngPtr, infoPtr, &w, &h, &bitDepth, &colorType, NULL, NULL, NULL);
 	width = w;
 	height = h;
 
-	if (hasRgbaPalette) {
-		// Build up the RGBA surface from paletted rows
-		png_bytep rowPtr = new byte[width];
-		if (!rowPtr)
-			error("Could not allocate memory for row.");
+	if (expandPalette || convertRows) {
+		// Convert the rows to the output format as they are decoded.
+		// Interlaced images need all the rows until the last pass.
+		uint rowBytes = png_get_rowbytes(pngPtr, infoPtr);
+		int bufferRows = (passes > 1) ? height : 1;
+		byte *buffer = new byte[rowBytes * bufferRows];
+
+		if (passes > 1) {
+			png_bytep *rowPtr = new png_bytep[height];
+			for (int i = 0; i < height; i++)
+				rowPtr[i] = buffer + i * rowBytes;
+			png_read_image(pngPtr, rowPtr);
+			delete[] rowPtr;
+		}
 
-		for (int yp = 0; yp < height; ++yp) {
-			png_read_row(pngPtr, rowPtr, nullptr);
-			uint32 *destRowP = (uint32 *)_outputSurface->getBasePtr(0, yp);
+		for (int yp = 0; yp < height; yp += bufferRows) {
+			if (passes == 1)
+				png_read_row(pngPtr, buffer, nullptr);
 
-			for (int xp = 0; xp < width; ++xp)
-				destRowP[xp] = rgbaPalette[rowPtr[xp]];
+			byte *dst = (byte *)surface.getBasePtr(0, yp);
+			if (expandPalette)
+				Graphics::crossBlitMap(dst, buffer, surface.pitch, rowBytes, width, bufferRows, surface.format.bytesPerPixel, paletteMap);
+			else
+				Graphics::crossBlit(dst, buffer, surface.pitch, rowBytes, width, bufferRows, surface.format, decodedFormat);
 		}
 
-		delete[] rowPtr;
+		delete[] buffer;
 	} else  if (interlaceType == PNG_INTERLACE_NONE) {
 		// PNGs without interlacing can simply be read row by row.
 		for (int i = 0; i < height; i++) {
-			png_read_row(pngPtr, (png_bytep)_outputSurface->getBasePtr(0, i), NULL);
+			png_read_row(pngPtr, (png_bytep)surface.getBasePtr(0, i), NULL);
 		}
 	} else {
 		// PNGs with interlacing require us to allocate an auxiliary
@@ -282,7 +359,7 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 
 		// Initialize row pointers
 		for (int i = 0; i < height; i++)
-			rowPtr[i] = (png_bytep)_outputSurface->getBasePtr(0, i);
+			rowPtr[i] = (png_bytep)surface.getBasePtr(0, i);
 
 		// Read image data
 		png_read_image(pngPtr, rowPtr);
@@ -298,10 +375,8 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
 
 	return true;
-#else
-	return false;
-#endif
 }
+#endif
 
 bool writePNG(Common::WriteStream &out, const Graphics::Surface &input, const byte *palette) {
 #ifdef USE_PNG
@@ -22,6 +22,7 @@
 #ifndef IMAGE_PNG_H
 #define IMAGE_PNG_H
 
+#include "common/array.h"
 #include "common/scummsys.h"
 #include "common/textconsole.h"
 #include "graphics/pixelformat.h"
@@ -67,8 +68,37 @@ public:
 	uint32 getTransparentColor() const override { return _transparentColor; }
 	void setSkipSignature(bool skip) { _skipSignature = skip; }
 	void setKeepTransparencyPaletted(bool keep) { _keepTransparencyPaletted = keep; }
+
+	/**
+	 * Decode the image into a surface owned by the caller, in the given
+	 * pixel format. The rows are converted as they are decoded, so no
+	 * other full size buffer is needed, except for interlaced images.
+	 *
+	 * Paletted images are expanded using their palette, unless the format
+	 * is CLUT8. In that case, the palette is available from getPalette().
+	 *
+	 * @param stream  The stream to decode.
+	 * @param surface The surface to create and to fill.
+	 * @param format  The pixel format of the surface.
+	 * @return Whether the image was decoded.
+	 */
+	bool loadStreamInto(Common::SeekableReadStream &stream, Graphics::Surface &surface, const Graphics::PixelFormat &format);
+
+	/**
+	 * Decode several images in a row with loadStreamInto().
+	 *
+	 * @param streams  The streams to decode.
+	 * @param surfaces Receives one surface per stream, in the same order.
+	 *                 The caller must free and delete them.
+	 * @param format   The pixel format of the surfaces, which cannot be CLUT8.
+	 * @return Whether all the images were decoded.
+	 */
+	bool loadStreams(const Common::Array<Common::SeekableReadStream *> &streams, Common::Array<Graphics::Surface *> &surfaces, const Graphics::PixelFormat &format);
+
 private:
 	Graphics::PixelFormat getByteOrderRgbaPixelFormat(bool isAlpha) const;
+	Graphics::PixelFormat getByteOrderBgraPixelFormat() const;
+	bool decodeImage(Common::SeekableReadStream &stream, Graphics::Surface &surface, const Graphics::PixelFormat *format);
 
 	byte *_palette;
 	uint16 _paletteColorCount;
@@ -0,0 +1,133 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "engines/scumm/imuse_digi/dimuse_engine.h"
+#include "engines/scumm/imuse_digi/dimuse_internalmixer.h"
+
+#include "../../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+/**
+ * Checks that the vectorized paths of the digital iMUSE internal mixer
+ * produce exactly the same samples as the original lookup table code.
+ */
+class IMuseDigiInternalMixerTestSuite : public CxxTest::TestSuite {
+	static const int kFrames = 1027; // Not a multiple of the vector width
+	static const int kMixBufSize = kFrames * 2 * 2;
+
+	byte _src8[kFrames * 2];
+	uint16 _src16[kFrames * 2];
+
+	void fillSources() {
+		uint32 seed = 0x1234567;
+		for (int i = 0; i < kFrames * 2; i++) {
+			seed = seed * 1103515245 + 12345;
+			_src16[i] = (uint16)(seed >> 12);
+			_src8[i] = (byte)(seed >> 20);
+		}
+		// Make sure the extremes are covered as well
+		_src16[0] = 0x8000;
+		_src16[1] = 0x7FFF;
+		_src8[0] = 0;
+		_src8[1] = 255;
+	}
+
+	// Mixes every supported format at every volume and a few pans, and returns
+	// a checksum of the resulting mix buffers
+	uint32 mixAll(bool simd, byte *outMono, byte *outStereo) {
+		uint32 checksum = 0;
+		for (int outChannels = 1; outChannels <= 2; outChannels++) {
+			byte *mixBuf = outChannels == 1 ? outMono : outStereo;
+			memset(mixBuf, 0, kMixBufSize);
+
+			Scumm::IMuseDigiInternalMixer mixer(nullptr, 22050, false, true);
+			mixer.init(16, outChannels, mixBuf, kMixBufSize, 0, DIMUSE_MAX_TRACKS);
+			mixer.setSIMDEnabled(simd);
+
+			for (int volume = 0; volume <= 127; volume += 3) {
+				for (int pan = 0; pan <= 127; pan += 21) {
+					for (int channels = 1; channels <= 2; channels++) {
+						mixer.mix(_src8, kFrames, 8, channels, kFrames, 0, volume, pan, false);
+						mixer.mix((uint8 *)_src16, kFrames, 16, channels, kFrames, 0, volume, pan, false);
+					}
+				}
+			}
+
+			for (int i = 0; i < kFrames * outChannels; i++)
+				checksum = checksum * 31 + ((uint16 *)mixBuf)[i];
+		}
+		return checksum;
+	}
+
+public:
+	void test_mix_golden() {
+		static byte scalarMono[kMixBufSize], scalarStereo[kMixBufSize];
+		static byte simdMono[kMixBufSize], simdStereo[kMixBufSize];
+
+		Common::install_null_g_system();
+		fillSources();
+
+		// Reference result of the original scalar code
+		TS_ASSERT_EQUALS(mixAll(false, scalarMono, scalarStereo), 1195025316u);
+
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2) {
+			mixAll(true, simdMono, simdStereo);
+			TS_ASSERT_SAME_DATA(scalarMono, simdMono, kFrames * 2);
+			TS_ASSERT_SAME_DATA(scalarStereo, simdStereo, kFrames * 4);
+		}
+#endif
+	}
+
+	void test_mix_speed() {
+#if BENCHMARK_TIME
+		static byte mixBuf[kMixBufSize];
+		const int kTracks = 16;
+#ifdef SLOW_TESTS
+		const int iters = 2000;
+#else
+		const int iters = 20;
+#endif
+
+		Common::install_null_g_system();
+		fillSources();
+
+		Scumm::IMuseDigiInternalMixer mixer(nullptr, 22050, false, true);
+		mixer.init(16, 2, mixBuf, kMixBufSize, 0, DIMUSE_MAX_TRACKS);
+
+		for (int simd = 0; simd <= 1; simd++) {
+#ifdef SCUMMVM_SSE2
+			if (simd && instrset_detect() < 2)
+				break;
+#else
+			if (simd)
+				break;
+#endif
+			mixer.setSIMDEnabled(simd);
+
+			// A typical scene: a stereo music track plus mono voices and effects
+			uint32 start = g_system->getMillis();
+			for (int i = 0; i < iters; i++) {
+				mixer.clearMixerBuffer();
+				for (int track = 0; track < kTracks; track++) {
+					if (track == 0)
+						mixer.mix((uint8 *)_src16, kFrames, 16, 2, kFrames, 0, 127, 64, false);
+					else if (track & 1)
+						mixer.mix((uint8 *)_src16, kFrames, 16, 1, kFrames, 0, 8 * track, 8 * track, false);
+					else
+						mixer.mix(_src8, kFrames, 8, 1, kFrames, 0, 8 * track, 127 - 8 * track, false);
+				}
+			}
+			debug("iMUSE internal mixer (%s): %d iterations of %d tracks in %d ms", simd ? "SIMD" : "scalar", iters, kTracks, g_system->getMillis() - start);
+		}
+#endif
+	}
+};
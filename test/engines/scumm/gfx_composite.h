@@ -0,0 +1,77 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "engines/scumm/gfx.h"
+
+/**
+ * Checks that the vectorized text compositing produces exactly the same
+ * pixels as the scalar code used by ScummEngine::drawStripToScreen().
+ */
+class ScummGfxCompositeTestSuite : public CxxTest::TestSuite {
+	static const int kWidth = 44; // Not a multiple of the vector width
+	static const int kHeight = 8;
+	static const int kSrcPitch = 64;
+	static const int kTextPitch = 80;
+
+	byte _src[kSrcPitch * 2 * kHeight];
+	byte _text[kTextPitch * kHeight];
+	uint16 _palette[256];
+
+	void fillSources() {
+		uint32 seed = 0x1234567;
+		for (int i = 0; i < ARRAYSIZE(_src); i++) {
+			seed = seed * 1103515245 + 12345;
+			_src[i] = (byte)(seed >> 16);
+		}
+
+		for (int i = 0; i < ARRAYSIZE(_palette); i++) {
+			seed = seed * 1103515245 + 12345;
+			_palette[i] = (uint16)(seed >> 12);
+		}
+
+		// Mostly transparent text with a few glyphs, plus some fully
+		// transparent and fully opaque runs of a vector width
+		for (int y = 0; y < kHeight; y++) {
+			for (int x = 0; x < kTextPitch; x++) {
+				seed = seed * 1103515245 + 12345;
+				byte value = (seed >> 24) & 3 ? CHARSET_MASK_TRANSPARENCY : (byte)(seed >> 8);
+				if (x >= 16 && x < 24)
+					value = CHARSET_MASK_TRANSPARENCY;
+				else if (x >= 24 && x < 32)
+					value = (byte)(x + y);
+				_text[y * kTextPitch + x] = value;
+			}
+		}
+	}
+
+public:
+	void test_composite_text_strip() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() < 2)
+			return;
+
+		byte scalar[kWidth * kHeight];
+		byte simd[kWidth * kHeight];
+
+		fillSources();
+		Scumm::compositeTextStrip(scalar, _src, kSrcPitch, _text, kTextPitch, kWidth, kHeight);
+		Scumm::compositeTextStripSSE2(simd, _src, kSrcPitch, _text, kTextPitch, kWidth, kHeight);
+		TS_ASSERT_SAME_DATA(scalar, simd, sizeof(scalar));
+#endif
+	}
+
+	void test_composite_text_strip16() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() < 2)
+			return;
+
+		byte scalar[kWidth * 2 * kHeight];
+		byte simd[kWidth * 2 * kHeight];
+
+		fillSources();
+		Scumm::compositeTextStrip16(scalar, _src, kSrcPitch * 2, 2, _text, kTextPitch, kWidth, kHeight, _palette, false);
+		Scumm::compositeTextStrip16SSE2(simd, _src, kSrcPitch * 2, _text, kTextPitch, kWidth, kHeight, _palette, false);
+		TS_ASSERT_SAME_DATA(scalar, simd, sizeof(scalar));
+#endif
+	}
+};
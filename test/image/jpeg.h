@@ -0,0 +1,196 @@
+#include <cxxtest/TestSuite.h>
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/memstream.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "graphics/surface.h"
+#include "image/jpeg.h"
+
+#include "../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+// A 64x64 color gradient, encoded with 4:2:0 chroma subsampling
+static const byte jpegGradient[534] = {
+	0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 0x4a, 0x46, 0x49, 0x46, 0x00, 0x01,
+	0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xff, 0xdb, 0x00, 0x43,
+	0x00, 0x08, 0x06, 0x06, 0x07, 0x06, 0x05, 0x08, 0x07, 0x07, 0x07, 0x09,
+	0x09, 0x08, 0x0a, 0x0c, 0x14, 0x0d, 0x0c, 0x0b, 0x0b, 0x0c, 0x19, 0x12,
+	0x13, 0x0f, 0x14, 0x1d, 0x1a, 0x1f, 0x1e, 0x1d, 0x1a, 0x1c, 0x1c, 0x20,
+	0x24, 0x2e, 0x27, 0x20, 0x22, 0x2c, 0x23, 0x1c, 0x1c, 0x28, 0x37, 0x29,
+	0x2c, 0x30, 0x31, 0x34, 0x34, 0x34, 0x1f, 0x27, 0x39, 0x3d, 0x38, 0x32,
+	0x3c, 0x2e, 0x33, 0x34, 0x32, 0xff, 0xdb, 0x00, 0x43, 0x01, 0x09, 0x09,
+	0x09, 0x0c, 0x0b, 0x0c, 0x18, 0x0d, 0x0d, 0x18, 0x32, 0x21, 0x1c, 0x21,
+	0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+	0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+	0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+	0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+	0x32, 0x32, 0xff, 0xc0, 0x00, 0x11, 0x08, 0x00, 0x40, 0x00, 0x40, 0x03,
+	0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xff, 0xc4, 0x00,
+	0x16, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x06, 0x07, 0xff, 0xc4, 0x00,
+	0x17, 0x10, 0x00, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x04, 0x61, 0xff, 0xc4,
+	0x00, 0x17, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x03, 0x07, 0x00, 0xff,
+	0xc4, 0x00, 0x17, 0x11, 0x00, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x03, 0x04,
+	0xff, 0xda, 0x00, 0x0c, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00,
+	0x3f, 0x00, 0xc3, 0x57, 0x3e, 0x0b, 0x5c, 0xf8, 0x29, 0x73, 0xe0, 0xb5,
+	0xcf, 0x87, 0x26, 0x74, 0x2e, 0x19, 0x73, 0xe0, 0xb5, 0xcf, 0x82, 0x57,
+	0x3e, 0x0c, 0x5c, 0xf8, 0x55, 0x31, 0xa8, 0x5c, 0x32, 0xe7, 0xc1, 0x6b,
+	0x9f, 0x04, 0xae, 0x7c, 0x18, 0xb9, 0xf0, 0xa2, 0x63, 0x50, 0xb8, 0x55,
+	0xcf, 0x83, 0x17, 0x3e, 0x09, 0x5c, 0xf8, 0x2d, 0x73, 0xe1, 0x54, 0xc6,
+	0xb3, 0xdc, 0x84, 0x5c, 0xf8, 0x31, 0x73, 0xe0, 0x95, 0xcf, 0x82, 0xd7,
+	0x3e, 0x06, 0x26, 0x62, 0xf0, 0xb8, 0x65, 0xcf, 0x82, 0xd7, 0x3e, 0x0a,
+	0x5c, 0xf8, 0x2d, 0x73, 0xe1, 0x54, 0xc6, 0xa1, 0x70, 0xcb, 0x9f, 0x05,
+	0xae, 0x7c, 0x12, 0xb9, 0xf0, 0x62, 0xe7, 0xc2, 0xa9, 0x8d, 0x42, 0xe1,
+	0x97, 0x3e, 0x0b, 0x5c, 0xf8, 0x25, 0x73, 0xe0, 0xc5, 0xcf, 0x85, 0x13,
+	0x1a, 0x85, 0xc8, 0x35, 0xcf, 0x83, 0x17, 0x3e, 0x09, 0x5c, 0xf8, 0x2d,
+	0x73, 0xe0, 0x6a, 0x66, 0x2f, 0x0b, 0x86, 0x5c, 0xf8, 0x31, 0x73, 0xe0,
+	0x95, 0xcf, 0x82, 0xd7, 0x3e, 0x14, 0x4c, 0x6a, 0x17, 0x0c, 0xb9, 0xf0,
+	0x5a, 0xe7, 0xc1, 0x4b, 0x9f, 0x05, 0xae, 0x7c, 0x2a, 0x98, 0xd4, 0x2e,
+	0x19, 0x73, 0xe0, 0xb5, 0xcf, 0x82, 0x57, 0x3e, 0x0c, 0x5c, 0xf8, 0x55,
+	0x31, 0xa8, 0x5c, 0x84, 0x5c, 0xf8, 0x2d, 0x73, 0xe0, 0x95, 0xcf, 0x83,
+	0x17, 0x3e, 0x06, 0x26, 0x62, 0xf9, 0xee, 0x15, 0x73, 0xe0, 0xc5, 0xcf,
+	0x82, 0x57, 0x3e, 0x0b, 0x5c, 0xf8, 0x55, 0x31, 0xa8, 0x5c, 0x32, 0xe7,
+	0xc1, 0x8b, 0x9f, 0x04, 0xae, 0x7c, 0x16, 0xb9, 0xf0, 0xa2, 0x63, 0x50,
+	0xb8, 0x65, 0xcf, 0x82, 0xd7, 0x3e, 0x0a, 0x5c, 0xf8, 0x2d, 0x73, 0xe1,
+	0x54, 0xc6, 0xa1, 0x73, 0xff, 0xd9
+};
+
+class JPEGDecoderTestSuite : public CxxTest::TestSuite {
+	static Graphics::PixelFormat getRGBA() {
+		return Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0);
+	}
+
+public:
+	void test_load_jpeg() {
+#ifdef USE_JPEG
+		Image::JPEGDecoder decoder;
+		Common::MemoryReadStream stream(jpegGradient, sizeof(jpegGradient));
+		TS_ASSERT(decoder.loadStream(stream));
+
+		const Graphics::Surface *surface = decoder.getSurface();
+		TS_ASSERT_EQUALS(surface->w, 64);
+		TS_ASSERT_EQUALS(surface->h, 64);
+		TS_ASSERT_EQUALS(surface->format.bytesPerPixel, 3);
+#endif
+	}
+
+	void test_load_jpeg_scaled() {
+#ifdef USE_JPEG
+		for (uint denominator = 1; denominator <= 8; denominator *= 2) {
+			Image::JPEGDecoder decoder;
+			decoder.setOutputPixelFormat(getRGBA());
+			decoder.setScaleDenominator(denominator);
+
+			Common::MemoryReadStream stream(jpegGradient, sizeof(jpegGradient));
+			TS_ASSERT(decoder.loadStream(stream));
+
+			const Graphics::Surface *surface = decoder.getSurface();
+			TS_ASSERT_EQUALS(surface->w, (int)(64 / denominator));
+			TS_ASSERT_EQUALS(surface->h, (int)(64 / denominator));
+
+			// The gradient goes from dark at the top left to bright
+			// at the bottom right, whatever the scale
+			byte r0, g0, b0, r1, g1, b1;
+			surface->format.colorToRGB(surface->getPixel(0, 0), r0, g0, b0);
+			surface->format.colorToRGB(surface->getPixel(surface->w - 1, surface->h - 1), r1, g1, b1);
+			TS_ASSERT_LESS_THAN(r0, r1);
+			TS_ASSERT_LESS_THAN(g0, g1);
+			TS_ASSERT_LESS_THAN(b0, b1);
+		}
+#endif
+	}
+
+	void test_load_jpeg_batch() {
+#ifdef USE_JPEG
+		Image::JPEGDecoder decoder;
+		decoder.setOutputPixelFormat(getRGBA());
+
+		Common::MemoryReadStream reference(jpegGradient, sizeof(jpegGradient));
+		TS_ASSERT(decoder.loadStream(reference));
+		const Graphics::Surface *single = decoder.getSurface();
+
+		const uint count = 3;
+		Common::Array<Common::SeekableReadStream *> streams;
+		for (uint i = 0; i < count; i++)
+			streams.push_back(new Common::MemoryReadStream(jpegGradient, sizeof(jpegGradient)));
+
+		Common::Array<Graphics::Surface *> surfaces;
+		TS_ASSERT(decoder.loadStreams(streams, surfaces));
+		TS_ASSERT_EQUALS(surfaces.size(), count);
+
+		for (uint i = 0; i < surfaces.size(); i++) {
+			TS_ASSERT_EQUALS(surfaces[i]->w, single->w);
+			TS_ASSERT_EQUALS(surfaces[i]->h, single->h);
+			TS_ASSERT_SAME_DATA(surfaces[i]->getPixels(), single->getPixels(), single->pitch * single->h);
+
+			surfaces[i]->free();
+			delete surfaces[i];
+			delete streams[i];
+		}
+#endif
+	}
+
+	void test_jpeg_decode_speed() {
+#if defined(USE_JPEG) && BENCHMARK_TIME
+#ifdef SLOW_TESTS
+		const int iters = 20000;
+#else
+		const int iters = 200;
+#endif
+		// The throughput is measured in bytes of the full size image
+		const double imageSize = 64 * 64 * 4;
+
+		Common::install_null_g_system();
+
+		for (uint denominator = 1; denominator <= 8; denominator *= 2) {
+			Image::JPEGDecoder decoder;
+			decoder.setOutputPixelFormat(getRGBA());
+			decoder.setScaleDenominator(denominator);
+
+			uint32 start = g_system->getMillis();
+			for (int i = 0; i < iters; i++) {
+				Common::MemoryReadStream stream(jpegGradient, sizeof(jpegGradient));
+				decoder.loadStream(stream);
+			}
+			uint32 time = MAX<uint32>(g_system->getMillis() - start, 1);
+
+			debug("JPEG decode at 1/%d: %d images in %d ms, %.1f MB/s", denominator, iters, time,
+				iters * imageSize / (time * 1000.0));
+		}
+
+		Image::JPEGDecoder decoder;
+		decoder.setOutputPixelFormat(getRGBA());
+
+		Common::Array<Common::SeekableReadStream *> streams;
+		for (int i = 0; i < iters; i++)
+			streams.push_back(new Common::MemoryReadStream(jpegGradient, sizeof(jpegGradient)));
+
+		Common::Array<Graphics::Surface *> surfaces;
+		uint32 start = g_system->getMillis();
+		decoder.loadStreams(streams, surfaces);
+		uint32 time = MAX<uint32>(g_system->getMillis() - start, 1);
+
+		debug("JPEG batch decode: %d images in %d ms, %.1f MB/s", iters, time,
+			iters * imageSize / (time * 1000.0));
+
+		for (uint i = 0; i < surfaces.size(); i++) {
+			surfaces[i]->free();
+			delete surfaces[i];
+			delete streams[i];
+		}
+#endif
+	}
+};
@@ -0,0 +1,293 @@
+#include <cxxtest/TestSuite.h>
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/memstream.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "graphics/surface.h"
+#include "image/png.h"
+
+#include "../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+// A 32x32 color gradient, with an alpha gradient
+static const byte pngGradient[226] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
+	0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x20,
+	0x08, 0x06, 0x00, 0x00, 0x00, 0x73, 0x7a, 0x7a, 0xf4, 0x00, 0x00, 0x00,
+	0xa9, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0xc5, 0xce, 0x11, 0x17, 0x83,
+	0x60, 0x18, 0x80, 0xd1, 0xb7, 0x73, 0x82, 0x0f, 0x06, 0x41, 0x10, 0x04,
+	0xc1, 0x20, 0x08, 0x82, 0x20, 0x08, 0x82, 0x20, 0x18, 0x04, 0x41, 0x10,
+	0x04, 0x41, 0x30, 0x08, 0x06, 0xc1, 0x60, 0x18, 0x0e, 0x87, 0xc3, 0xe1,
+	0x70, 0x18, 0x86, 0xc3, 0x30, 0x0c, 0xc3, 0x60, 0xe7, 0xac, 0x9f, 0xf1,
+	0xc0, 0xf5, 0xab, 0x89, 0xc8, 0x5f, 0x89, 0xfe, 0xa3, 0x68, 0xa2, 0x74,
+	0x38, 0x60, 0x28, 0x38, 0x60, 0x1d, 0xe0, 0x80, 0x63, 0xc0, 0x01, 0xd7,
+	0x84, 0x03, 0xbe, 0x05, 0x07, 0x42, 0x1b, 0x0e, 0xc4, 0x0e, 0x1c, 0x48,
+	0x8f, 0x70, 0x20, 0x73, 0xe1, 0x40, 0xe1, 0xc1, 0x81, 0xca, 0x87, 0x03,
+	0x4d, 0x00, 0x07, 0xda, 0x10, 0x0e, 0x74, 0x11, 0x1c, 0xb8, 0xc5, 0x70,
+	0xa0, 0x4f, 0xe0, 0xc0, 0x3d, 0x85, 0x03, 0x8f, 0x13, 0x1c, 0x78, 0x66,
+	0x70, 0xe0, 0x95, 0xc3, 0x81, 0x77, 0x01, 0x07, 0x3e, 0x25, 0x1c, 0x18,
+	0x2a, 0x38, 0x30, 0xd6, 0x70, 0xe0, 0xdb, 0xc0, 0x81, 0xe9, 0x0c, 0x07,
+	0xe6, 0x16, 0x0e, 0x2c, 0x17, 0x38, 0xb0, 0x76, 0x70, 0x60, 0xbb, 0xa2,
+	0x81, 0x1d, 0xa3, 0xca, 0x36, 0x7d, 0x5d, 0xd2, 0x2f, 0xbf, 0x00, 0x00,
+	0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82
+};
+
+// A 16x16 paletted image, with the alpha of the first three colors set
+static const byte pngPaletted[194] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
+	0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10,
+	0x08, 0x03, 0x00, 0x00, 0x00, 0x28, 0x2d, 0x0f, 0x53, 0x00, 0x00, 0x00,
+	0x30, 0x50, 0x4c, 0x54, 0x45, 0x00, 0xff, 0x00, 0x10, 0xef, 0x08, 0x20,
+	0xdf, 0x10, 0x30, 0xcf, 0x18, 0x40, 0xbf, 0x20, 0x50, 0xaf, 0x28, 0x60,
+	0x9f, 0x30, 0x70, 0x8f, 0x38, 0x80, 0x7f, 0x40, 0x90, 0x6f, 0x48, 0xa0,
+	0x5f, 0x50, 0xb0, 0x4f, 0x58, 0xc0, 0x3f, 0x60, 0xd0, 0x2f, 0x68, 0xe0,
+	0x1f, 0x70, 0xf0, 0x0f, 0x78, 0xf4, 0x88, 0xa7, 0x31, 0x00, 0x00, 0x00,
+	0x03, 0x74, 0x52, 0x4e, 0x53, 0x00, 0x40, 0x80, 0xe7, 0xb7, 0x08, 0xfb,
+	0x00, 0x00, 0x00, 0x3e, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x65, 0x8f,
+	0x47, 0x12, 0xc0, 0x20, 0x0c, 0xc4, 0x44, 0x2f, 0x09, 0xf0, 0xff, 0xdf,
+	0x72, 0x17, 0x47, 0x8f, 0xed, 0x5d, 0x09, 0x42, 0x4c, 0xb9, 0xd4, 0xd6,
+	0xc7, 0xfc, 0xfe, 0xb5, 0xcf, 0x33, 0xe3, 0x3d, 0xbe, 0xc7, 0xff, 0x38,
+	0x0f, 0xe7, 0xe3, 0x3e, 0xdc, 0x8f, 0x79, 0x30, 0x1f, 0xe6, 0xc5, 0xfc,
+	0xd8, 0x07, 0xfb, 0x61, 0xdf, 0x0b, 0xfd, 0x3d, 0x07, 0x81, 0x1a, 0xbc,
+	0x64, 0xdd, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42,
+	0x60, 0x82
+};
+
+// A 13x11 interlaced 4-bit paletted image, with the same palette and
+// transparency as above. The color of pixel (x, y) is (x + 2 * y) % 16.
+static const byte pngInterlaced[212] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
+	0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x00, 0x00, 0x0b,
+	0x04, 0x03, 0x00, 0x00, 0x01, 0x21, 0x9b, 0x2a, 0xc4, 0x00, 0x00, 0x00,
+	0x30, 0x50, 0x4c, 0x54, 0x45, 0x00, 0xff, 0x00, 0x10, 0xef, 0x08, 0x20,
+	0xdf, 0x10, 0x30, 0xcf, 0x18, 0x40, 0xbf, 0x20, 0x50, 0xaf, 0x28, 0x60,
+	0x9f, 0x30, 0x70, 0x8f, 0x38, 0x80, 0x7f, 0x40, 0x90, 0x6f, 0x48, 0xa0,
+	0x5f, 0x50, 0xb0, 0x4f, 0x58, 0xc0, 0x3f, 0x60, 0xd0, 0x2f, 0x68, 0xe0,
+	0x1f, 0x70, 0xf0, 0x0f, 0x78, 0xf4, 0x88, 0xa7, 0x31, 0x00, 0x00, 0x00,
+	0x03, 0x74, 0x52, 0x4e, 0x53, 0x00, 0x40, 0x80, 0xe7, 0xb7, 0x08, 0xfb,
+	0x00, 0x00, 0x00, 0x50, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0xe0,
+	0x60, 0xe0, 0x60, 0xf0, 0x01, 0xc2, 0x1e, 0x16, 0x06, 0xb5, 0x05, 0x0c,
+	0xeb, 0x14, 0x40, 0xa4, 0x5b, 0xd7, 0x39, 0x06, 0x86, 0x73, 0x4c, 0x6e,
+	0x0d, 0x10, 0x96, 0x70, 0xf8, 0x6c, 0x86, 0xf0, 0xd9, 0xf7, 0x19, 0x66,
+	0xdf, 0x17, 0x66, 0xb8, 0x2f, 0x1c, 0x0e, 0xe7, 0x2b, 0xbb, 0xa6, 0x77,
+	0xae, 0x3e, 0xfb, 0x80, 0x01, 0x44, 0xbe, 0x67, 0x54, 0x60, 0x00, 0x91,
+	0xca, 0xae, 0x09, 0x0c, 0x20, 0x32, 0xbd, 0x73, 0x01, 0x4c, 0x1e, 0x00,
+	0x99, 0x13, 0x21, 0xd7, 0x3a, 0xf7, 0xd3, 0x8e, 0x00, 0x00, 0x00, 0x00,
+	0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82
+};
+
+/**
+ * Checks that decoding straight into a pixel format gives the same pixels
+ * as decoding and converting afterwards.
+ */
+class PNGDecoderTestSuite : public CxxTest::TestSuite {
+	void checkLoadInto(const byte *data, uint size, const Graphics::PixelFormat &format, bool keepPaletted = false) {
+		Image::PNGDecoder decoder;
+		Common::MemoryReadStream stream(data, size);
+		TS_ASSERT(decoder.loadStream(stream));
+		Graphics::Surface *reference = decoder.getSurface()->convertTo(format, decoder.getPalette(), decoder.getPaletteColorCount());
+
+		// Paletted images with transparency are then expanded with their
+		// own palette, instead of being decoded in true color by libpng
+		decoder.setKeepTransparencyPaletted(keepPaletted);
+
+		Graphics::Surface surface;
+		Common::MemoryReadStream streamInto(data, size);
+		TS_ASSERT(decoder.loadStreamInto(streamInto, surface, format));
+		TS_ASSERT(decoder.getSurface() == nullptr);
+
+		TS_ASSERT_EQUALS(surface.w, reference->w);
+		TS_ASSERT_EQUALS(surface.h, reference->h);
+		TS_ASSERT_EQUALS(surface.format, format);
+		TS_ASSERT_SAME_DATA(surface.getPixels(), reference->getPixels(), reference->pitch * reference->h);
+
+		surface.free();
+		reference->free();
+		delete reference;
+	}
+
+	static Graphics::PixelFormat getFormat(int index) {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(3, 8, 8, 8, 0, 16, 8, 0, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0)
+		};
+		return formats[index];
+	}
+
+public:
+	void test_load_png() {
+#ifdef USE_PNG
+		Image::PNGDecoder decoder;
+		Common::MemoryReadStream stream(pngGradient, sizeof(pngGradient));
+		TS_ASSERT(decoder.loadStream(stream));
+
+		const Graphics::Surface *surface = decoder.getSurface();
+		TS_ASSERT_EQUALS(surface->w, 32);
+		TS_ASSERT_EQUALS(surface->h, 32);
+
+		byte a, r, g, b;
+		surface->format.colorToARGB(surface->getPixel(3, 5), a, r, g, b);
+		TS_ASSERT_EQUALS(r, 3 * 8);
+		TS_ASSERT_EQUALS(g, 5 * 8);
+		TS_ASSERT_EQUALS(b, (3 + 5) * 4);
+		TS_ASSERT_EQUALS(a, 255 - 3 * 4);
+#endif
+	}
+
+	void test_load_png_into() {
+#ifdef USE_PNG
+		for (int i = 0; i < 7; i++)
+			checkLoadInto(pngGradient, sizeof(pngGradient), getFormat(i));
+#endif
+	}
+
+	void test_load_png_into_paletted() {
+#ifdef USE_PNG
+		for (int i = 0; i < 7; i++) {
+			checkLoadInto(pngPaletted, sizeof(pngPaletted), getFormat(i));
+			checkLoadInto(pngPaletted, sizeof(pngPaletted), getFormat(i), true);
+		}
+
+		// Paletted images stay paletted when asked to
+		Image::PNGDecoder decoder;
+		decoder.setKeepTransparencyPaletted(true);
+
+		Graphics::Surface surface;
+		Common::MemoryReadStream stream(pngPaletted, sizeof(pngPaletted));
+		TS_ASSERT(decoder.loadStreamInto(stream, surface, Graphics::PixelFormat::createFormatCLUT8()));
+		TS_ASSERT_EQUALS(surface.format.bytesPerPixel, 1);
+		TS_ASSERT_EQUALS(decoder.getPaletteColorCount(), 16);
+		TS_ASSERT_EQUALS(*(const byte *)surface.getBasePtr(3, 5), 8);
+		surface.free();
+#endif
+	}
+
+	void test_load_png_into_interlaced() {
+#ifdef USE_PNG
+		for (int i = 0; i < 7; i++) {
+			checkLoadInto(pngInterlaced, sizeof(pngInterlaced), getFormat(i));
+			checkLoadInto(pngInterlaced, sizeof(pngInterlaced), getFormat(i), true);
+		}
+
+		Image::PNGDecoder decoder;
+		decoder.setKeepTransparencyPaletted(true);
+
+		Graphics::Surface surface;
+		Common::MemoryReadStream stream(pngInterlaced, sizeof(pngInterlaced));
+		TS_ASSERT(decoder.loadStreamInto(stream, surface, getFormat(4)));
+		TS_ASSERT_EQUALS(surface.w, 13);
+		TS_ASSERT_EQUALS(surface.h, 11);
+
+		byte a, r, g, b;
+		surface.format.colorToARGB(surface.getPixel(3, 5), a, r, g, b);
+		TS_ASSERT_EQUALS(r, 13 * 16);
+		TS_ASSERT_EQUALS(g, 255 - 13 * 16);
+		TS_ASSERT_EQUALS(b, 13 * 8);
+		TS_ASSERT_EQUALS(a, 255);
+		surface.format.colorToARGB(surface.getPixel(1, 0), a, r, g, b);
+		TS_ASSERT_EQUALS(a, 0x40);
+		surface.free();
+
+		Common::MemoryReadStream streamPaletted(pngInterlaced, sizeof(pngInterlaced));
+		TS_ASSERT(decoder.loadStreamInto(streamPaletted, surface, Graphics::PixelFormat::createFormatCLUT8()));
+		TS_ASSERT_EQUALS(decoder.getPaletteColorCount(), 16);
+		TS_ASSERT_EQUALS(*(const byte *)surface.getBasePtr(3, 5), 13);
+		TS_ASSERT_EQUALS(*(const byte *)surface.getBasePtr(12, 10), 0);
+		surface.free();
+#endif
+	}
+
+	void test_load_png_batch() {
+#ifdef USE_PNG
+		const Graphics::PixelFormat format = getFormat(4);
+
+		Common::Array<Common::SeekableReadStream *> streams;
+		streams.push_back(new Common::MemoryReadStream(pngGradient, sizeof(pngGradient)));
+		streams.push_back(new Common::MemoryReadStream(pngPaletted, sizeof(pngPaletted)));
+
+		Image::PNGDecoder decoder;
+		Common::Array<Graphics::Surface *> surfaces;
+		TS_ASSERT(decoder.loadStreams(streams, surfaces, format));
+		TS_ASSERT_EQUALS(surfaces.size(), 2u);
+
+		TS_ASSERT_EQUALS(surfaces[0]->w, 32);
+		TS_ASSERT_EQUALS(surfaces[1]->w, 16);
+
+		for (uint i = 0; i < surfaces.size(); i++) {
+			TS_ASSERT_EQUALS(surfaces[i]->format, format);
+			surfaces[i]->free();
+			delete surfaces[i];
+			delete streams[i];
+		}
+#endif
+	}
+
+	void test_png_decode_speed() {
+#if defined(USE_PNG) && BENCHMARK_TIME
+#ifdef SLOW_TESTS
+		const int iters = 50000;
+#else
+		const int iters = 500;
+#endif
+		const double imageSize = 32 * 32 * 4;
+
+		Common::install_null_g_system();
+
+		// The peak sizes are estimates of the memory used by the surfaces
+		// and row buffers of each approach, not measured allocations
+
+		for (int f = 0; f < 2; f++) {
+			// The first format is converted row by row, the second is
+			// output by libpng directly
+			const Graphics::PixelFormat format = getFormat(f == 0 ? 0 : 4);
+			Image::PNGDecoder decoder;
+			uint32 peakConvert = 0, peakInto = 0;
+
+			uint32 start = g_system->getMillis();
+			for (int i = 0; i < iters; i++) {
+				Common::MemoryReadStream stream(pngGradient, sizeof(pngGradient));
+				decoder.loadStream(stream);
+
+				const Graphics::Surface *decoded = decoder.getSurface();
+				Graphics::Surface *converted = decoded->convertTo(format);
+				peakConvert = decoded->pitch * decoded->h + converted->pitch * converted->h;
+				converted->free();
+				delete converted;
+			}
+			uint32 timeConvert = MAX<uint32>(g_system->getMillis() - start, 1);
+
+			start = g_system->getMillis();
+			for (int i = 0; i < iters; i++) {
+				Common::MemoryReadStream stream(pngGradient, sizeof(pngGradient));
+				Graphics::Surface surface;
+				decoder.loadStreamInto(stream, surface, format);
+
+				// The converted rows go through a single row buffer
+				peakInto = surface.pitch * surface.h + (f == 0 ? surface.w * 4 : 0);
+				surface.free();
+			}
+			uint32 timeInto = MAX<uint32>(g_system->getMillis() - start, 1);
+
+			debug("PNG decode to %d bpp then convert: %d images in %d ms, %.1f MB/s, estimated peak %d bytes", format.bytesPerPixel * 8,
+				iters, timeConvert, iters * imageSize / (timeConvert * 1000.0), peakConvert);
+			debug("PNG decode into %d bpp: %d images in %d ms, %.1f MB/s, estimated peak %d bytes", format.bytesPerPixel * 8,
+				iters, timeInto, iters * imageSize / (timeInto * 1000.0), peakInto);
+		}
+#endif
+	}
+};
@@ -0,0 +1,182 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+#include "../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+/**
+ * Checks that the vectorized YUV to RGB converters produce exactly the same
+ * pixels as the lookup table converters.
+ */
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+	enum Converter {
+		kConvert444,
+		kConvert422,
+		kConvert420,
+		kConvert420Alpha,
+		kConvert410
+	};
+
+	byte *_y, *_u, *_v, *_a;
+
+	void fillPlanes(int width, int height) {
+		_y = new byte[width * height];
+		_u = new byte[width * height];
+		_v = new byte[width * height];
+		_a = new byte[width * height];
+
+		uint32 seed = 0x1234567;
+		for (int i = 0; i < width * height; i++) {
+			seed = seed * 1103515245 + 12345;
+			_y[i] = (byte)(seed >> 8);
+			_u[i] = (byte)(seed >> 16);
+			_v[i] = (byte)(seed >> 24);
+			_a[i] = (byte)(seed >> 4);
+		}
+
+		// Make sure the extremes are covered as well
+		_y[0] = _u[0] = _v[0] = 0;
+		_y[1] = _u[1] = _v[1] = 255;
+		_y[2] = 255;
+		_u[2] = _v[2] = 0;
+	}
+
+	void freePlanes() {
+		delete[] _y;
+		delete[] _u;
+		delete[] _v;
+		delete[] _a;
+	}
+
+	void convert(Graphics::Surface *dst, Converter converter, Graphics::YUVToRGBManager::LuminanceScale scale, int width, int height) {
+		switch (converter) {
+		case kConvert444:
+			YUVToRGBMan.convert444(dst, scale, _y, _u, _v, width, height, width, width);
+			break;
+		case kConvert422:
+			YUVToRGBMan.convert422(dst, scale, _y, _u, _v, width, height, width, width / 2);
+			break;
+		case kConvert420:
+			YUVToRGBMan.convert420(dst, scale, _y, _u, _v, width, height, width, width / 2);
+			break;
+		case kConvert420Alpha:
+			YUVToRGBMan.convert420Alpha(dst, scale, _y, _u, _v, _a, width, height, width, width / 2);
+			break;
+		case kConvert410:
+			// The chroma planes need an extra column and row
+			YUVToRGBMan.convert410(dst, scale, _y, _u, _v, width, height, width, width / 4 + 1);
+			break;
+		default:
+			break;
+		}
+	}
+
+public:
+	void test_yuv_to_rgb_simd() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() < 2)
+			return;
+
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0)
+		};
+		// Not a multiple of the vector width
+		const int width = 44;
+		const int height = 8;
+
+		Common::install_null_g_system();
+		fillPlanes(width, height);
+
+		for (int f = 0; f < ARRAYSIZE(formats); f++) {
+			for (int scale = Graphics::YUVToRGBManager::kScaleFull; scale <= Graphics::YUVToRGBManager::kScaleITU; scale++) {
+				for (int converter = kConvert444; converter <= kConvert410; converter++) {
+					Graphics::Surface reference, simd;
+					reference.create(width, height, formats[f]);
+					simd.create(width, height, formats[f]);
+
+					YUVToRGBMan.setSIMDEnabled(false);
+					convert(&reference, (Converter)converter, (Graphics::YUVToRGBManager::LuminanceScale)scale, width, height);
+					YUVToRGBMan.setSIMDEnabled(true);
+					convert(&simd, (Converter)converter, (Graphics::YUVToRGBManager::LuminanceScale)scale, width, height);
+
+					TS_ASSERT_SAME_DATA(reference.getPixels(), simd.getPixels(), reference.pitch * height);
+
+					reference.free();
+					simd.free();
+				}
+			}
+		}
+
+		freePlanes();
+#endif
+	}
+
+	void test_yuv_to_rgb_speed() {
+#if BENCHMARK_TIME
+		// A full screen frame of a typical video, in the screen formats
+		// games use most
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0)
+		};
+		// 444 and 422 are used by Theora, 420 by Bink, Theora, MPEG, PSX
+		// and Xan, 420 with alpha by Bink, and 410 by Indeo and SVQ1
+		const char *converterNames[] = { "convert444", "convert422", "convert420", "convert420Alpha", "convert410" };
+		const int width = 640;
+		const int height = 480;
+#ifdef SLOW_TESTS
+		const int iters = 500;
+#else
+		const int iters = 5;
+#endif
+
+		Common::install_null_g_system();
+		fillPlanes(width, height);
+
+		for (int f = 0; f < ARRAYSIZE(formats); f++) {
+			Graphics::Surface dst;
+			dst.create(width, height, formats[f]);
+
+			for (int converter = kConvert444; converter <= kConvert410; converter++) {
+				for (int simd = 0; simd <= 1; simd++) {
+#ifdef SCUMMVM_SSE2
+					if (simd && instrset_detect() < 2)
+						break;
+#else
+					if (simd)
+						break;
+#endif
+					YUVToRGBMan.setSIMDEnabled(simd);
+
+					uint32 start = g_system->getMillis();
+					for (int i = 0; i < iters; i++)
+						convert(&dst, (Converter)converter, Graphics::YUVToRGBManager::kScaleITU, width, height);
+					uint32 time = MAX<uint32>(g_system->getMillis() - start, 1);
+
+					debug("%s to %d bpp (%s): %d frames in %d ms, %.1f frames/s", converterNames[converter], formats[f].bytesPerPixel * 8,
+						simd ? "SIMD" : "lookup tables", iters, time, iters * 1000.0 / time);
+				}
+			}
+
+			dst.free();
+		}
+
+		freePlanes();
+#endif
+	}
+};
@@ -35,6 +35,13 @@ ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TEST_LIBS += engines/wintermute/libwintermute.a
 endif
 
+ifeq ($(ENABLE_SCUMM), STATIC_PLUGIN)
+ifdef ENABLE_SCUMM_7_8
+	TESTS += $(srcdir)/test/engines/scumm/*.h
+	TEST_LIBS += engines/scumm/libscumm.a
+endif
+endif
+
 ifeq ($(ENABLE_ULTIMA), STATIC_PLUGIN)
 ifdef ENABLE_ULTIMA1
 	TESTS += $(srcdir)/test/engines/ultima/shared/*/*.h
@@ -27,9 +27,30 @@
 #include "common/rational.h"
 #include "common/file.h"
 #include "common/system.h"
+#include "common/timer.h"
+
+#include "graphics/surface.h"
 
 namespace Video {
 
+struct VideoDecoder::DecodedFrame {
+	DecodedFrame() : hasSurface(false), dirtyPalette(false), startTime(0), curFrame(-1), nextFrameStartTime(0), endOfTrack(false) {}
+	~DecodedFrame() { surface.free(); }
+
+	Graphics::Surface surface;
+	bool hasSurface;
+	bool dirtyPalette;
+	byte palette[256 * 3];
+
+	// The state of the video track before and after decoding the frame
+	uint32 startTime;
+	int curFrame;
+	uint32 nextFrameStartTime;
+	bool endOfTrack;
+};
+
+VideoDecoder *VideoDecoder::_decodeAheadOwner = 0;
+
 VideoDecoder::VideoDecoder() {
 	_startTime = 0;
 	_dirtyPalette = false;
@@ -47,9 +68,21 @@ VideoDecoder::VideoDecoder() {
 	_mainAudioTrack = 0;
 	_canSetDither = true;
 	_canSetDefaultFormat = true;
+	_decodeAheadFrames = 0;
+	_decodeAheadTrack = 0;
+	_seeking = false;
+	_shownFrame = 0;
+}
+
+VideoDecoder::~VideoDecoder() {
+	resetDecodeAhead();
+	freeDecodedFrames();
 }
 
 void VideoDecoder::close() {
+	// The timer proc must not access the tracks anymore
+	resetDecodeAhead();
+
 	if (isPlaying())
 		stop();
 
@@ -73,6 +106,7 @@ void VideoDecoder::close() {
 	_mainAudioTrack = 0;
 	_canSetDither = true;
 	_canSetDefaultFormat = true;
+	freeDecodedFrames();
 }
 
 bool VideoDecoder::loadFile(const Common::Path &filename) {
@@ -204,6 +238,15 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	_canSetDither = false;
 	_canSetDefaultFormat = false;
 
+	if (_decodeAheadTrack) {
+		if (_decodeAheadOwner == this || getDecodedFrameCount() > 0)
+			return showDecodedFrame();
+
+		// Decoding ahead was stopped, and all the frames decoded ahead
+		// have been shown
+		_decodeAheadTrack = 0;
+	}
+
 	readNextPacket();
 
 	// If we have no next video track at this point, there shouldn't be
@@ -221,6 +264,10 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	// Look for the next video track here for the next decode.
 	findNextVideoTrack();
 
+	// Only start decoding ahead now, as the output format can't change anymore
+	if (_decodeAheadFrames && frame && !_decodeAheadOwner && !_seeking && isPlaying() && startDecodeAhead(frame))
+		return &_shownFrame->surface;
+
 	return frame;
 }
 
@@ -229,6 +276,19 @@ bool VideoDecoder::setReverse(bool reverse) {
 	if (reverse && hasAudio())
 		return false;
 
+	// The video track is ahead of playback while decoding ahead, so move it
+	// back to the frame shown before reversing it
+	if (reverse && _decodeAheadTrack) {
+		if (!isSeekable())
+			return false;
+
+		int frame = getShownCurFrame(_decodeAheadTrack);
+		resetDecodeAhead();
+
+		if (!seekToFrame(frame + 1))
+			return false;
+	}
+
 	// Attempt to make sure all the tracks are in the requested direction
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)*it)->isReversed() != reverse) {
@@ -253,7 +313,7 @@ int VideoDecoder::getCurFrame() const {
 
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo)
-			frame += ((VideoTrack *)*it)->getCurFrame() + 1;
+			frame += getShownCurFrame((const VideoTrack *)*it) + 1;
 
 	return frame;
 }
@@ -294,7 +354,7 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 		return 0;
 
 	uint32 currentTime = getTime();
-	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+	uint32 nextFrameStartTime = getShownNextFrameStartTime(_nextVideoTrack);
 
 	if (_nextVideoTrack->isReversed()) {
 		// For reversed videos, we need to handle the time difference the opposite way.
@@ -315,8 +375,8 @@ bool VideoDecoder::endOfVideo() const {
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		const Track *track = *it;
 
-		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && ((const VideoTrack *)track)->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && getShownNextFrameStartTime((const VideoTrack *)track) >= (uint)_endTime.msecs();
+		bool endReached = isTrackEnded(track) || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return false;
 	}
@@ -339,6 +399,8 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	resetDecodeAhead();
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -373,12 +435,19 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (!isSeekable())
 		return false;
 
+	resetDecodeAhead();
+
 	// Stop all tracks so they can be seek'ed
 	if (isPlaying())
 		stopAudio();
 
-	// Do the actual seeking
-	if (!seekIntern(time))
+	// Do the actual seeking, without decoding ahead from the frames it
+	// may decode on the way
+	_seeking = true;
+	bool result = seekIntern(time);
+	_seeking = false;
+
+	if (!result)
 		return false;
 
 	// Seek any external track too
@@ -925,7 +994,7 @@ void VideoDecoder::setEndFrame(uint frame) {
 
 void VideoDecoder::resetStartTime() {
 	if (_nextVideoTrack) {
-		Audio::Timestamp curTime = _nextVideoTrack->getFrameTime(_nextVideoTrack->getCurFrame());
+		Audio::Timestamp curTime = _nextVideoTrack->getFrameTime(getShownCurFrame(_nextVideoTrack));
 		if (isPlaying()) {
 			_startTime = g_system->getMillis() - (curTime.msecs() / _playbackRate).toInt();
 		}
@@ -948,7 +1017,7 @@ const VideoDecoder::Track *VideoDecoder::getTrack(uint track) const {
 
 bool VideoDecoder::endOfVideoTracks() const {
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
-		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !(*it)->endOfTrack())
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !isTrackEnded(*it))
 			return false;
 
 	return true;
@@ -959,9 +1028,9 @@ VideoDecoder::VideoTrack *VideoDecoder::findNextVideoTrack() {
 	uint32 bestTime = 0xFFFFFFFF;
 
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
-		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !(*it)->endOfTrack()) {
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !isTrackEnded(*it)) {
 			VideoTrack *track = (VideoTrack *)*it;
-			uint32 time = track->getNextFrameStartTime();
+			uint32 time = getShownNextFrameStartTime(track);
 
 			if (time < bestTime) {
 				bestTime = time;
@@ -1015,8 +1084,8 @@ bool VideoDecoder::hasFramesLeft() const {
 
 		const VideoTrack *track = (const VideoTrack *)*it;
 
-		bool videoEndTimeReached = _endTimeSet && track->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool videoEndTimeReached = _endTimeSet && getShownNextFrameStartTime(track) >= (uint)_endTime.msecs();
+		bool endReached = isTrackEnded(track) || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return true;
 	}
@@ -1032,7 +1101,247 @@ bool VideoDecoder::hasAudio() const {
 	return false;
 }
 
+void VideoDecoder::setDecodeAhead(uint frames) {
+	if (!supportsDecodeAhead())
+		return;
+
+	_decodeAheadFrames = frames;
+
+	// The frames already decoded ahead are still shown
+	if (!frames)
+		stopDecodeAhead();
+}
+
+static void copyDecodedFrame(Graphics::Surface &dst, const Graphics::Surface &src) {
+	if (dst.w != src.w || dst.h != src.h || dst.format != src.format) {
+		dst.free();
+		dst.create(src.w, src.h, src.format);
+	}
+
+	dst.copyRectToSurface(src, 0, 0, Common::Rect(src.w, src.h));
+}
+
+bool VideoDecoder::startDecodeAhead(const Graphics::Surface *frame) {
+	VideoTrack *track = 0;
+
+	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo) {
+			// Only a single video track can be decoded ahead
+			if (track)
+				return false;
+
+			track = (VideoTrack *)*it;
+		}
+	}
+
+	if (!track || track->isReversed() || track->endOfTrack())
+		return false;
+
+	// The timer thread is going to overwrite the track's frame and palette,
+	// so the current ones are shown from a copy
+	if (!_shownFrame)
+		_shownFrame = new DecodedFrame();
+
+	copyDecodedFrame(_shownFrame->surface, *frame);
+	_shownFrame->hasSurface = true;
+	_shownFrame->curFrame = track->getCurFrame();
+	_shownFrame->nextFrameStartTime = track->getNextFrameStartTime();
+	_shownFrame->endOfTrack = false;
+
+	if (_palette && _palette != _shownPalette) {
+		memcpy(_shownPalette, _palette, sizeof(_shownPalette));
+		_palette = _shownPalette;
+	}
+
+	_decodeAheadTrack = track;
+	_decodeAheadOwner = this;
+
+	// Frames are decoded one at a time, so check often enough for
+	// high frame rate videos too
+	if (!g_system->getTimerManager()->installTimerProc(&decodeAheadProc, 10000, this, "VideoDecoder")) {
+		_decodeAheadTrack = 0;
+		_decodeAheadOwner = 0;
+		return false;
+	}
+
+	return true;
+}
+
+void VideoDecoder::stopDecodeAhead() {
+	if (_decodeAheadOwner != this)
+		return;
+
+	// This waits for the timer proc to return, if it is currently running
+	g_system->getTimerManager()->removeTimerProc(&decodeAheadProc);
+	_decodeAheadOwner = 0;
+}
+
+void VideoDecoder::resetDecodeAhead() {
+	stopDecodeAhead();
+
+	Common::StackLock lock(_decodedFramesMutex);
+
+	while (!_decodedFrames.empty()) {
+		_freeFrames.push_back(_decodedFrames.front());
+		_decodedFrames.pop_front();
+	}
+
+	// The video track is in sync with what is shown again
+	_decodeAheadTrack = 0;
+}
+
+void VideoDecoder::freeDecodedFrames() {
+	for (DecodedFrameList::iterator it = _freeFrames.begin(); it != _freeFrames.end(); it++)
+		delete *it;
+
+	_freeFrames.clear();
+
+	delete _shownFrame;
+	_shownFrame = 0;
+}
+
+void VideoDecoder::decodeAheadProc(void *refCon) {
+	VideoDecoder *decoder = (VideoDecoder *)refCon;
+
+	if (decoder->getDecodedFrameCount() >= decoder->_decodeAheadFrames)
+		return;
+
+	// Only decode a single frame per call. This still delays the other timer
+	// procs (music players in particular) by one frame's worth of decoding,
+	// see supportsDecodeAhead().
+	Common::StackLock lock(decoder->_decodeMutex);
+	decoder->decodeAheadFrame();
+}
+
+bool VideoDecoder::decodeAheadFrame() {
+	VideoTrack *track = _decodeAheadTrack;
+
+	if (track->endOfTrack())
+		return false;
+
+	DecodedFrame *frame = 0;
+
+	{
+		Common::StackLock lock(_decodedFramesMutex);
+
+		if (!_freeFrames.empty()) {
+			frame = _freeFrames.front();
+			_freeFrames.pop_front();
+		}
+	}
+
+	if (!frame)
+		frame = new DecodedFrame();
+
+	frame->startTime = track->getNextFrameStartTime();
+
+	readNextPacket();
+	const Graphics::Surface *surface = track->decodeNextFrame();
+
+	frame->hasSurface = surface != 0;
+	if (surface)
+		copyDecodedFrame(frame->surface, *surface);
+
+	frame->dirtyPalette = track->hasDirtyPalette();
+	if (frame->dirtyPalette)
+		memcpy(frame->palette, track->getPalette(), sizeof(frame->palette));
+
+	frame->curFrame = track->getCurFrame();
+	frame->nextFrameStartTime = track->getNextFrameStartTime();
+	frame->endOfTrack = track->endOfTrack();
+
+	Common::StackLock lock(_decodedFramesMutex);
+	_decodedFrames.push_back(frame);
+	return true;
+}
+
+const Graphics::Surface *VideoDecoder::showDecodedFrame() {
+	// Decode the frame here if the timer thread has fallen behind
+	if (getDecodedFrameCount() == 0) {
+		Common::StackLock lock(_decodeMutex);
+
+		if (getDecodedFrameCount() == 0 && !decodeAheadFrame())
+			return 0;
+	}
+
+	uint32 time = getTime();
+
+	Common::StackLock lock(_decodedFramesMutex);
+
+	// Skip the frames which are already late, but keep their palette changes.
+	// A frame without a surface keeps the previous one on screen, so the
+	// frame before it is never skipped.
+	while (isPlaying() && _decodedFrames.size() > 1) {
+		DecodedFrameList::iterator next = _decodedFrames.begin();
+		next++;
+
+		if ((*next)->startTime > time || !(*next)->hasSurface)
+			break;
+
+		showPalette(_decodedFrames.front());
+		_freeFrames.push_back(_decodedFrames.front());
+		_decodedFrames.pop_front();
+	}
+
+	DecodedFrame *frame = _decodedFrames.front();
+	_decodedFrames.pop_front();
+	showPalette(frame);
+
+	if (frame->hasSurface) {
+		_freeFrames.push_back(_shownFrame);
+		_shownFrame = frame;
+	} else {
+		// The caller keeps the previous surface on screen
+		_shownFrame->curFrame = frame->curFrame;
+		_shownFrame->nextFrameStartTime = frame->nextFrameStartTime;
+		_shownFrame->endOfTrack = frame->endOfTrack;
+		_freeFrames.push_back(frame);
+	}
+
+	findNextVideoTrack();
+
+	return frame->hasSurface ? &frame->surface : 0;
+}
+
+void VideoDecoder::showPalette(const DecodedFrame *frame) {
+	if (!frame->dirtyPalette)
+		return;
+
+	memcpy(_shownPalette, frame->palette, sizeof(_shownPalette));
+	_palette = _shownPalette;
+	_dirtyPalette = true;
+}
+
+uint VideoDecoder::getDecodedFrameCount() {
+	Common::StackLock lock(_decodedFramesMutex);
+	return _decodedFrames.size();
+}
+
+int VideoDecoder::getShownCurFrame(const VideoTrack *track) const {
+	if (track == _decodeAheadTrack)
+		return _shownFrame->curFrame;
+
+	return track->getCurFrame();
+}
+
+uint32 VideoDecoder::getShownNextFrameStartTime(const VideoTrack *track) const {
+	if (track == _decodeAheadTrack)
+		return _shownFrame->nextFrameStartTime;
+
+	return track->getNextFrameStartTime();
+}
+
+bool VideoDecoder::isTrackEnded(const Track *track) const {
+	if (track == _decodeAheadTrack)
+		return _shownFrame->endOfTrack;
+
+	return track->endOfTrack();
+}
+
 void VideoDecoder::eraseTrack(Track *track) {
+	if (track == _decodeAheadTrack)
+		resetDecodeAhead();
+
 	for (uint idx = 0; idx < _externalTracks.size(); ++idx) {
 		if (_externalTracks[idx] == track)
 			_externalTracks.remove_at(idx);
@@ -25,6 +25,8 @@
 #include "audio/mixer.h"
 #include "audio/timestamp.h"	// TODO: Move this to common/ ?
 #include "common/array.h"
+#include "common/list.h"
+#include "common/mutex.h"
 #include "common/path.h"
 #include "common/rational.h"
 #include "common/str.h"
@@ -52,7 +54,7 @@ namespace Video {
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+	virtual ~VideoDecoder();
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -400,6 +402,28 @@ public:
 	 */
 	bool setOutputPixelFormat(const Graphics::PixelFormat &format);
 
+	/**
+	 * Decode up to the given number of frames ahead of playback.
+	 *
+	 * The frames are decoded on the timer thread into a queue, from which
+	 * decodeNextFrame() then returns them. A frame is only decoded by
+	 * decodeNextFrame() itself when playback has caught up with the queue,
+	 * and queued frames which are already late are skipped.
+	 *
+	 * Decoding ahead starts once the first frame has been decoded while the
+	 * video is playing. It only applies to videos with a single video track
+	 * playing forward, and only one video at a time decodes ahead. Reversing
+	 * the playback moves the track back to the frame shown and decodes
+	 * synchronously from there.
+	 *
+	 * This is ignored by decoders which don't support it, see
+	 * supportsDecodeAhead().
+	 *
+	 * @param frames The number of frames to decode ahead, or 0 to decode
+	 *               synchronously (the default)
+	 */
+	void setDecodeAhead(uint frames);
+
 	/////////////////////////////////////////
 	// Audio Control
 	/////////////////////////////////////////
@@ -963,6 +987,34 @@ protected:
 	 */
 	virtual AudioTrack *getAudioTrack(int index) { return 0; }
 
+	/**
+	 * Whether setDecodeAhead() may be used with this decoder.
+	 *
+	 * The timer proc decodes a frame at a time on the timer thread, which is
+	 * shared with the music players and other engine timers. A decoder may
+	 * only return true if decoding a frame is cheap enough to run there, and
+	 * if readNextPacket() and its video track's decodeNextFrame() only touch
+	 * the decoder's own stream, its tracks and its audio streams, and never
+	 * the playback state (getTime(), endOfVideoTracks(), ...) or data shared
+	 * with the game thread.
+	 *
+	 * This rules out QuickTime, which buffers audio from the video stream
+	 * in decodeNextFrame() rather than in readNextPacket(), and MPEG-PS,
+	 * which demuxes packets based on getTime(). The other decoders haven't
+	 * been checked yet, so only Bink opts in.
+	 */
+	virtual bool supportsDecodeAhead() const { return false; }
+
+	/**
+	 * Serializes decoding between the game thread and the timer thread
+	 * while decoding ahead.
+	 *
+	 * readNextPacket() and the video track's decodeNextFrame() are always
+	 * called with it locked. A subclass accessing the data they use from
+	 * anywhere else needs to lock it as well.
+	 */
+	Common::Mutex _decodeMutex;
+
 private:
 	// Tracks owned by this VideoDecoder
 	TrackList _tracks;
@@ -1005,6 +1057,36 @@ private:
 	Audio::Mixer::SoundType _soundType;
 
 	AudioTrack *_mainAudioTrack;
+
+	// Decoding ahead
+	struct DecodedFrame;
+	typedef Common::List<DecodedFrame *> DecodedFrameList;
+
+	bool startDecodeAhead(const Graphics::Surface *frame);
+	void stopDecodeAhead();
+	void resetDecodeAhead();
+	void freeDecodedFrames();
+	bool decodeAheadFrame();
+	const Graphics::Surface *showDecodedFrame();
+	void showPalette(const DecodedFrame *frame);
+	uint getDecodedFrameCount();
+	static void decodeAheadProc(void *refCon);
+
+	// The state of a video track as shown, which is behind the track itself
+	// while it is decoded ahead
+	int getShownCurFrame(const VideoTrack *track) const;
+	uint32 getShownNextFrameStartTime(const VideoTrack *track) const;
+	bool isTrackEnded(const Track *track) const;
+
+	static VideoDecoder *_decodeAheadOwner; ///< The decoder the timer proc is installed for
+	uint _decodeAheadFrames;
+	VideoTrack *_decodeAheadTrack; ///< The track being decoded ahead, if any
+	bool _seeking;
+	Common::Mutex _decodedFramesMutex; ///< Guards the frame lists
+	DecodedFrameList _decodedFrames; ///< Frames waiting to be shown, oldest first
+	DecodedFrameList _freeFrames;
+	DecodedFrame *_shownFrame;
+	byte _shownPalette[256 * 3];
 };
 
 } // End of namespace Video